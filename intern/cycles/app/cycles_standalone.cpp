@@ -7,6 +7,7 @@
 #include "scene/camera.h"
 #include "scene/integrator.h"
 #include "scene/scene.h"
+#include "scene/stats.h"
 #include "session/buffers.h"
 #include "session/session.h"
 
@@ -48,6 +49,10 @@ struct Options {
   bool show_help, interactive, pause;
   string output_filepath;
   string output_pass;
+  int frame_start, frame_end;
+  string frame_delta_filepath;
+  string profile_json_filepath;
+  double frame_read_time, frame_render_start_time;
 } options;
 
 static void session_print(const string &str)
@@ -83,6 +88,28 @@ static void session_print_status()
   session_print(status);
 }
 
+/* Replace the last sequence of # characters in the file path with the zero padded frame number. */
+static string path_frame(const string &filepath, const int frame)
+{
+  const size_t end = filepath.find_last_of('#');
+  if (end == string::npos) {
+    return filepath;
+  }
+
+  size_t start = end;
+  while (start > 0 && filepath[start - 1] == '#') {
+    start--;
+  }
+
+  return filepath.substr(0, start) + string_printf("%0*d", (int)(end - start + 1), frame) +
+         filepath.substr(end + 1);
+}
+
+static bool render_multiple_frames()
+{
+  return options.frame_end > options.frame_start;
+}
+
 static BufferParams &session_buffer_params()
 {
   static BufferParams buffer_params;
@@ -109,6 +136,11 @@ static void scene_init()
     xml_read_file(options.scene, options.filepath.c_str());
   }
 
+  if (!options.frame_delta_filepath.empty()) {
+    const string delta_filepath = path_frame(options.frame_delta_filepath, options.frame_start);
+    xml_read_file(options.scene, delta_filepath.c_str());
+  }
+
   /* Camera width/height override? */
   if (!(options.width == 0 || options.height == 0)) {
     options.scene->camera->set_full_width(options.width);
@@ -123,6 +155,14 @@ static void scene_init()
   options.scene->camera->compute_auto_viewplane();
 }
 
+static void session_set_output_driver(const int frame)
+{
+  if (!options.output_filepath.empty()) {
+    options.session->set_output_driver(make_unique<OIIOOutputDriver>(
+        path_frame(options.output_filepath, frame), options.output_pass, session_print));
+  }
+}
+
 static void session_init()
 {
   options.output_pass = "combined";
@@ -135,10 +175,7 @@ static void session_init()
   }
 #endif
 
-  if (!options.output_filepath.empty()) {
-    options.session->set_output_driver(make_unique<OIIOOutputDriver>(
-        options.output_filepath, options.output_pass, session_print));
-  }
+  session_set_output_driver(options.frame_start);
 
   if (options.session_params.background && !options.quiet)
     options.session->progress.set_update_callback(function_bind(&session_print_status));
@@ -148,17 +185,109 @@ static void session_init()
 #endif
 
   /* load scene */
+  const double read_start_time = time_dt();
   scene_init();
+  options.frame_read_time = time_dt() - read_start_time;
+
+  /* Report time spent in each stage of the scene update for every frame. */
+  if (render_multiple_frames()) {
+    options.scene->enable_update_stats();
+  }
 
   /* add pass for output. */
   Pass *pass = options.scene->create_node<Pass>();
   pass->set_name(ustring(options.output_pass.c_str()));
   pass->set_type(PASS_COMBINED);
 
+  options.frame_render_start_time = time_dt();
   options.session->reset(options.session_params, session_buffer_params());
   options.session->start();
 }
 
+/* Apply changes for the next frame to the scene that was kept alive from the previous frame.
+ * Unchanged geometry, loaded images and compiled shaders are reused. */
+static void session_frame_update(const int frame)
+{
+  const double read_start_time = time_dt();
+
+  {
+    thread_scoped_lock scene_lock(options.scene->mutex);
+
+    if (!options.frame_delta_filepath.empty()) {
+      xml_read_file(options.scene, path_frame(options.frame_delta_filepath, frame).c_str());
+    }
+
+    /* Deltas may contain a camera without resolution. */
+    options.scene->camera->set_full_width(options.width);
+    options.scene->camera->set_full_height(options.height);
+    options.scene->camera->compute_auto_viewplane();
+    options.scene->camera->need_flags_update = true;
+    options.scene->camera->need_device_update = true;
+  }
+
+  options.frame_read_time = time_dt() - read_start_time;
+
+  session_set_output_driver(frame);
+
+  options.frame_render_start_time = time_dt();
+  options.session->reset(options.session_params, session_buffer_params());
+  options.session->start();
+}
+
+static void session_print_frame_stats(const int frame)
+{
+  const double total_time = time_dt() - options.frame_render_start_time;
+  const double update_time = (options.scene->update_stats) ?
+                                 options.scene->update_stats->scene.times.total_time :
+                                 0.0;
+
+  printf("\nFrame %d: read %.3fs, scene update %.3fs, render %.3fs, total %.3fs\n",
+         frame,
+         options.frame_read_time,
+         update_time,
+         max(total_time - update_time, 0.0),
+         options.frame_read_time + total_time);
+  fflush(stdout);
+}
+
+/* Write profiling statistics of the rendered frame as JSON. */
+static void session_write_profile_json(const int frame)
+{
+  if (options.profile_json_filepath.empty()) {
+    return;
+  }
+
+  RenderStats stats;
+  options.session->collect_statistics(&stats);
+
+  const string filepath = path_frame(options.profile_json_filepath, frame);
+  string text = stats.json_report();
+  if (!path_write_text(filepath, text)) {
+    fprintf(stderr, "Failed to write profile to %s\n", filepath.c_str());
+  }
+}
+
+static void session_render_frames()
+{
+  for (int frame = options.frame_start; frame <= options.frame_end; frame++) {
+    if (frame != options.frame_start) {
+      session_frame_update(frame);
+    }
+
+    options.session->wait();
+
+    if (options.session->progress.get_cancel()) {
+      break;
+    }
+
+    session_write_profile_json(frame);
+
+    if (render_multiple_frames()) {
+      session_print_frame_stats(frame);
+    }
+  }
+}
+
 static void session_exit()
 {
   if (options.session) {
@@ -359,6 +488,10 @@ static void options_parse(int argc, const char **argv)
   options.filepath = "";
   options.session = NULL;
   options.quiet = false;
+  options.frame_start = 1;
+  options.frame_end = 0;
+  options.frame_read_time = 0.0;
+  options.frame_render_start_time = 0.0;
   options.session_params.use_auto_tile = false;
   options.session_params.tile_size = 0;
 
@@ -407,7 +540,17 @@ static void options_parse(int argc, const char **argv)
              "Number of samples to render",
              "--output %s",
              &options.output_filepath,
-             "File path to write output image",
+             "File path to write output image, # characters are replaced by the frame number",
+             "--frame-start %d",
+             &options.frame_start,
+             "First frame to render",
+             "--frame-end %d",
+             &options.frame_end,
+             "Last frame to render, the session and scene are kept alive between frames",
+             "--frame-delta %s",
+             &options.frame_delta_filepath,
+             "XML file with changes to the scene for each frame, # characters are replaced by "
+             "the frame number",
              "--threads %d",
              &options.session_params.threads,
              "CPU Rendering Threads",
@@ -420,12 +563,22 @@ static void options_parse(int argc, const char **argv)
              "--tile-size %d",
              &options.session_params.tile_size,
              "Tile size in pixels",
+             "--half-float-tiles",
+             &options.session_params.use_half_float_tiles,
+             "Store color passes as half float in tile files written to disk",
+             "--texture-cache-size %d",
+             &options.scene_params.texture_cache_size,
+             "Stream image textures through a cache of this size in megabytes (CPU only)",
              "--list-devices",
              &list,
              "List information about all available devices",
              "--profile",
              &profile,
              "Enable profile logging",
+             "--profile-json %s",
+             &options.profile_json_filepath,
+             "Write time per kernel, shader and object to a JSON file, # characters are replaced "
+             "by the frame number (CPU only)",
 #ifdef WITH_CYCLES_LOGGING
              "--debug",
              &debug,
@@ -475,7 +628,7 @@ static void options_parse(int argc, const char **argv)
     exit(EXIT_SUCCESS);
   }
 
-  options.session_params.use_profiling = profile;
+  options.session_params.use_profiling = profile || !options.profile_json_filepath.empty();
 
   if (ssname == "osl")
     options.scene_params.shadingsystem = SHADINGSYSTEM_OSL;
@@ -490,6 +643,10 @@ static void options_parse(int argc, const char **argv)
     options.session_params.use_auto_tile = true;
   }
 
+  if (options.frame_end < options.frame_start) {
+    options.frame_end = options.frame_start;
+  }
+
   /* find matching device */
   DeviceType device_type = Device::type_from_string(devicename.c_str());
   vector<DeviceInfo> devices = Device::available_devices(DEVICE_MASK(device_type));
@@ -524,6 +681,15 @@ static void options_parse(int argc, const char **argv)
     fprintf(stderr, "No file path specified\n");
     exit(EXIT_FAILURE);
   }
+  else if (render_multiple_frames() && !options.session_params.background) {
+    fprintf(stderr, "Rendering multiple frames is only supported in background mode\n");
+    exit(EXIT_FAILURE);
+  }
+  else if (render_multiple_frames() && !options.output_filepath.empty() &&
+           options.output_filepath.find('#') == string::npos) {
+    fprintf(stderr, "Output file path needs # characters for the frame number\n");
+    exit(EXIT_FAILURE);
+  }
 }
 
 CCL_NAMESPACE_END
@@ -540,7 +706,7 @@ int main(int argc, const char **argv)
   if (options.session_params.background) {
 #endif
     session_init();
-    options.session->wait();
+    session_render_frames();
     session_exit();
 #ifdef WITH_CYCLES_STANDALONE_GUI
   }
@@ -372,11 +372,28 @@ static void xml_read_shader_graph(XMLReadState &state, Shader *shader, xml_node
   shader->tag_update(state.scene);
 }
 
+static Shader *xml_find_shader(Scene *scene, const char *name)
+{
+  foreach (Shader *shader, scene->shaders) {
+    if (shader->name == name) {
+      return shader;
+    }
+  }
+
+  return NULL;
+}
+
 static void xml_read_shader(XMLReadState &state, xml_node node)
 {
-  Shader *shader = new Shader();
+  /* Replace the graph of an existing shader with the same name. Images of the old graph stay
+   * loaded and are reused by the new graph. */
+  const char *name = node.attribute("name").value();
+  Shader *shader = (name[0] == '\0') ? NULL : xml_find_shader(state.scene, name);
+  if (!shader) {
+    shader = state.scene->create_node<Shader>();
+  }
+
   xml_read_shader_graph(state, shader, node);
-  state.scene->shaders.push_back(shader);
 }
 
 /* Background */
@@ -393,29 +410,34 @@ static void xml_read_background(XMLReadState &state, xml_node node)
 
 /* Mesh */
 
-static Mesh *xml_add_mesh(Scene *scene, const Transform &tfm)
+static Mesh *xml_add_mesh(Scene *scene, const Transform &tfm, ustring name)
 {
   /* create mesh */
-  Mesh *mesh = new Mesh();
-  scene->geometry.push_back(mesh);
+  Mesh *mesh = scene->create_node<Mesh>();
+  mesh->name = name;
 
   /* Create object. */
-  Object *object = new Object();
+  Object *object = scene->create_node<Object>();
+  object->name = name;
   object->set_geometry(mesh);
   object->set_tfm(tfm);
-  scene->objects.push_back(object);
 
   return mesh;
 }
 
-static void xml_read_mesh(const XMLReadState &state, xml_node node)
+static Object *xml_find_mesh_object(Scene *scene, ustring name)
 {
-  /* add mesh */
-  Mesh *mesh = xml_add_mesh(state.scene, state.tfm);
-  array<Node *> used_shaders = mesh->get_used_shaders();
-  used_shaders.push_back_slow(state.shader);
-  mesh->set_used_shaders(used_shaders);
+  foreach (Object *object, scene->objects) {
+    if (object->name == name && object->get_geometry()->is_mesh()) {
+      return object;
+    }
+  }
+
+  return NULL;
+}
 
+static void xml_read_mesh_data(const XMLReadState &state, Mesh *mesh, xml_node node)
+{
   /* read state */
   int shader = 0;
   bool smooth = state.smooth;
@@ -553,16 +575,85 @@ static void xml_read_mesh(const XMLReadState &state, xml_node node)
   }
 }
 
+static void xml_read_mesh(const XMLReadState &state, xml_node node)
+{
+  array<Node *> used_shaders;
+  used_shaders.push_back_slow(state.shader);
+
+  ustring name(node.attribute("name").value());
+  Object *object = (name.empty()) ? NULL : xml_find_mesh_object(state.scene, name);
+
+  if (!object) {
+    /* add mesh */
+    Mesh *mesh = xml_add_mesh(state.scene, state.tfm, name);
+    mesh->set_used_shaders(used_shaders);
+    xml_read_mesh_data(state, mesh, node);
+    return;
+  }
+
+  /* Update an existing mesh in place. Only modified data is copied to the device, and the BVH
+   * is refit instead of rebuilt when the topology did not change. */
+  Mesh *mesh = static_cast<Mesh *>(object->get_geometry());
+
+  Mesh new_mesh;
+  new_mesh.set_used_shaders(used_shaders);
+  xml_read_mesh_data(state, &new_mesh, node);
+
+  mesh->clear_non_sockets();
+
+  for (const SocketType &socket : new_mesh.type->inputs) {
+    if (socket.name == "use_motion_blur" || socket.name == "motion_steps" ||
+        socket.name == "used_shaders") {
+      continue;
+    }
+    mesh->set_value(socket, new_mesh, socket);
+  }
+
+  mesh->set_used_shaders(used_shaders);
+  mesh->attributes.update(std::move(new_mesh.attributes));
+  mesh->subd_attributes.update(std::move(new_mesh.subd_attributes));
+
+  mesh->set_num_subd_faces(new_mesh.get_num_subd_faces());
+
+  const bool rebuild = (mesh->triangles_is_modified()) || (mesh->subd_num_corners_is_modified()) ||
+                       (mesh->subd_shader_is_modified()) || (mesh->subd_smooth_is_modified()) ||
+                       (mesh->subd_ptex_offset_is_modified()) ||
+                       (mesh->subd_start_corner_is_modified()) ||
+                       (mesh->subd_face_corners_is_modified());
+
+  mesh->tag_update(state.scene, rebuild);
+
+  object->set_tfm(state.tfm);
+  if (object->is_modified()) {
+    object->tag_update(state.scene);
+  }
+}
+
 /* Light */
 
+static Light *xml_find_light(Scene *scene, const char *name)
+{
+  foreach (Light *light, scene->lights) {
+    if (light->name == name) {
+      return light;
+    }
+  }
+
+  return NULL;
+}
+
 static void xml_read_light(XMLReadState &state, xml_node node)
 {
-  Light *light = new Light();
+  const char *name = node.attribute("name").value();
+  Light *light = (name[0] == '\0') ? NULL : xml_find_light(state.scene, name);
+  if (!light) {
+    light = state.scene->create_node<Light>();
+  }
 
   light->set_shader(state.shader);
   xml_read_node(state, light, node);
 
-  state.scene->lights.push_back(light);
+  light->tag_update(state.scene);
 }
 
 /* Transform */
@@ -8,6 +8,9 @@ CCL_NAMESPACE_BEGIN
 
 class Scene;
 
+/* Read scene description into the scene. Meshes, lights and shaders with a name that already
+ * exists in the scene are updated in place, so the same function is used to apply per frame
+ * changes to a scene that is kept alive across frames. */
 void xml_read_file(Scene *scene, const char *filepath);
 
 /* macros for importing */
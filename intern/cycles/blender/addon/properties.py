@@ -943,6 +943,26 @@ class CyclesRenderSettings(bpy.types.PropertyGroup):
         description="",
         min=8, max=8192,
     )
+    use_half_float_tiles: BoolProperty(
+        name="Half Float Tiles",
+        description="Store color passes of tiles cached on disk as half float. Reduces disk usage and write time, "
+                    "at a small loss of precision",
+        default=False,
+    )
+
+    use_texture_cache: BoolProperty(
+        name="Use Texture Cache",
+        description="Stream image textures from disk while rendering on the CPU, loading only the tiles and mipmap levels that are needed. "
+                    "Reduces memory usage for scenes with many high resolution textures",
+        default=False,
+    )
+    texture_cache_size: IntProperty(
+        name="Texture Cache Size",
+        description="Maximum memory used by cached image tiles, in megabytes",
+        default=4096,
+        min=64, max=1048576,
+        subtype='UNSIGNED',
+    )
 
     # Various fine-tuning debug flags
 
@@ -959,6 +979,11 @@ class CyclesRenderSettings(bpy.types.PropertyGroup):
         items=enum_bvh_layouts,
         default='EMBREE',
     )
+    debug_use_cpu_wavefront: BoolProperty(
+        name="Wavefront",
+        description="Render batches of pixels together, tracing camera rays as packets and sorting shading by shader",
+        default=False,
+    )
 
     debug_use_cuda_adaptive_compile: BoolProperty(name="Adaptive Compile", default=False)
 
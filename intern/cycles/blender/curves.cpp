@@ -1070,6 +1070,8 @@ void BlenderSync::sync_hair(BL::Depsgraph b_depsgraph, BObjectInfo &b_ob_info, H
 
   /* update original sockets */
 
+  const size_t old_num_keys = hair->get_curve_keys().size();
+
   for (const SocketType &socket : new_hair.type->inputs) {
     /* Those sockets are updated in sync_object, so do not modify them. */
     if (socket.name == "use_motion_blur" || socket.name == "motion_steps" ||
@@ -1083,9 +1085,9 @@ void BlenderSync::sync_hair(BL::Depsgraph b_depsgraph, BObjectInfo &b_ob_info, H
 
   /* tag update */
 
-  /* Compares curve_keys rather than strands in order to handle quick hair
-   * adjustments in dynamic BVH - other methods could probably do this better. */
-  const bool rebuild = (hair->curve_keys_is_modified() || hair->curve_radius_is_modified());
+  /* Deformed curves only need a BVH refit, rebuild when the curve topology changes. */
+  const bool rebuild = (hair->curve_first_key_is_modified() ||
+                        hair->get_curve_keys().size() != old_num_keys);
 
   hair->tag_update(scene, rebuild);
 }
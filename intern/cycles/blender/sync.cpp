@@ -826,6 +826,13 @@ SceneParams BlenderSync::get_scene_params(BL::Scene &b_scene,
     params.texture_limit = 0;
   }
 
+  if (get_boolean(cscene, "use_texture_cache")) {
+    params.texture_cache_size = get_int(cscene, "texture_cache_size");
+  }
+  else {
+    params.texture_cache_size = 0;
+  }
+
   params.bvh_layout = DebugFlags().cpu.bvh_layout;
 
   params.background = background;
@@ -926,6 +933,7 @@ SessionParams BlenderSync::get_session_params(BL::RenderEngine &b_engine,
   if (background) {
     params.use_auto_tile = RNA_boolean_get(&cscene, "use_auto_tile");
     params.tile_size = max(get_int(cscene, "tile_size"), 8);
+    params.use_half_float_tiles = RNA_boolean_get(&cscene, "use_half_float_tiles");
   }
   else {
     params.use_auto_tile = false;
@@ -12,6 +12,7 @@
 
 #ifdef WITH_OPENVDB
 #  include <openvdb/openvdb.h>
+#  include <openvdb/tools/Dense.h>
 openvdb::GridBase::ConstPtr BKE_volume_grid_openvdb_for_read(const struct Volume *volume,
                                                              const struct VolumeGrid *grid);
 #endif
@@ -168,6 +169,90 @@ class BlenderSmokeLoader : public ImageLoader {
   AttributeStandard attribute;
 };
 
+#ifdef WITH_OPENVDB
+/* Scalar fluid grids are converted to a sparse OpenVDB grid on load. The volume mesh is then
+ * built from it directly, and devices with NanoVDB support sample a sparse grid instead of a
+ * dense texture covering the whole domain. */
+class BlenderSmokeGridLoader : public VDBImageLoader {
+ public:
+  BlenderSmokeGridLoader(BL::Object &b_ob, AttributeStandard attribute)
+      : VDBImageLoader(Attribute::standard_name(attribute)), dense_loader(b_ob, attribute)
+  {
+#  ifdef WITH_NANOVDB
+    /* Full precision, to render the same as the dense texture. */
+    precision = 32;
+#  endif
+  }
+
+  bool load_metadata(const ImageDeviceFeatures &features, ImageMetaData &metadata) override
+  {
+    get_grid();
+    return VDBImageLoader::load_metadata(features, metadata);
+  }
+
+  openvdb::GridBase::ConstPtr get_grid() override
+  {
+    /* Created on demand, as the grid is freed after loading the image but may be needed again
+     * to rebuild the volume mesh. */
+    if (!grid) {
+      grid = create_grid();
+    }
+    return grid;
+  }
+
+  bool equals(const ImageLoader &other) const override
+  {
+    const BlenderSmokeGridLoader &other_loader = (const BlenderSmokeGridLoader &)other;
+    return dense_loader.equals(other_loader.dense_loader);
+  }
+
+ protected:
+  openvdb::GridBase::ConstPtr create_grid()
+  {
+    ImageDeviceFeatures features;
+    features.has_nanovdb = false;
+    ImageMetaData metadata;
+    if (!dense_loader.load_metadata(features, metadata)) {
+      return nullptr;
+    }
+
+    const size_t num_voxels = ((size_t)metadata.width) * metadata.height * metadata.depth;
+    vector<float> voxels(num_voxels);
+    if (num_voxels == 0 ||
+        !dense_loader.load_pixels(metadata, voxels.data(), num_voxels * sizeof(float), false)) {
+      return nullptr;
+    }
+
+    const openvdb::CoordBBox dense_bbox(
+        0, 0, 0, metadata.width - 1, metadata.height - 1, metadata.depth - 1);
+    openvdb::tools::Dense<float, openvdb::tools::LayoutXYZ> dense(dense_bbox, voxels.data());
+
+    /* Only leave out voxels that are exactly zero, clipping is done when building the volume
+     * mesh. Leaves with constant values are kept, the volume mesh is built from leaves. */
+    openvdb::FloatGrid::Ptr sparse = openvdb::FloatGrid::create(0.0f);
+    openvdb::tools::copyFromDense(dense, *sparse, 0.0f);
+    sparse->tree().voxelizeActiveTiles();
+
+    /* Voxel index to object space, matching the texture space of the dense texture. */
+    const Transform index_to_object = transform_inverse(metadata.transform_3d) *
+                                      transform_scale(1.0f / metadata.width,
+                                                      1.0f / metadata.height,
+                                                      1.0f / metadata.depth);
+    openvdb::Mat4R index_to_object_mat = openvdb::Mat4R::identity();
+    for (int col = 0; col < 4; col++) {
+      for (int row = 0; row < 3; row++) {
+        index_to_object_mat[col][row] = (double)index_to_object[row][col];
+      }
+    }
+    sparse->setTransform(openvdb::math::Transform::createLinearTransform(index_to_object_mat));
+
+    return sparse;
+  }
+
+  BlenderSmokeLoader dense_loader;
+};
+#endif
+
 static void sync_smoke_volume(
     BL::Scene &b_scene, Scene *scene, BObjectInfo &b_ob_info, Volume *volume, float frame)
 {
@@ -209,7 +294,16 @@ static void sync_smoke_volume(
 
     Attribute *attr = volume->attributes.add(std);
 
-    ImageLoader *loader = new BlenderSmokeLoader(b_ob_info.real_object, std);
+    ImageLoader *loader;
+#ifdef WITH_OPENVDB
+    if (std != ATTR_STD_VOLUME_COLOR && std != ATTR_STD_VOLUME_VELOCITY) {
+      loader = new BlenderSmokeGridLoader(b_ob_info.real_object, std);
+    }
+    else
+#endif
+    {
+      loader = new BlenderSmokeLoader(b_ob_info.real_object, std);
+    }
     ImageParams params;
     params.frame = frame;
 
@@ -10,6 +10,9 @@
 
 #include "util/algorithm.h"
 #include "util/boundbox.h"
+#include "util/foreach.h"
+#include "util/tbb.h"
+#include "util/vector.h"
 #include "util/types.h"
 
 CCL_NAMESPACE_BEGIN
@@ -56,37 +59,12 @@ __forceinline int get_best_dimension(const float4 &bestSAH)
 
 /* BVH Object Binning */
 
-BVHObjectBinning::BVHObjectBinning(const BVHRange &job,
-                                   BVHReference *prims,
-                                   const BVHUnaligned *unaligned_heuristic,
-                                   const Transform *aligned_space)
-    : BVHRange(job),
-      splitSAH(FLT_MAX),
-      dim(0),
-      pos(0),
-      unaligned_heuristic_(unaligned_heuristic),
-      aligned_space_(aligned_space)
+void BVHObjectBinning::bin_primitives(const BVHReference *prims,
+                                      const size_t begin,
+                                      const size_t end,
+                                      BoundBox bin_bounds[MAX_BINS][4],
+                                      int4 bin_count[MAX_BINS]) const
 {
-  if (aligned_space_ == NULL) {
-    bounds_ = bounds();
-    cent_bounds_ = cent_bounds();
-  }
-  else {
-    /* TODO(sergey): With some additional storage we can avoid
-     * need in re-calculating this.
-     */
-    bounds_ = unaligned_heuristic->compute_aligned_boundbox(
-        *this, prims, *aligned_space, &cent_bounds_);
-  }
-
-  /* compute number of bins to use and precompute scaling factor for binning */
-  num_bins = min(size_t(MAX_BINS), size_t(4.0f + 0.05f * size()));
-  scale = rcp(cent_bounds_.size()) * make_float3((float)num_bins);
-
-  /* initialize binning counter and bounds */
-  BoundBox bin_bounds[MAX_BINS][4]; /* bounds for every bin in every dimension */
-  int4 bin_count[MAX_BINS];         /* number of primitives mapped to bin */
-
   for (size_t i = 0; i < num_bins; i++) {
     bin_count[i] = make_int4(0);
     bin_bounds[i][0] = bin_bounds[i][1] = bin_bounds[i][2] = BoundBox::empty;
@@ -96,12 +74,12 @@ BVHObjectBinning::BVHObjectBinning(const BVHRange &job,
   {
     int64_t i;
 
-    for (i = 0; i < int64_t(size()) - 1; i += 2) {
-      prefetch_L2(&prims[start() + i + 8]);
+    for (i = begin; i < int64_t(end) - 1; i += 2) {
+      prefetch_L2(&prims[i + 8]);
 
       /* map even and odd primitive to bin */
-      const BVHReference &prim0 = prims[start() + i + 0];
-      const BVHReference &prim1 = prims[start() + i + 1];
+      const BVHReference &prim0 = prims[i + 0];
+      const BVHReference &prim1 = prims[i + 1];
 
       BoundBox bounds0 = get_prim_bounds(prim0);
       BoundBox bounds1 = get_prim_bounds(prim1);
@@ -133,9 +111,9 @@ BVHObjectBinning::BVHObjectBinning(const BVHRange &job,
     }
 
     /* for uneven number of primitives */
-    if (i < int64_t(size())) {
+    if (i < int64_t(end)) {
       /* map primitive to bin */
-      const BVHReference &prim0 = prims[start() + i];
+      const BVHReference &prim0 = prims[i];
       BoundBox bounds0 = get_prim_bounds(prim0);
       int4 bin0 = get_bin(bounds0);
 
@@ -151,6 +129,72 @@ BVHObjectBinning::BVHObjectBinning(const BVHRange &job,
       bin_bounds[b02][2].grow(bounds0);
     }
   }
+}
+
+BVHObjectBinning::BVHObjectBinning(const BVHRange &job,
+                                   BVHReference *prims,
+                                   const BVHUnaligned *unaligned_heuristic,
+                                   const Transform *aligned_space)
+    : BVHRange(job),
+      splitSAH(FLT_MAX),
+      dim(0),
+      pos(0),
+      unaligned_heuristic_(unaligned_heuristic),
+      aligned_space_(aligned_space)
+{
+  if (aligned_space_ == NULL) {
+    bounds_ = bounds();
+    cent_bounds_ = cent_bounds();
+  }
+  else {
+    /* TODO(sergey): With some additional storage we can avoid
+     * need in re-calculating this.
+     */
+    bounds_ = unaligned_heuristic->compute_aligned_boundbox(
+        *this, prims, *aligned_space, &cent_bounds_);
+  }
+
+  /* compute number of bins to use and precompute scaling factor for binning */
+  num_bins = min(size_t(MAX_BINS), size_t(4.0f + 0.05f * size()));
+  scale = rcp(cent_bounds_.size()) * make_float3((float)num_bins);
+
+  /* initialize binning counter and bounds */
+  BoundBox bin_bounds[MAX_BINS][4]; /* bounds for every bin in every dimension */
+  int4 bin_count[MAX_BINS];         /* number of primitives mapped to bin */
+
+  if (size() < PARALLEL_TASK_SIZE * 2) {
+    bin_primitives(prims, start(), start() + size(), bin_bounds, bin_count);
+  }
+  else {
+    /* Large ranges at the top levels of the tree are binned in parallel, each task fills its
+     * own bins which are merged afterwards. */
+    struct TaskBins {
+      BoundBox bounds[MAX_BINS][4];
+      int4 count[MAX_BINS];
+    };
+    const size_t num_tasks = divide_up(size(), PARALLEL_TASK_SIZE);
+    vector<TaskBins> task_bins(num_tasks);
+
+    parallel_for(blocked_range<size_t>(0, num_tasks, 1), [&](const blocked_range<size_t> &r) {
+      for (size_t task = r.begin(); task != r.end(); task++) {
+        const size_t task_start = start() + task * PARALLEL_TASK_SIZE;
+        const size_t task_end = min(task_start + PARALLEL_TASK_SIZE, start() + size());
+        bin_primitives(
+            prims, task_start, task_end, task_bins[task].bounds, task_bins[task].count);
+      }
+    });
+
+    for (size_t i = 0; i < num_bins; i++) {
+      bin_count[i] = make_int4(0);
+      bin_bounds[i][0] = bin_bounds[i][1] = bin_bounds[i][2] = BoundBox::empty;
+      foreach (const TaskBins &bins, task_bins) {
+        bin_count[i] = bin_count[i] + bins.count[i];
+        bin_bounds[i][0].grow(bins.bounds[i][0]);
+        bin_bounds[i][1].grow(bins.bounds[i][1]);
+        bin_bounds[i][2].grow(bins.bounds[i][2]);
+      }
+    }
+  }
 
   /* sweep from right to left and compute parallel prefix of merged bounds */
   float4 r_area[MAX_BINS];  /* area of bounds of primitives on the right */
@@ -213,12 +257,118 @@ BVHObjectBinning::BVHObjectBinning(const BVHRange &job,
   leafSAH = bounds_.half_area() * blocks(size());
 }
 
+bool BVHObjectBinning::split_parallel(BVHReference *prims,
+                                      BVHObjectBinning &left_o,
+                                      BVHObjectBinning &right_o) const
+{
+  /* Tasks first count and bound the primitives on either side of the split in their part of
+   * the range, then move them to their final position through a temporary buffer. Unlike the
+   * serial partition this preserves the order of primitives on each side. */
+  struct TaskSplit {
+    size_t num_left;
+    BoundBox lgeom_bounds, rgeom_bounds;
+    BoundBox lcent_bounds, rcent_bounds;
+  };
+
+  const size_t N = size();
+  const size_t num_tasks = divide_up(N, PARALLEL_TASK_SIZE);
+  vector<TaskSplit> tasks(num_tasks);
+
+  parallel_for(blocked_range<size_t>(0, num_tasks, 1), [&](const blocked_range<size_t> &r) {
+    for (size_t task = r.begin(); task != r.end(); task++) {
+      TaskSplit &split = tasks[task];
+      split.num_left = 0;
+      split.lgeom_bounds = split.rgeom_bounds = BoundBox::empty;
+      split.lcent_bounds = split.rcent_bounds = BoundBox::empty;
+
+      const size_t task_start = start() + task * PARALLEL_TASK_SIZE;
+      const size_t task_end = min(task_start + PARALLEL_TASK_SIZE, start() + N);
+      for (size_t i = task_start; i < task_end; i++) {
+        const BVHReference &prim = prims[i];
+        if (goes_left(prim)) {
+          split.lgeom_bounds.grow(prim.bounds());
+          split.lcent_bounds.grow(prim.bounds().center2());
+          split.num_left++;
+        }
+        else {
+          split.rgeom_bounds.grow(prim.bounds());
+          split.rcent_bounds.grow(prim.bounds().center2());
+        }
+      }
+    }
+  });
+
+  /* Compute where every task writes its primitives. */
+  BoundBox lgeom_bounds = BoundBox::empty;
+  BoundBox rgeom_bounds = BoundBox::empty;
+  BoundBox lcent_bounds = BoundBox::empty;
+  BoundBox rcent_bounds = BoundBox::empty;
+  size_t num_left = 0;
+
+  foreach (const TaskSplit &split, tasks) {
+    lgeom_bounds.grow(split.lgeom_bounds);
+    rgeom_bounds.grow(split.rgeom_bounds);
+    lcent_bounds.grow(split.lcent_bounds);
+    rcent_bounds.grow(split.rcent_bounds);
+    num_left += split.num_left;
+  }
+
+  if (num_left == 0 || num_left == N) {
+    return false;
+  }
+
+  vector<size_t> left_offset(num_tasks), right_offset(num_tasks);
+  size_t left = 0, right = num_left;
+  for (size_t task = 0; task < num_tasks; task++) {
+    const size_t task_size = min(size_t(PARALLEL_TASK_SIZE), N - task * PARALLEL_TASK_SIZE);
+    left_offset[task] = left;
+    right_offset[task] = right;
+    left += tasks[task].num_left;
+    right += task_size - tasks[task].num_left;
+  }
+
+  vector<BVHReference> sorted_prims(N);
+
+  parallel_for(blocked_range<size_t>(0, num_tasks, 1), [&](const blocked_range<size_t> &r) {
+    for (size_t task = r.begin(); task != r.end(); task++) {
+      size_t l = left_offset[task], r_index = right_offset[task];
+      const size_t task_start = start() + task * PARALLEL_TASK_SIZE;
+      const size_t task_end = min(task_start + PARALLEL_TASK_SIZE, start() + N);
+      for (size_t i = task_start; i < task_end; i++) {
+        if (goes_left(prims[i])) {
+          sorted_prims[l++] = prims[i];
+        }
+        else {
+          sorted_prims[r_index++] = prims[i];
+        }
+      }
+    }
+  });
+
+  parallel_for(blocked_range<size_t>(0, N, PARALLEL_TASK_SIZE),
+               [&](const blocked_range<size_t> &r) {
+                 std::copy(sorted_prims.begin() + r.begin(),
+                           sorted_prims.begin() + r.end(),
+                           prims + start() + r.begin());
+               });
+
+  right_o = BVHObjectBinning(
+      BVHRange(rgeom_bounds, rcent_bounds, start() + num_left, N - num_left), prims);
+  left_o = BVHObjectBinning(BVHRange(lgeom_bounds, lcent_bounds, start(), num_left), prims);
+  return true;
+}
+
 void BVHObjectBinning::split(BVHReference *prims,
                              BVHObjectBinning &left_o,
                              BVHObjectBinning &right_o) const
 {
   size_t N = size();
 
+  /* Partition large ranges at the top levels of the tree in parallel. */
+  if (N >= PARALLEL_TASK_SIZE * 2 && split_parallel(prims, left_o, right_o)) {
+    return;
+  }
+
   BoundBox lgeom_bounds = BoundBox::empty;
   BoundBox rgeom_bounds = BoundBox::empty;
   BoundBox lcent_bounds = BoundBox::empty;
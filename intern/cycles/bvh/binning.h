@@ -58,6 +58,25 @@ class BVHObjectBinning : public BVHRange {
   enum { MAX_BINS = 32 };
   enum { LOG_BLOCK_SIZE = 2 };
 
+  /* Ranges of at least twice this size are binned and partitioned in parallel. */
+  enum { PARALLEL_TASK_SIZE = 65536 };
+
+  void bin_primitives(const BVHReference *prims,
+                      const size_t begin,
+                      const size_t end,
+                      BoundBox bin_bounds[MAX_BINS][4],
+                      int4 bin_count[MAX_BINS]) const;
+
+  bool split_parallel(BVHReference *prims,
+                      BVHObjectBinning &left_o,
+                      BVHObjectBinning &right_o) const;
+
+  /* test if a primitive is on the left side of the best split. */
+  __forceinline bool goes_left(const BVHReference &prim) const
+  {
+    return get_bin(get_prim_bounds(prim).center2())[dim] < pos;
+  }
+
   /* computes the bin numbers for each dimension for a box. */
   __forceinline int4 get_bin(const BoundBox &box) const
   {
@@ -23,6 +23,7 @@
 #include "util/queue.h"
 #include "util/simd.h"
 #include "util/stack_allocator.h"
+#include "util/tbb.h"
 #include "util/time.h"
 
 CCL_NAMESPACE_BEGIN
@@ -58,15 +59,17 @@ BVHBuild::~BVHBuild()
 void BVHBuild::add_reference_triangles(BoundBox &root,
                                        BoundBox &center,
                                        Mesh *mesh,
-                                       int object_index)
+                                       int object_index,
+                                       const size_t prim_start,
+                                       const size_t prim_end,
+                                       vector<BVHReference> &references)
 {
   const PrimitiveType primitive_type = mesh->primitive_type();
   const Attribute *attr_mP = NULL;
   if (mesh->has_motion_blur()) {
     attr_mP = mesh->attributes.find(ATTR_STD_MOTION_VERTEX_POSITION);
   }
-  const size_t num_triangles = mesh->num_triangles();
-  for (uint j = 0; j < num_triangles; j++) {
+  for (uint j = prim_start; j < prim_end; j++) {
     Mesh::Triangle t = mesh->get_triangle(j);
     const float3 *verts = &mesh->verts[0];
     if (attr_mP == NULL) {
@@ -145,7 +148,13 @@ void BVHBuild::add_reference_triangles(BoundBox &root,
   }
 }
 
-void BVHBuild::add_reference_curves(BoundBox &root, BoundBox &center, Hair *hair, int object_index)
+void BVHBuild::add_reference_curves(BoundBox &root,
+                                    BoundBox &center,
+                                    Hair *hair,
+                                    int object_index,
+                                    const size_t prim_start,
+                                    const size_t prim_end,
+                                    vector<BVHReference> &references)
 {
   const Attribute *curve_attr_mP = NULL;
   if (hair->has_motion_blur()) {
@@ -154,8 +163,7 @@ void BVHBuild::add_reference_curves(BoundBox &root, BoundBox &center, Hair *hair
 
   const PrimitiveType primitive_type = hair->primitive_type();
 
-  const size_t num_curves = hair->num_curves();
-  for (uint j = 0; j < num_curves; j++) {
+  for (uint j = prim_start; j < prim_end; j++) {
     const Hair::Curve curve = hair->get_curve(j);
     const float *curve_radius = &hair->get_curve_radius()[0];
     for (int k = 0; k < curve.num_keys - 1; k++) {
@@ -260,7 +268,10 @@ void BVHBuild::add_reference_curves(BoundBox &root, BoundBox &center, Hair *hair
 void BVHBuild::add_reference_points(BoundBox &root,
                                     BoundBox &center,
                                     PointCloud *pointcloud,
-                                    int i)
+                                    int i,
+                                    const size_t prim_start,
+                                    const size_t prim_end,
+                                    vector<BVHReference> &references)
 {
   const Attribute *point_attr_mP = NULL;
   if (pointcloud->has_motion_blur()) {
@@ -275,7 +286,7 @@ void BVHBuild::add_reference_points(BoundBox &root,
 
   if (point_attr_mP == NULL) {
     /* Really simple logic for static points. */
-    for (uint j = 0; j < num_points; j++) {
+    for (uint j = prim_start; j < prim_end; j++) {
       const PointCloud::Point point = pointcloud->get_point(j);
       BoundBox bounds = BoundBox::empty;
       point.bounds_grow(points_data, radius_data, bounds);
@@ -292,7 +303,7 @@ void BVHBuild::add_reference_points(BoundBox &root,
      * rendering.
      */
     /* TODO(sergey): Support motion steps for spatially split BVH. */
-    for (uint j = 0; j < num_points; j++) {
+    for (uint j = prim_start; j < prim_end; j++) {
       const PointCloud::Point point = pointcloud->get_point(j);
       BoundBox bounds = BoundBox::empty;
       point.bounds_grow(points_data, radius_data, bounds);
@@ -314,7 +325,7 @@ void BVHBuild::add_reference_points(BoundBox &root,
     const int num_bvh_steps = params.num_motion_point_steps * 2 + 1;
     const float num_bvh_steps_inv_1 = 1.0f / (num_bvh_steps - 1);
 
-    for (uint j = 0; j < num_points; j++) {
+    for (uint j = prim_start; j < prim_end; j++) {
       const PointCloud::Point point = pointcloud->get_point(j);
       const size_t num_steps = pointcloud->get_motion_steps();
       const float3 *point_steps = point_attr_mP->data_float3();
@@ -355,39 +366,37 @@ void BVHBuild::add_reference_points(BoundBox &root,
 void BVHBuild::add_reference_geometry(BoundBox &root,
                                       BoundBox &center,
                                       Geometry *geom,
-                                      int object_index)
+                                      int object_index,
+                                      const size_t prim_start,
+                                      const size_t prim_end,
+                                      vector<BVHReference> &references)
 {
   if (geom->geometry_type == Geometry::MESH || geom->geometry_type == Geometry::VOLUME) {
     Mesh *mesh = static_cast<Mesh *>(geom);
-    add_reference_triangles(root, center, mesh, object_index);
+    add_reference_triangles(
+        root, center, mesh, object_index, prim_start, prim_end, references);
   }
   else if (geom->geometry_type == Geometry::HAIR) {
     Hair *hair = static_cast<Hair *>(geom);
-    add_reference_curves(root, center, hair, object_index);
+    add_reference_curves(root, center, hair, object_index, prim_start, prim_end, references);
   }
   else if (geom->geometry_type == Geometry::POINTCLOUD) {
     PointCloud *pointcloud = static_cast<PointCloud *>(geom);
-    add_reference_points(root, center, pointcloud, object_index);
+    add_reference_points(
+        root, center, pointcloud, object_index, prim_start, prim_end, references);
   }
 }
 
-void BVHBuild::add_reference_object(BoundBox &root, BoundBox &center, Object *ob, int i)
+void BVHBuild::add_reference_object(
+    BoundBox &root, BoundBox &center, Object *ob, int i, vector<BVHReference> &references)
 {
   references.push_back(BVHReference(ob->bounds, -1, i, 0));
   root.grow(ob->bounds);
   center.grow(ob->bounds.center2());
 }
 
-static size_t count_curve_segments(Hair *hair)
-{
-  size_t num = 0, num_curves = hair->num_curves();
-
-  for (size_t i = 0; i < num_curves; i++)
-    num += hair->get_curve(i).num_keys - 1;
-
-  return num;
-}
-
+/* Number of triangles, curves or points, which are the units geometry is split into for
+ * adding references in parallel. */
 static size_t count_primitives(Geometry *geom)
 {
   if (geom->geometry_type == Geometry::MESH || geom->geometry_type == Geometry::VOLUME) {
@@ -396,7 +405,7 @@ static size_t count_primitives(Geometry *geom)
   }
   else if (geom->geometry_type == Geometry::HAIR) {
     Hair *hair = static_cast<Hair *>(geom);
-    return count_curve_segments(hair);
+    return hair->num_curves();
   }
   else if (geom->geometry_type == Geometry::POINTCLOUD) {
     PointCloud *pointcloud = static_cast<PointCloud *>(geom);
@@ -406,52 +415,101 @@ static size_t count_primitives(Geometry *geom)
   return 0;
 }
 
+/* References for a range of primitives of one object, added by a single task. */
+struct BVHReferenceChunk {
+  Object *object;
+  int object_index;
+  bool is_instance;
+  size_t prim_start;
+  size_t prim_end;
+
+  vector<BVHReference> references;
+  BoundBox bounds;
+  BoundBox center;
+};
+
 void BVHBuild::add_references(BVHRange &root)
 {
-  /* reserve space for references */
-  size_t num_alloc_references = 0;
+  /* Split objects into chunks of primitives. Chunks are filled in parallel and then
+   * concatenated in order, so the references do not depend on the number of threads. */
+  vector<BVHReferenceChunk> chunks;
+  int i = 0;
 
   foreach (Object *ob, objects) {
-    if (params.top_level) {
-      if (!ob->is_traceable()) {
-        continue;
-      }
-      if (!ob->get_geometry()->is_instanced()) {
-        num_alloc_references += count_primitives(ob->get_geometry());
-      }
-      else {
-        num_alloc_references++;
-      }
+    if (params.top_level && !ob->is_traceable()) {
+      ++i;
+      continue;
+    }
+
+    if (params.top_level && ob->get_geometry()->is_instanced()) {
+      BVHReferenceChunk chunk;
+      chunk.object = ob;
+      chunk.object_index = i;
+      chunk.is_instance = true;
+      chunk.prim_start = 0;
+      chunk.prim_end = 1;
+      chunks.push_back(chunk);
     }
     else {
-      num_alloc_references += count_primitives(ob->get_geometry());
+      const size_t num_primitives = count_primitives(ob->get_geometry());
+      for (size_t start = 0; start < num_primitives; start += REFERENCE_TASK_SIZE) {
+        BVHReferenceChunk chunk;
+        chunk.object = ob;
+        chunk.object_index = i;
+        chunk.is_instance = false;
+        chunk.prim_start = start;
+        chunk.prim_end = min(start + REFERENCE_TASK_SIZE, num_primitives);
+        chunks.push_back(chunk);
+      }
     }
-  }
 
-  references.reserve(num_alloc_references);
+    i++;
+  }
 
-  /* add references from objects */
-  BoundBox bounds = BoundBox::empty, center = BoundBox::empty;
-  int i = 0;
+  parallel_for(blocked_range<size_t>(0, chunks.size(), 1), [&](const blocked_range<size_t> &r) {
+    for (size_t c = r.begin(); c != r.end(); c++) {
+      if (progress.get_cancel()) {
+        return;
+      }
 
-  foreach (Object *ob, objects) {
-    if (params.top_level) {
-      if (!ob->is_traceable()) {
-        ++i;
-        continue;
+      BVHReferenceChunk &chunk = chunks[c];
+      chunk.bounds = BoundBox::empty;
+      chunk.center = BoundBox::empty;
+      if (chunk.is_instance) {
+        add_reference_object(
+            chunk.bounds, chunk.center, chunk.object, chunk.object_index, chunk.references);
+      }
+      else {
+        chunk.references.reserve(chunk.prim_end - chunk.prim_start);
+        add_reference_geometry(chunk.bounds,
+                               chunk.center,
+                               chunk.object->get_geometry(),
+                               chunk.object_index,
+                               chunk.prim_start,
+                               chunk.prim_end,
+                               chunk.references);
       }
-      if (!ob->get_geometry()->is_instanced())
-        add_reference_geometry(bounds, center, ob->get_geometry(), i);
-      else
-        add_reference_object(bounds, center, ob, i);
     }
-    else
-      add_reference_geometry(bounds, center, ob->get_geometry(), i);
+  });
 
-    i++;
+  if (progress.get_cancel()) {
+    return;
+  }
 
-    if (progress.get_cancel())
-      return;
+  /* Concatenate chunks, freeing their memory as they are copied. */
+  size_t num_references = 0;
+  foreach (const BVHReferenceChunk &chunk, chunks) {
+    num_references += chunk.references.size();
+  }
+
+  references.reserve(num_references);
+
+  BoundBox bounds = BoundBox::empty, center = BoundBox::empty;
+  foreach (BVHReferenceChunk &chunk, chunks) {
+    references.insert(references.end(), chunk.references.begin(), chunk.references.end());
+    chunk.references.free_memory();
+    bounds.grow(chunk.bounds);
+    center.grow(chunk.center);
   }
 
   /* happens mostly on empty meshes */
@@ -54,11 +54,37 @@ class BVHBuild {
   friend class BVHObjectBinning;
 
   /* Adding references. */
-  void add_reference_triangles(BoundBox &root, BoundBox &center, Mesh *mesh, int i);
-  void add_reference_curves(BoundBox &root, BoundBox &center, Hair *hair, int i);
-  void add_reference_points(BoundBox &root, BoundBox &center, PointCloud *pointcloud, int i);
-  void add_reference_geometry(BoundBox &root, BoundBox &center, Geometry *geom, int i);
-  void add_reference_object(BoundBox &root, BoundBox &center, Object *ob, int i);
+  enum { REFERENCE_TASK_SIZE = 16384 };
+  void add_reference_triangles(BoundBox &root,
+                               BoundBox &center,
+                               Mesh *mesh,
+                               int i,
+                               const size_t prim_start,
+                               const size_t prim_end,
+                               vector<BVHReference> &references);
+  void add_reference_curves(BoundBox &root,
+                            BoundBox &center,
+                            Hair *hair,
+                            int i,
+                            const size_t prim_start,
+                            const size_t prim_end,
+                            vector<BVHReference> &references);
+  void add_reference_points(BoundBox &root,
+                            BoundBox &center,
+                            PointCloud *pointcloud,
+                            int i,
+                            const size_t prim_start,
+                            const size_t prim_end,
+                            vector<BVHReference> &references);
+  void add_reference_geometry(BoundBox &root,
+                              BoundBox &center,
+                              Geometry *geom,
+                              int i,
+                              const size_t prim_start,
+                              const size_t prim_end,
+                              vector<BVHReference> &references);
+  void add_reference_object(
+      BoundBox &root, BoundBox &center, Object *ob, int i, vector<BVHReference> &references);
   void add_references(BVHRange &root);
 
   /* Building. */
@@ -10,6 +10,9 @@
 #include "bvh/multi.h"
 #include "bvh/optix.h"
 
+#include "scene/geometry.h"
+#include "scene/object.h"
+
 #include "util/log.h"
 #include "util/progress.h"
 
@@ -115,4 +118,44 @@ BVH *BVH::create(const BVHParams &params,
   return NULL;
 }
 
+enum {
+  BVH_OBJECT_TRACEABLE = (1 << 0),
+  BVH_OBJECT_INSTANCED = (1 << 1),
+};
+
+static uint8_t bvh_object_layout(const Object *ob, const BVHLayout bvh_layout)
+{
+  uint8_t layout = 0;
+  if (ob->is_traceable()) {
+    layout |= BVH_OBJECT_TRACEABLE;
+  }
+  if (ob->get_geometry()->need_build_bvh(bvh_layout)) {
+    layout |= BVH_OBJECT_INSTANCED;
+  }
+  return layout;
+}
+
+bool BVH::can_refit_objects(const vector<Object *> &objects) const
+{
+  if (objects != this->objects || object_layout.size() != objects.size()) {
+    return false;
+  }
+
+  for (size_t i = 0; i < objects.size(); i++) {
+    if (bvh_object_layout(objects[i], params.bvh_layout) != object_layout[i]) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+void BVH::store_object_layout()
+{
+  object_layout.resize(objects.size());
+  for (size_t i = 0; i < objects.size(); i++) {
+    object_layout[i] = bvh_object_layout(objects[i], params.bvh_layout);
+  }
+}
+
 CCL_NAMESPACE_END
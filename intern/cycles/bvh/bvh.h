@@ -81,10 +81,18 @@ class BVH {
     this->objects = objects;
   }
 
+  /* Top level BVH refit, only possible when the objects are the same as in the last build and
+   * their geometry is still part of the top level BVH or instanced in the same way. */
+  bool can_refit_objects(const vector<Object *> &objects) const;
+  void store_object_layout();
+
  protected:
   BVH(const BVHParams &params,
       const vector<Geometry *> &geometry,
       const vector<Object *> &objects);
+
+  /* Traceable and instanced state of the objects in the last build. */
+  vector<uint8_t> object_layout;
 };
 
 CCL_NAMESPACE_END
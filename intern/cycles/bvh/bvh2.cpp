@@ -88,12 +88,28 @@ void BVH2::build(Progress &progress, Stats *)
 
 void BVH2::refit(Progress &progress)
 {
+  if (params.top_level) {
+    /* Packed data of the last build was moved to the device, restore the top level part. */
+    pack.prim_index = top_level_pack.prim_index;
+    pack.prim_type = top_level_pack.prim_type;
+    pack.prim_object = top_level_pack.prim_object;
+    pack.prim_time = top_level_pack.prim_time;
+  }
+
   progress.set_substatus("Packing BVH primitives");
   pack_primitives();
 
   if (progress.get_cancel())
     return;
 
+  if (params.top_level) {
+    /* Instance BVHs may have been refit as well, so merge them again. */
+    pack.nodes = top_level_pack.nodes;
+    pack.leaf_nodes = top_level_pack.leaf_nodes;
+    pack.root_index = top_level_pack.root_index;
+    pack_instances(pack.nodes.size(), pack.leaf_nodes.size());
+  }
+
   progress.set_substatus("Refitting BVH nodes");
   refit_nodes();
 }
@@ -248,6 +264,12 @@ void BVH2::pack_nodes(const BVHNode *root)
   pack.leaf_nodes.clear();
   /* For top level BVH, first merge existing BVH's so we know the offsets. */
   if (params.top_level) {
+    /* Keep primitives before they are merged with the instances, for refitting. */
+    top_level_pack.prim_index = pack.prim_index;
+    top_level_pack.prim_type = pack.prim_type;
+    top_level_pack.prim_object = pack.prim_object;
+    top_level_pack.prim_time = pack.prim_time;
+
     pack_instances(node_size, num_leaf_nodes * BVH_NODE_LEAF_SIZE);
   }
   else {
@@ -299,12 +321,25 @@ void BVH2::pack_nodes(const BVHNode *root)
   assert(node_size == nextNodeIdx);
   /* root index to start traversal at, to handle case of single leaf node */
   pack.root_index = (root->is_leaf()) ? -1 : 0;
+
+  if (params.top_level) {
+    /* Keep top level nodes, instance nodes follow them. */
+    top_level_pack.nodes.resize(node_size);
+    top_level_pack.leaf_nodes.resize(num_leaf_nodes * BVH_NODE_LEAF_SIZE);
+    if (node_size) {
+      memcpy(top_level_pack.nodes.data(), pack.nodes.data(), sizeof(int4) * node_size);
+    }
+    if (num_leaf_nodes) {
+      memcpy(top_level_pack.leaf_nodes.data(),
+             pack.leaf_nodes.data(),
+             sizeof(int4) * num_leaf_nodes * BVH_NODE_LEAF_SIZE);
+    }
+    top_level_pack.root_index = pack.root_index;
+  }
 }
 
 void BVH2::refit_nodes()
 {
-  assert(!params.top_level);
-
   BoundBox bbox = BoundBox::empty;
   uint visibility = 0;
   refit_node(0, (pack.root_index == -1) ? true : false, bbox, visibility);
@@ -319,7 +354,13 @@ void BVH2::refit_node(int idx, bool leaf, BoundBox &bbox, uint &visibility)
     const int c0 = data[0].x;
     const int c1 = data[0].y;
 
-    refit_primitives(c0, c1, bbox, visibility);
+    if (c0 < 0) {
+      /* Object instance in the top level BVH. */
+      refit_primitives(~c0, ~c0 + 1, bbox, visibility);
+    }
+    else {
+      refit_primitives(c0, c1, bbox, visibility);
+    }
 
     /* TODO(sergey): De-duplicate with pack_leaf(). */
     float4 leaf_data[BVH_NODE_LEAF_SIZE];
@@ -38,6 +38,9 @@ class BVH2 : public BVH {
   PackedBVH pack;
 
  protected:
+  /* Top level nodes and primitives of the last build, without merged instances. */
+  PackedBVH top_level_pack;
+
   /* constructor */
   friend class BVH;
   BVH2(const BVHParams &params,
@@ -194,12 +194,24 @@ void BVHEmbree::add_instance(Object *ob, int i)
   BVHEmbree *instance_bvh = (BVHEmbree *)(ob->get_geometry()->bvh);
   assert(instance_bvh != NULL);
 
+  RTCGeometry geom_id = rtcNewGeometry(rtc_device, RTC_GEOMETRY_TYPE_INSTANCE);
+  rtcSetGeometryInstancedScene(geom_id, instance_bvh->scene);
+  set_instance_transform(geom_id, ob);
+
+  rtcSetGeometryUserData(geom_id, (void *)instance_bvh->scene);
+  rtcSetGeometryMask(geom_id, ob->visibility_for_tracing());
+
+  rtcCommitGeometry(geom_id);
+  rtcAttachGeometryByID(scene, geom_id, i * 2);
+  rtcReleaseGeometry(geom_id);
+}
+
+void BVHEmbree::set_instance_transform(RTCGeometry geom_id, const Object *ob)
+{
   const size_t num_object_motion_steps = ob->use_motion() ? ob->get_motion().size() : 1;
   const size_t num_motion_steps = min(num_object_motion_steps, (size_t)RTC_MAX_TIME_STEP_COUNT);
   assert(num_object_motion_steps <= RTC_MAX_TIME_STEP_COUNT);
 
-  RTCGeometry geom_id = rtcNewGeometry(rtc_device, RTC_GEOMETRY_TYPE_INSTANCE);
-  rtcSetGeometryInstancedScene(geom_id, instance_bvh->scene);
   rtcSetGeometryTimeStepCount(geom_id, num_motion_steps);
 
   if (ob->use_motion()) {
@@ -223,13 +235,6 @@ void BVHEmbree::add_instance(Object *ob, int i)
     rtcSetGeometryTransform(
         geom_id, 0, RTC_FORMAT_FLOAT3X4_ROW_MAJOR, (const float *)&ob->get_tfm());
   }
-
-  rtcSetGeometryUserData(geom_id, (void *)instance_bvh->scene);
-  rtcSetGeometryMask(geom_id, ob->visibility_for_tracing());
-
-  rtcCommitGeometry(geom_id);
-  rtcAttachGeometryByID(scene, geom_id, i * 2);
-  rtcReleaseGeometry(geom_id);
 }
 
 void BVHEmbree::add_triangles(const Object *ob, const Mesh *mesh, int i)
@@ -555,10 +560,17 @@ void BVHEmbree::refit(Progress &progress)
 {
   progress.set_substatus("Refitting BVH nodes");
 
-  /* Update all vertex buffers, then tell Embree to rebuild/-fit the BVHs. */
+  /* Update all vertex buffers and instance transforms, then tell Embree to rebuild/-fit the
+   * BVHs. */
   unsigned geom_id = 0;
   foreach (Object *ob, objects) {
-    if (!params.top_level || (ob->is_traceable() && !ob->get_geometry()->is_instanced())) {
+    if (params.top_level && ob->is_traceable() && ob->get_geometry()->is_instanced()) {
+      RTCGeometry geom = rtcGetGeometry(scene, geom_id);
+      set_instance_transform(geom, ob);
+      rtcSetGeometryMask(geom, ob->visibility_for_tracing());
+      rtcCommitGeometry(geom);
+    }
+    else if (!params.top_level || ob->is_traceable()) {
       Geometry *geom = ob->get_geometry();
 
       if (geom->geometry_type == Geometry::MESH || geom->geometry_type == Geometry::VOLUME) {
@@ -567,6 +579,7 @@ void BVHEmbree::refit(Progress &progress)
           RTCGeometry geom = rtcGetGeometry(scene, geom_id);
           set_tri_vertex_buffer(geom, mesh, true);
           rtcSetGeometryUserData(geom, (void *)mesh->prim_offset);
+          rtcSetGeometryMask(geom, ob->visibility_for_tracing());
           rtcCommitGeometry(geom);
         }
       }
@@ -576,6 +589,7 @@ void BVHEmbree::refit(Progress &progress)
           RTCGeometry geom = rtcGetGeometry(scene, geom_id + 1);
           set_curve_vertex_buffer(geom, hair, true);
           rtcSetGeometryUserData(geom, (void *)hair->curve_segment_offset);
+          rtcSetGeometryMask(geom, ob->visibility_for_tracing());
           rtcCommitGeometry(geom);
         }
       }
@@ -584,6 +598,7 @@ void BVHEmbree::refit(Progress &progress)
         if (pointcloud->num_points() > 0) {
           RTCGeometry geom = rtcGetGeometry(scene, geom_id);
           set_point_vertex_buffer(geom, pointcloud, true);
+          rtcSetGeometryMask(geom, ob->visibility_for_tracing());
           rtcCommitGeometry(geom);
         }
       }
@@ -27,9 +27,15 @@ class CPUKernels {
                                                             KernelWorkTile *tile,
                                                             ccl_global float *render_buffer)>;
 
+  using IntegratorPacketFunction = CPUKernelFunction<void (*)(const KernelGlobalsCPU *kg,
+                                                              IntegratorStateCPU **states,
+                                                              const int num_states,
+                                                              ccl_global float *render_buffer)>;
+
   IntegratorInitFunction integrator_init_from_camera;
   IntegratorInitFunction integrator_init_from_bake;
   IntegratorShadeFunction integrator_intersect_closest;
+  IntegratorPacketFunction integrator_intersect_closest_packet;
   IntegratorFunction integrator_intersect_shadow;
   IntegratorFunction integrator_intersect_subsurface;
   IntegratorFunction integrator_intersect_volume_stack;
@@ -39,6 +45,7 @@ class CPUKernels {
   IntegratorShadeFunction integrator_shade_surface;
   IntegratorShadeFunction integrator_shade_volume;
   IntegratorShadeFunction integrator_megakernel;
+  IntegratorShadeFunction integrator_megakernel_until_shade_surface;
 
   /* Shader evaluation. */
 
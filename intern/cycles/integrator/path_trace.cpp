@@ -773,8 +773,11 @@ void PathTrace::finalize_full_buffer_on_disk(const RenderWork &render_work)
   }
 
   /* Make sure writing to the file is fully finished.
-   * This will include writing all possible missing tiles, ensuring validness of the file. */
-  tile_manager_.finish_write_tiles();
+   * This will include waiting for tiles which are still being written in the background, and
+   * writing all possible missing tiles, ensuring validness of the file. */
+  if (!tile_manager_.finish_write_tiles()) {
+    device_->set_error("Error writing tiles to file");
+  }
 
   /* NOTE: The rest of full-frame post-processing (such as full-frame denoising) will be done after
    * all scenes and layers are rendered by the Session (which happens after freeing Session memory,
@@ -16,9 +16,12 @@
 #include "session/buffers.h"
 
 #include "util/atomic.h"
+#include "util/debug.h"
 #include "util/log.h"
 #include "util/tbb.h"
 
+#include <algorithm>
+
 CCL_NAMESPACE_BEGIN
 
 /* Create TBB arena for execution of path tracing and rendering tasks. */
@@ -41,6 +44,26 @@ static inline CPUKernelThreadGlobals *kernel_thread_globals_get(
   return &kernel_thread_globals[thread_index];
 }
 
+/* Number of neighboring pixels rendered together in the wavefront mode. Camera rays are
+ * intersected in packets of INTEGRATOR_PACKET_SIZE_CPU, and surface shading of all paths is
+ * sorted by shader. */
+static constexpr int WAVEFRONT_BATCH_SIZE = 32;
+
+/* Get integrator states of the wavefront mode for the current thread. */
+static inline IntegratorStateCPU *wavefront_integrator_states_get(
+    vector<vector<IntegratorStateCPU>> &wavefront_integrator_states, const size_t num_states)
+{
+  const int thread_index = tbb::this_task_arena::current_thread_index();
+  DCHECK_GE(thread_index, 0);
+  DCHECK_LE(thread_index, wavefront_integrator_states.size());
+
+  vector<IntegratorStateCPU> &states = wavefront_integrator_states[thread_index];
+  if (states.size() < num_states) {
+    states.resize(num_states);
+  }
+  return states.data();
+}
+
 PathTraceWorkCPU::PathTraceWorkCPU(Device *device,
                                    Film *film,
                                    DeviceScene *device_scene,
@@ -72,8 +95,56 @@ void PathTraceWorkCPU::render_samples(RenderStatistics &statistics,
     }
   }
 
+  /* Baking has no coherent rays to trace as packets. Guiding training records the segments of
+   * one path at a time in the per-thread storage, which interleaved paths would mix. */
+  const bool train_guiding = !kernel_thread_globals_.empty() &&
+                             kernel_thread_globals_[0].data.integrator.train_guiding;
+  const bool use_wavefront = DebugFlags().cpu.use_wavefront && !device_scene_->data.bake.use &&
+                             !train_guiding;
+  if (use_wavefront) {
+    wavefront_integrator_states_.resize(kernel_thread_globals_.size());
+  }
+
   tbb::task_arena local_arena = local_tbb_arena_create(device_);
   local_arena.execute([&]() {
+    if (use_wavefront) {
+      /* Batches of neighboring pixels in the same row. */
+      const int64_t batches_per_row = divide_up(image_width, WAVEFRONT_BATCH_SIZE);
+      const int64_t total_batches_num = batches_per_row * image_height;
+      const int num_batch_states = WAVEFRONT_BATCH_SIZE *
+                                   (device_scene_->data.integrator.has_shadow_catcher ? 2 : 1);
+
+      parallel_for(int64_t(0), total_batches_num, [&](int64_t work_index) {
+        if (is_cancel_requested()) {
+          return;
+        }
+
+        const int y = work_index / batches_per_row;
+        const int x = (work_index - y * batches_per_row) * WAVEFRONT_BATCH_SIZE;
+
+        KernelWorkTile work_tile;
+        work_tile.x = effective_buffer_params_.full_x + x;
+        work_tile.y = effective_buffer_params_.full_y + y;
+        work_tile.w = 1;
+        work_tile.h = 1;
+        work_tile.start_sample = start_sample;
+        work_tile.sample_offset = sample_offset;
+        work_tile.num_samples = 1;
+        work_tile.offset = effective_buffer_params_.offset;
+        work_tile.stride = effective_buffer_params_.stride;
+
+        const int num_pixels = min(int(image_width) - x, WAVEFRONT_BATCH_SIZE);
+
+        CPUKernelThreadGlobals *kernel_globals = kernel_thread_globals_get(kernel_thread_globals_);
+        IntegratorStateCPU *integrator_states = wavefront_integrator_states_get(
+            wavefront_integrator_states_, num_batch_states);
+
+        render_samples_wavefront(
+            kernel_globals, integrator_states, work_tile, num_pixels, samples_num);
+      });
+      return;
+    }
+
     parallel_for(int64_t(0), total_pixels_num, [&](int64_t work_index) {
       if (is_cancel_requested()) {
         return;
@@ -161,6 +232,112 @@ void PathTraceWorkCPU::render_samples_full_pipeline(KernelGlobalsCPU *kernel_glo
   }
 }
 
+void PathTraceWorkCPU::render_samples_wavefront(KernelGlobalsCPU *kernel_globals,
+                                                IntegratorStateCPU *integrator_states,
+                                                const KernelWorkTile &work_tile,
+                                                const int num_pixels,
+                                                const int samples_num)
+{
+  /* Guiding training keeps the segments of a single path per thread, see #render_samples. */
+  DCHECK(!kernel_globals->data.integrator.train_guiding);
+
+  const bool has_shadow_catcher = device_scene_->data.integrator.has_shadow_catcher;
+  /* The shadow catcher path is split off into the state following the main path state. */
+  const int state_stride = has_shadow_catcher ? 2 : 1;
+
+  KernelWorkTile pixel_work_tiles[WAVEFRONT_BATCH_SIZE];
+  bool pixel_active[WAVEFRONT_BATCH_SIZE];
+
+  for (int i = 0; i < num_pixels; ++i) {
+    pixel_work_tiles[i] = work_tile;
+    pixel_work_tiles[i].x += i;
+    pixel_active[i] = true;
+
+    if (has_shadow_catcher) {
+      path_state_init_queues(&integrator_states[i * state_stride + 1]);
+    }
+  }
+
+  float *render_buffer = buffers_->buffer.data();
+
+  IntegratorStateCPU *shade_states[WAVEFRONT_BATCH_SIZE * 2];
+
+  for (int sample = 0; sample < samples_num; ++sample) {
+    if (is_cancel_requested()) {
+      break;
+    }
+
+    /* Generate camera rays and intersect them as packets. Pixels which converged are not
+     * sampled anymore, same as in the full pipeline. */
+    IntegratorStateCPU *packet_states[INTEGRATOR_PACKET_SIZE_CPU];
+    int num_packet_states = 0;
+
+    for (int i = 0; i < num_pixels; ++i) {
+      if (pixel_active[i]) {
+        IntegratorStateCPU *state = &integrator_states[i * state_stride];
+        if (!kernels_.integrator_init_from_camera(
+                kernel_globals, state, &pixel_work_tiles[i], render_buffer)) {
+          pixel_active[i] = false;
+        }
+        /* Paths starting inside a volume first initialize the volume stack. */
+        else if (state->path.queued_kernel == DEVICE_KERNEL_INTEGRATOR_INTERSECT_CLOSEST) {
+          packet_states[num_packet_states++] = state;
+        }
+      }
+
+      if (num_packet_states == INTEGRATOR_PACKET_SIZE_CPU ||
+          (num_packet_states && i == num_pixels - 1)) {
+        kernels_.integrator_intersect_closest_packet(
+            kernel_globals, packet_states, num_packet_states, render_buffer);
+        num_packet_states = 0;
+      }
+    }
+
+    /* Advance all paths until they need surface shading, then shade surfaces of all paths
+     * sorted by shader so that the same shader is evaluated many times in a row. A shadow
+     * catcher path split off from the main path is picked up in the same round. */
+    while (true) {
+      int num_shade_states = 0;
+
+      for (int i = 0; i < num_pixels; ++i) {
+        if (!pixel_active[i]) {
+          continue;
+        }
+
+        for (int j = 0; j < state_stride; ++j) {
+          IntegratorStateCPU *state = &integrator_states[i * state_stride + j];
+          kernels_.integrator_megakernel_until_shade_surface(
+              kernel_globals, state, render_buffer);
+          if (state->path.queued_kernel == DEVICE_KERNEL_INTEGRATOR_SHADE_SURFACE) {
+            shade_states[num_shade_states++] = state;
+          }
+        }
+      }
+
+      if (num_shade_states == 0) {
+        break;
+      }
+
+      std::stable_sort(shade_states,
+                       shade_states + num_shade_states,
+                       [](const IntegratorStateCPU *a, const IntegratorStateCPU *b) {
+                         return a->path.shader_sort_key < b->path.shader_sort_key;
+                       });
+
+      for (int i = 0; i < num_shade_states; ++i) {
+        kernels_.integrator_shade_surface(kernel_globals, shade_states[i], render_buffer);
+      }
+    }
+
+    for (int i = 0; i < num_pixels; ++i) {
+      if (!pixel_active[i]) {
+        continue;
+      }
+      ++pixel_work_tiles[i].start_sample;
+    }
+  }
+}
+
 void PathTraceWorkCPU::copy_to_display(PathTraceDisplay *display,
                                        PassMode pass_mode,
                                        int num_samples)
@@ -73,6 +73,15 @@ class PathTraceWorkCPU : public PathTraceWork {
                                     const KernelWorkTile &work_tile,
                                     const int samples_num);
 
+  /* Wavefront variant of the path tracing routine, which renders a row of neighboring pixels
+   * starting at the given work tile. Camera rays are intersected together as packets, and
+   * surface shading of all paths is sorted by shader. */
+  void render_samples_wavefront(KernelGlobalsCPU *kernel_globals,
+                                IntegratorStateCPU *integrator_states,
+                                const KernelWorkTile &work_tile,
+                                const int num_pixels,
+                                const int samples_num);
+
   /* CPU kernels. */
   const CPUKernels &kernels_;
 
@@ -82,6 +91,11 @@ class PathTraceWorkCPU : public PathTraceWork {
    * accessing it, but some "localization" is required to decouple from kernel globals stored
    * on the device level. */
   vector<CPUKernelThreadGlobals> kernel_thread_globals_;
+
+  /* Per-thread integrator states of the wavefront mode, with room for the shadow catcher path
+   * next to the main path of each pixel. Allocated on first use, as they are too big to be kept
+   * on the stack. */
+  vector<vector<IntegratorStateCPU>> wavefront_integrator_states_;
 };
 
 CCL_NAMESPACE_END
@@ -100,6 +100,32 @@ ccl_device_intersect bool scene_intersect(KernelGlobals kg,
   return bvh_intersect(kg, ray, isect, visibility);
 }
 
+#  ifdef __KERNEL_CPU__
+/* Intersect a packet of rays, which is faster than individual scene_intersect calls when the
+ * rays are coherent and the ray-tracing backend supports packet traversal. */
+ccl_device_intersect void scene_intersect_packet(KernelGlobals kg,
+                                                 ccl_private const Ray *rays,
+                                                 ccl_private const uint *visibility,
+                                                 ccl_private Intersection *isects,
+                                                 ccl_private bool *hits,
+                                                 const int num_rays)
+{
+  kernel_assert(num_rays <= INTEGRATOR_PACKET_SIZE_CPU);
+
+#    ifdef __EMBREE__
+  if (kernel_data.device_bvh) {
+    kernel_embree_intersect_packet(kg, rays, visibility, isects, hits, num_rays);
+    return;
+  }
+#    endif
+
+  /* No packet traversal in BVH2, trace rays one by one. */
+  for (int i = 0; i < num_rays; i++) {
+    hits[i] = scene_intersect(kg, &rays[i], visibility[i], &isects[i]);
+  }
+}
+#  endif /* __KERNEL_CPU__ */
+
 /* Single object BVH traversal, for SSS/AO/bevel. */
 
 #  ifdef __BVH_LOCAL__
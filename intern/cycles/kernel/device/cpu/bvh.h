@@ -197,14 +197,51 @@ ccl_device_inline void kernel_embree_convert_sss_hit(
 
 /* Ray filter functions. */
 
+/* Intersection filter for ray packets, as traced by kernel_embree_intersect_packet. The Cycles
+ * ray of each lane is found through the ray ID. */
+ccl_device void kernel_embree_filter_intersection_packet(const RTCFilterFunctionNArguments *args,
+                                                         const bool backface_cull)
+{
+  const uint N = args->N;
+  RTCRayN *ray = args->ray;
+  CCLIntersectContext *ctx = ((IntersectContext *)args->context)->userRayExt;
+  const KernelGlobalsCPU *kg = ctx->kg;
+
+  for (uint i = 0; i < N; i++) {
+    if (args->valid[i] == 0) {
+      continue;
+    }
+
+    const RTCHit hit = rtcGetHitFromHitN(args->hit, N, i);
+
+    /* Always ignore back-facing intersections. */
+    if (backface_cull) {
+      const float3 dir = make_float3(
+          RTCRayN_dir_x(ray, N, i), RTCRayN_dir_y(ray, N, i), RTCRayN_dir_z(ray, N, i));
+      if (dot(dir, make_float3(hit.Ng_x, hit.Ng_y, hit.Ng_z)) > 0.0f) {
+        args->valid[i] = 0;
+        continue;
+      }
+    }
+
+    const Ray *cray = &ctx->ray[RTCRayN_id(ray, N, i)];
+    if (kernel_embree_is_self_intersection(kg, &hit, cray)) {
+      args->valid[i] = 0;
+    }
+  }
+}
+
 /* This gets called by Embree at every valid ray/object intersection.
  * Things like recording subsurface or shadow hits for later evaluation
  * as well as filtering for volume objects happen here.
  * Cycles' own BVH does that directly inside the traversal calls. */
 ccl_device void kernel_embree_filter_intersection_func(const RTCFilterFunctionNArguments *args)
 {
-  /* Current implementation in Cycles assumes only single-ray intersection queries. */
-  assert(args->N == 1);
+  /* Only regular intersection queries are traced as packets. */
+  if (args->N != 1) {
+    kernel_embree_filter_intersection_packet(args, false);
+    return;
+  }
 
   RTCHit *hit = (RTCHit *)args->hit;
   CCLIntersectContext *ctx = ((IntersectContext *)args->context)->userRayExt;
@@ -419,6 +456,11 @@ ccl_device void kernel_embree_filter_occluded_func(const RTCFilterFunctionNArgum
 
 ccl_device void kernel_embree_filter_func_backface_cull(const RTCFilterFunctionNArguments *args)
 {
+  if (args->N != 1) {
+    kernel_embree_filter_intersection_packet(args, true);
+    return;
+  }
+
   const RTCRay *ray = (RTCRay *)args->ray;
   RTCHit *hit = (RTCHit *)args->hit;
 
@@ -477,6 +519,67 @@ ccl_device_intersect bool kernel_embree_intersect(KernelGlobals kg,
   return true;
 }
 
+/* Intersect up to INTEGRATOR_PACKET_SIZE_CPU rays as a packet. Embree traverses the packet with
+ * SIMD instructions, which is faster than tracing the rays one by one when they are coherent,
+ * as is the case for camera rays of neighboring pixels. */
+ccl_device_intersect void kernel_embree_intersect_packet(KernelGlobals kg,
+                                                         ccl_private const Ray *rays,
+                                                         ccl_private const uint *visibility,
+                                                         ccl_private Intersection *isects,
+                                                         ccl_private bool *hits,
+                                                         const int num_rays)
+{
+  kernel_assert(num_rays <= 8);
+
+  CCLIntersectContext ctx(kg, CCLIntersectContext::RAY_REGULAR);
+  IntersectContext rtc_ctx(&ctx);
+  rtc_ctx.context.flags = RTC_INTERSECT_CONTEXT_FLAG_COHERENT;
+  /* Filter functions look up the ray of each lane through the ray ID. */
+  ctx.ray = rays;
+
+  ccl_align(32) int valid[8];
+  RTCRayHit8 ray_hit;
+  for (int i = 0; i < 8; i++) {
+    valid[i] = (i < num_rays && intersection_ray_valid(&rays[i])) ? -1 : 0;
+    if (!valid[i]) {
+      continue;
+    }
+
+    const Ray &ray = rays[i];
+    ray_hit.ray.org_x[i] = ray.P.x;
+    ray_hit.ray.org_y[i] = ray.P.y;
+    ray_hit.ray.org_z[i] = ray.P.z;
+    ray_hit.ray.dir_x[i] = ray.D.x;
+    ray_hit.ray.dir_y[i] = ray.D.y;
+    ray_hit.ray.dir_z[i] = ray.D.z;
+    ray_hit.ray.tnear[i] = ray.tmin;
+    ray_hit.ray.tfar[i] = ray.tmax;
+    ray_hit.ray.time[i] = ray.time;
+    ray_hit.ray.mask[i] = visibility[i];
+    ray_hit.ray.id[i] = i;
+    ray_hit.ray.flags[i] = 0;
+    ray_hit.hit.geomID[i] = RTC_INVALID_GEOMETRY_ID;
+    ray_hit.hit.instID[0][i] = RTC_INVALID_GEOMETRY_ID;
+  }
+
+  rtcIntersect8(valid, kernel_data.device_bvh, &rtc_ctx.context, &ray_hit);
+
+  for (int i = 0; i < num_rays; i++) {
+    isects[i].t = rays[i].tmax;
+    hits[i] = false;
+
+    if (!valid[i] || ray_hit.hit.geomID[i] == RTC_INVALID_GEOMETRY_ID ||
+        ray_hit.hit.primID[i] == RTC_INVALID_GEOMETRY_ID) {
+      continue;
+    }
+
+    const RTCRay lane_ray = rtcGetRayFromRayN((RTCRayN *)&ray_hit.ray, 8, i);
+    const RTCHit lane_hit = rtcGetHitFromHitN((RTCHitN *)&ray_hit.hit, 8, i);
+    kernel_embree_convert_hit(kg, &lane_ray, &lane_hit, &isects[i]);
+    hits[i] = true;
+  }
+}
+
 #ifdef __BVH_LOCAL__
 ccl_device_intersect bool kernel_embree_intersect_local(KernelGlobals kg,
                                                         ccl_private const Ray *ray,
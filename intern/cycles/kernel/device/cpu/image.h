@@ -824,6 +824,10 @@ ccl_device float4 kernel_tex_image_interp(KernelGlobals kg, int id, float x, flo
       return TextureInterpolator<ushort4>::interp(info, x, y);
     case IMAGE_DATA_TYPE_FLOAT4:
       return TextureInterpolator<float4>::interp(info, x, y);
+    case IMAGE_DATA_TYPE_TEXTURE_CACHE: {
+      const TextureCacheImageHandle *handle = (const TextureCacheImageHandle *)info.data;
+      return handle->lookup(handle->image, x, y, zero_float2(), zero_float2());
+    }
     default:
       assert(0);
       return make_float4(
@@ -831,6 +835,21 @@ ccl_device float4 kernel_tex_image_interp(KernelGlobals kg, int id, float x, flo
   }
 }
 
+/* Lookup with texture coordinate derivatives, used to filter images from the texture cache
+ * at the matching MIP level. Fully loaded images have no MIP levels and ignore them. */
+ccl_device float4 kernel_tex_image_interp_filtered(
+    KernelGlobals kg, int id, float x, float y, float2 dx, float2 dy)
+{
+  const TextureInfo &info = kernel_data_fetch(texture_info, id);
+
+  if (info.data_type == IMAGE_DATA_TYPE_TEXTURE_CACHE && info.data) {
+    const TextureCacheImageHandle *handle = (const TextureCacheImageHandle *)info.data;
+    return handle->lookup(handle->image, x, y, dx, dy);
+  }
+
+  return kernel_tex_image_interp(kg, id, x, y);
+}
+
 ccl_device float4 kernel_tex_image_interp_3d(KernelGlobals kg,
                                              int id,
                                              float3 P,
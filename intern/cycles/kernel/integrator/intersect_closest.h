@@ -318,48 +318,57 @@ ccl_device_forceinline void integrator_intersect_next_kernel_after_volume(
   }
 }
 
-ccl_device void integrator_intersect_closest(KernelGlobals kg,
-                                             IntegratorState state,
-                                             ccl_global float *ccl_restrict render_buffer)
+/* Read ray from the integrator state and setup the self intersection primitives and AO
+ * distance for scene intersection. Returns the ray visibility. */
+ccl_device_forceinline uint integrator_intersect_closest_setup_ray(KernelGlobals kg,
+                                                                   IntegratorState state,
+                                                                   ccl_private Ray *ray)
 {
-  PROFILING_INIT(kg, PROFILING_INTERSECT_CLOSEST);
-
   /* Read ray from integrator state into local memory. */
-  Ray ray ccl_optional_struct_init;
-  integrator_state_read_ray(kg, state, &ray);
-  kernel_assert(ray.tmax != 0.0f);
+  integrator_state_read_ray(kg, state, ray);
+  kernel_assert(ray->tmax != 0.0f);
 
-  const uint visibility = path_state_ray_visibility(state);
   const int last_isect_prim = INTEGRATOR_STATE(state, isect, prim);
   const int last_isect_object = INTEGRATOR_STATE(state, isect, object);
 
   /* Trick to use short AO rays to approximate indirect light at the end of the path. */
   if (path_state_ao_bounce(kg, state)) {
-    ray.tmax = kernel_data.integrator.ao_bounces_distance;
+    ray->tmax = kernel_data.integrator.ao_bounces_distance;
 
     if (last_isect_object != OBJECT_NONE) {
       const float object_ao_distance = kernel_data_fetch(objects, last_isect_object).ao_distance;
       if (object_ao_distance != 0.0f) {
-        ray.tmax = object_ao_distance;
+        ray->tmax = object_ao_distance;
       }
     }
   }
 
-  /* Scene Intersection. */
-  Intersection isect ccl_optional_struct_init;
-  isect.object = OBJECT_NONE;
-  isect.prim = PRIM_NONE;
-  ray.self.object = last_isect_object;
-  ray.self.prim = last_isect_prim;
-  ray.self.light_object = OBJECT_NONE;
-  ray.self.light_prim = PRIM_NONE;
-  bool hit = scene_intersect(kg, &ray, visibility, &isect);
+  ray->self.object = last_isect_object;
+  ray->self.prim = last_isect_prim;
+  ray->self.light_object = OBJECT_NONE;
+  ray->self.light_prim = PRIM_NONE;
+
+  return path_state_ray_visibility(state);
+}
 
+/* Handle the scene intersection result and setup the next kernel to be executed. */
+ccl_device_forceinline void integrator_intersect_closest_finish(
+    KernelGlobals kg,
+    IntegratorState state,
+    ccl_private const Ray *ccl_restrict ray,
+    ccl_private Intersection *ccl_restrict isect,
+    bool hit,
+    ccl_global float *ccl_restrict render_buffer)
+{
   /* TODO: remove this and do it in the various intersection functions instead. */
   if (!hit) {
-    isect.prim = PRIM_NONE;
+    isect->prim = PRIM_NONE;
   }
 
+  /* Not yet overwritten by the new intersection. */
+  const int last_isect_prim = INTEGRATOR_STATE(state, isect, prim);
+  const int last_isect_object = INTEGRATOR_STATE(state, isect, object);
+
   /* Setup mnee flag to signal last intersection with a caster */
   const uint32_t path_flag = INTEGRATOR_STATE(state, path, flag);
 
@@ -392,16 +401,64 @@ ccl_device void integrator_intersect_closest(KernelGlobals kg,
      * these in the path_state_init. */
     const int last_type = INTEGRATOR_STATE(state, isect, type);
     hit = lights_intersect(
-              kg, state, &ray, &isect, last_isect_prim, last_isect_object, last_type, path_flag) ||
+              kg, state, ray, isect, last_isect_prim, last_isect_object, last_type, path_flag) ||
           hit;
   }
 
   /* Write intersection result into global integrator state memory. */
-  integrator_state_write_isect(kg, state, &isect);
+  integrator_state_write_isect(kg, state, isect);
 
   /* Setup up next kernel to be executed. */
   integrator_intersect_next_kernel<DEVICE_KERNEL_INTEGRATOR_INTERSECT_CLOSEST>(
-      kg, state, &isect, render_buffer, hit);
+      kg, state, isect, render_buffer, hit);
+}
+
+ccl_device void integrator_intersect_closest(KernelGlobals kg,
+                                             IntegratorState state,
+                                             ccl_global float *ccl_restrict render_buffer)
+{
+  PROFILING_INIT(kg, PROFILING_INTERSECT_CLOSEST);
+
+  Ray ray ccl_optional_struct_init;
+  const uint visibility = integrator_intersect_closest_setup_ray(kg, state, &ray);
+
+  /* Scene Intersection. */
+  Intersection isect ccl_optional_struct_init;
+  isect.object = OBJECT_NONE;
+  isect.prim = PRIM_NONE;
+  const bool hit = scene_intersect(kg, &ray, visibility, &isect);
+
+  integrator_intersect_closest_finish(kg, state, &ray, &isect, hit, render_buffer);
+}
+
+#ifdef __KERNEL_CPU__
+/* Intersect closest for a packet of path states, all queued for this kernel. Used by the CPU
+ * wavefront mode to trace coherent rays of neighboring pixels together. */
+ccl_device void integrator_intersect_closest_packet(KernelGlobals kg,
+                                                    ccl_private IntegratorState *states,
+                                                    const int num_states,
+                                                    ccl_global float *ccl_restrict render_buffer)
+{
+  PROFILING_INIT(kg, PROFILING_INTERSECT_CLOSEST);
+
+  Ray rays[INTEGRATOR_PACKET_SIZE_CPU];
+  uint visibility[INTEGRATOR_PACKET_SIZE_CPU];
+  Intersection isects[INTEGRATOR_PACKET_SIZE_CPU];
+  bool hits[INTEGRATOR_PACKET_SIZE_CPU];
+
+  for (int i = 0; i < num_states; i++) {
+    visibility[i] = integrator_intersect_closest_setup_ray(kg, states[i], &rays[i]);
+    isects[i].object = OBJECT_NONE;
+    isects[i].prim = PRIM_NONE;
+  }
+
+  scene_intersect_packet(kg, rays, visibility, isects, hits, num_states);
+
+  for (int i = 0; i < num_states; i++) {
+    integrator_intersect_closest_finish(
+        kg, states[i], &rays[i], &isects[i], hits[i], render_buffer);
+  }
 }
+#endif /* __KERNEL_CPU__ */
 
 CCL_NAMESPACE_END
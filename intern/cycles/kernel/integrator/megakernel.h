@@ -16,9 +16,13 @@
 
 CCL_NAMESPACE_BEGIN
 
-ccl_device void integrator_megakernel(KernelGlobals kg,
-                                      IntegratorState state,
-                                      ccl_global float *ccl_restrict render_buffer)
+/* Execute kernels of the path until it terminates, or until the main path is queued for the
+ * given kernel with no pending shadow paths. A stop kernel of zero runs the path to the end. */
+ccl_device_forceinline void integrator_megakernel_until(
+    KernelGlobals kg,
+    IntegratorState state,
+    ccl_global float *ccl_restrict render_buffer,
+    const uint32_t stop_kernel)
 {
   /* Each kernel indicates the next kernel to execute, so here we simply
    * have to check what that kernel is and execute it. */
@@ -61,6 +65,10 @@ ccl_device void integrator_megakernel(KernelGlobals kg,
     /* Then handle regular path kernels. */
     const uint32_t queued_kernel = INTEGRATOR_STATE(state, path, queued_kernel);
     if (queued_kernel) {
+      if (queued_kernel == stop_kernel) {
+        break;
+      }
+
       switch (queued_kernel) {
         case DEVICE_KERNEL_INTEGRATOR_INTERSECT_CLOSEST:
           integrator_intersect_closest(kg, state, render_buffer);
@@ -100,4 +108,20 @@ ccl_device void integrator_megakernel(KernelGlobals kg,
   }
 }
 
+ccl_device void integrator_megakernel(KernelGlobals kg,
+                                      IntegratorState state,
+                                      ccl_global float *ccl_restrict render_buffer)
+{
+  integrator_megakernel_until(kg, state, render_buffer, 0);
+}
+
+#ifdef __KERNEL_CPU__
+/* Used by the CPU wavefront mode to sort surface shading of multiple paths by shader. */
+ccl_device void integrator_megakernel_until_shade_surface(
+    KernelGlobals kg, IntegratorState state, ccl_global float *ccl_restrict render_buffer)
+{
+  integrator_megakernel_until(kg, state, render_buffer, DEVICE_KERNEL_INTEGRATOR_SHADE_SURFACE);
+}
+#endif
+
 CCL_NAMESPACE_END
@@ -5,14 +5,19 @@
 
 CCL_NAMESPACE_BEGIN
 
-ccl_device float4 svm_image_texture(KernelGlobals kg, int id, float x, float y, uint flags)
+ccl_device float4 svm_image_texture_filtered(
+    KernelGlobals kg, int id, float x, float y, float2 dx, float2 dy, uint flags)
 {
   if (id == -1) {
     return make_float4(
         TEX_IMAGE_MISSING_R, TEX_IMAGE_MISSING_G, TEX_IMAGE_MISSING_B, TEX_IMAGE_MISSING_A);
   }
 
+#ifdef __KERNEL_CPU__
+  float4 r = kernel_tex_image_interp_filtered(kg, id, x, y, dx, dy);
+#else
   float4 r = kernel_tex_image_interp(kg, id, x, y);
+#endif
   const float alpha = r.w;
 
   if ((flags & NODE_IMAGE_ALPHA_UNASSOCIATE) && alpha != 1.0f && alpha != 0.0f) {
@@ -27,6 +32,11 @@ ccl_device float4 svm_image_texture(KernelGlobals kg, int id, float x, float y,
   return r;
 }
 
+ccl_device float4 svm_image_texture(KernelGlobals kg, int id, float x, float y, uint flags)
+{
+  return svm_image_texture_filtered(kg, id, x, y, zero_float2(), zero_float2(), flags);
+}
+
 /* Remap coordinate from 0..1 box to -1..-1 */
 ccl_device_inline float3 texco_remap_square(float3 co)
 {
@@ -97,7 +107,21 @@ ccl_device_noinline int svm_node_tex_image(
     id = -num_nodes;
   }
 
-  float4 f = svm_image_texture(kg, id, tex_co.x, tex_co.y, flags);
+  /* Differentials of the UV map select the MIP level for images in the texture cache. Other
+   * texture coordinates are not differentiated and use the full resolution. */
+  float2 tex_co_dx = zero_float2();
+  float2 tex_co_dy = zero_float2();
+#ifdef __KERNEL_CPU__
+  if (flags & NODE_IMAGE_UV_DIFFERENTIALS) {
+    const AttributeDescriptor desc = find_attribute(kg, sd, ATTR_STD_UV);
+    if (desc.offset != ATTR_STD_NOT_FOUND) {
+      primitive_surface_attribute_float2(kg, sd, desc, &tex_co_dx, &tex_co_dy);
+    }
+  }
+#endif
+
+  float4 f = svm_image_texture_filtered(
+      kg, id, tex_co.x, tex_co.y, tex_co_dx, tex_co_dy, flags);
 
   if (stack_valid(out_offset))
     stack_store_float3(stack, out_offset, make_float3(f.x, f.y, f.z));
@@ -23,6 +23,34 @@ ccl_device_noinline void svm_node_math(KernelGlobals kg,
   stack_store_float(stack, result_stack_offset, result);
 }
 
+/* Math node specialized for one of the most common operations, avoiding the dispatch on the
+ * operation type. The first operand is always loaded from the stack, the others may be constants
+ * stored in the node. */
+template<NodeMathType type>
+ccl_device_inline void svm_node_math_specialized(ccl_private float *stack, uint4 node)
+{
+  uint a_stack_offset, b_stack_offset, c_stack_offset, result_stack_offset;
+  svm_unpack_node_uchar4(
+      node.y, &a_stack_offset, &b_stack_offset, &c_stack_offset, &result_stack_offset);
+
+  const float a = stack_load_float(stack, a_stack_offset);
+  const float b = stack_load_float_default(stack, b_stack_offset, node.z);
+
+  float result;
+  if (type == NODE_MATH_MULTIPLY_ADD) {
+    const float c = stack_load_float_default(stack, c_stack_offset, node.w);
+    result = a * b + c;
+  }
+  else if (type == NODE_MATH_MULTIPLY) {
+    result = a * b;
+  }
+  else {
+    result = a + b;
+  }
+
+  stack_store_float(stack, result_stack_offset, result);
+}
+
 ccl_device_noinline int svm_node_vector_math(KernelGlobals kg,
                                              ccl_private ShaderData *sd,
                                              ccl_private float *stack,
@@ -52,6 +52,31 @@ ccl_device_noinline void svm_node_mix_color(ccl_private ShaderData *sd,
   stack_store_float3(stack, result_offset, result);
 }
 
+/* Mix color node with the Mix blend type, which is a plain interpolation. */
+ccl_device_inline void svm_node_mix_color_blend(ccl_private float *stack,
+                                                uint options,
+                                                uint input_offset,
+                                                uint result_offset)
+{
+  uint use_clamp, blend_type, use_clamp_result;
+  uint fac_in_stack_offset, a_in_stack_offset, b_in_stack_offset;
+  svm_unpack_node_uchar3(options, &use_clamp, &blend_type, &use_clamp_result);
+  svm_unpack_node_uchar3(
+      input_offset, &fac_in_stack_offset, &a_in_stack_offset, &b_in_stack_offset);
+
+  float t = stack_load_float(stack, fac_in_stack_offset);
+  if (use_clamp > 0) {
+    t = saturatef(t);
+  }
+  float3 a = stack_load_float3(stack, a_in_stack_offset);
+  float3 b = stack_load_float3(stack, b_in_stack_offset);
+  float3 result = svm_mix_blend(t, a, b);
+  if (use_clamp_result) {
+    result = saturate(result);
+  }
+  stack_store_float3(stack, result_offset, result);
+}
+
 ccl_device_noinline void svm_node_mix_float(ccl_private ShaderData *sd,
                                             ccl_private float *stack,
                                             uint use_clamp,
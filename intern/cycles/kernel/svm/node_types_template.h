@@ -107,6 +107,10 @@ SHADER_NODE_TYPE(NODE_MIX_COLOR)
 SHADER_NODE_TYPE(NODE_MIX_FLOAT)
 SHADER_NODE_TYPE(NODE_MIX_VECTOR)
 SHADER_NODE_TYPE(NODE_MIX_VECTOR_NON_UNIFORM)
+SHADER_NODE_TYPE(NODE_MATH_ADD_F)
+SHADER_NODE_TYPE(NODE_MATH_MULTIPLY_F)
+SHADER_NODE_TYPE(NODE_MATH_MULTIPLY_ADD_F)
+SHADER_NODE_TYPE(NODE_MIX_COLOR_BLEND)
 
 /* Padding for struct alignment. */
 SHADER_NODE_TYPE(NODE_PAD1)
@@ -597,6 +597,18 @@ ccl_device void svm_eval_nodes(KernelGlobals kg,
       SVM_CASE(NODE_MIX_VECTOR_NON_UNIFORM)
       svm_node_mix_vector_non_uniform(sd, stack, node.y, node.z);
       break;
+      SVM_CASE(NODE_MATH_ADD_F)
+      svm_node_math_specialized<NODE_MATH_ADD>(stack, node);
+      break;
+      SVM_CASE(NODE_MATH_MULTIPLY_F)
+      svm_node_math_specialized<NODE_MATH_MULTIPLY>(stack, node);
+      break;
+      SVM_CASE(NODE_MATH_MULTIPLY_ADD_F)
+      svm_node_math_specialized<NODE_MATH_MULTIPLY_ADD>(stack, node);
+      break;
+      SVM_CASE(NODE_MIX_COLOR_BLEND)
+      svm_node_mix_color_blend(stack, node.y, node.z, node.w);
+      break;
       default:
         kernel_assert(!"Unknown node type was passed to the SVM machine");
         return;
@@ -51,6 +51,9 @@ CCL_NAMESPACE_BEGIN
 #  define INTEGRATOR_SHADOW_ISECT_SIZE INTEGRATOR_SHADOW_ISECT_SIZE_CPU
 #endif
 
+/* Number of rays traced together as a packet in the CPU wavefront mode. */
+#define INTEGRATOR_PACKET_SIZE_CPU 8
+
 /* Kernel features */
 #define __AO__
 #define __CAUSTICS_TRICKS__
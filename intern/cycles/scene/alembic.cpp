@@ -1214,6 +1214,8 @@ void AlembicProcedural::read_curves(AlembicObject *abc_object, Abc::chrono_t fra
     hair->tag_curve_shader_modified();
   }
 
+  const size_t old_num_keys = hair->get_curve_keys().size();
+
   cached_data.curve_keys.copy_to_socket(frame_time, hair, hair->get_curve_keys_socket());
 
   cached_data.curve_radius.copy_to_socket(frame_time, hair, hair->get_curve_radius_socket());
@@ -1226,7 +1228,9 @@ void AlembicProcedural::read_curves(AlembicObject *abc_object, Abc::chrono_t fra
 
   update_attributes(hair->attributes, cached_data, frame_time);
 
-  const bool rebuild = (hair->curve_keys_is_modified() || hair->curve_radius_is_modified());
+  /* Deformed curves only need a BVH refit, rebuild when the curve topology changes. */
+  const bool rebuild = (hair->curve_first_key_is_modified() ||
+                        hair->get_curve_keys().size() != old_num_keys);
   hair->tag_update(scene_, rebuild);
 }
 
@@ -1255,6 +1259,8 @@ void AlembicProcedural::read_points(AlembicObject *abc_object, Abc::chrono_t fra
     point_cloud->tag_shader_modified();
   }
 
+  const size_t old_num_points = point_cloud->num_points();
+
   cached_data.points.copy_to_socket(frame_time, point_cloud, point_cloud->get_points_socket());
   cached_data.radiuses.copy_to_socket(frame_time, point_cloud, point_cloud->get_radius_socket());
   cached_data.points_shader.copy_to_socket(
@@ -1264,7 +1270,8 @@ void AlembicProcedural::read_points(AlembicObject *abc_object, Abc::chrono_t fra
 
   update_attributes(point_cloud->attributes, cached_data, frame_time);
 
-  const bool rebuild = (point_cloud->points_is_modified() || point_cloud->radius_is_modified() ||
+  /* Moving points only need a BVH refit, rebuild when the number of points changes. */
+  const bool rebuild = (point_cloud->num_points() != old_num_points ||
                         point_cloud->shader_is_modified());
   point_cloud->tag_update(scene_, rebuild);
 }
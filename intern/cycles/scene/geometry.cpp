@@ -1250,21 +1250,42 @@ void GeometryManager::device_update_bvh(Device *device,
 
   VLOG_INFO << "Using " << bvh_layout_name(bparams.bvh_layout) << " layout.";
 
-  const bool can_refit = scene->bvh != nullptr &&
-                         (bparams.bvh_layout == BVHLayout::BVH_LAYOUT_OPTIX ||
-                          bparams.bvh_layout == BVHLayout::BVH_LAYOUT_METAL);
+  /* The scene BVH is freed when geometry is added, removed or changes topology, so an existing
+   * BVH can be refit when only transforms, vertex positions or visibility changed. BVH2 and
+   * Embree additionally require the same objects to be instanced as in the last build. */
+  bool can_refit = false;
+  if (scene->bvh != nullptr) {
+    switch (bparams.bvh_layout) {
+      case BVHLayout::BVH_LAYOUT_OPTIX:
+      case BVHLayout::BVH_LAYOUT_METAL:
+        can_refit = true;
+        break;
+      case BVHLayout::BVH_LAYOUT_BVH2:
+      case BVHLayout::BVH_LAYOUT_EMBREE:
+        can_refit = scene->bvh->can_refit_objects(scene->objects);
+        break;
+      default:
+        break;
+    }
+  }
 
   BVH *bvh = scene->bvh;
   if (!scene->bvh) {
     bvh = scene->bvh = BVH::create(bparams, scene->geometry, scene->objects, device);
   }
 
+  VLOG_INFO << (can_refit ? "Refitting" : "Building") << " scene BVH.";
+
   device->build_bvh(bvh, progress, can_refit);
 
   if (progress.get_cancel()) {
     return;
   }
 
+  if (!can_refit) {
+    bvh->store_object_layout();
+  }
+
   const bool has_bvh2_layout = (bparams.bvh_layout == BVH_LAYOUT_BVH2);
 
   PackedBVH pack;
@@ -4,6 +4,7 @@
 #include "scene/image.h"
 #include "device/device.h"
 #include "scene/colorspace.h"
+#include "scene/image_cache.h"
 #include "scene/image_oiio.h"
 #include "scene/image_vdb.h"
 #include "scene/scene.h"
@@ -68,6 +69,8 @@ const char *name_from_type(ImageDataType type)
       return "nanovdb_fpn";
     case IMAGE_DATA_TYPE_NANOVDB_FP16:
       return "nanovdb_fp16";
+    case IMAGE_DATA_TYPE_TEXTURE_CACHE:
+      return "texture_cache";
     case IMAGE_DATA_NUM_TYPES:
       assert(!"System enumerator type, should never be used");
       return "";
@@ -488,6 +491,7 @@ int ImageManager::add_image_slot(ImageLoader *loader,
   img->builtin = builtin;
   img->users = 1;
   img->mem = NULL;
+  img->cache_image = NULL;
 
   images[slot] = img;
 
@@ -686,6 +690,71 @@ bool ImageManager::file_load_image(Image *img, int texture_limit)
   return true;
 }
 
+bool ImageManager::texture_cache_load_image(Device *device, Scene *scene, int slot)
+{
+  Image *img = images[slot];
+
+  /* Only CPU devices can read from the texture cache while rendering. */
+  const int texture_cache_size = scene->params.texture_cache_size;
+  if (texture_cache_size <= 0 || device->info.type != DEVICE_CPU) {
+    return false;
+  }
+
+  /* Only 2D images read from files. */
+  const ustring filepath = img->loader->osl_filepath();
+  if (filepath.empty() || img->metadata.depth > 1 || !(img->metadata.channels > 0)) {
+    return false;
+  }
+
+  /* The texture system always associates alpha, load images that need the original RGB
+   * channels in full. */
+  const bool has_alpha = (img->metadata.channels == 2 || img->metadata.channels == 4);
+  if (has_alpha && !image_associate_alpha(img)) {
+    return false;
+  }
+
+  TextureCache *cache;
+  {
+    thread_scoped_lock cache_lock(texture_cache_mutex);
+    if (!texture_cache) {
+      VLOG_INFO << "Creating texture cache of " << texture_cache_size << " MB.";
+      texture_cache = make_unique<TextureCache>(texture_cache_size);
+    }
+    else {
+      texture_cache->set_max_memory(texture_cache_size);
+    }
+    cache = texture_cache.get();
+  }
+
+  /* sRGB is converted in the kernel, like for fully loaded images. */
+  const ustring colorspace = img->metadata.colorspace;
+  ColorSpaceProcessor *processor = (colorspace == u_colorspace_raw ||
+                                    colorspace == u_colorspace_srgb) ?
+                                       NULL :
+                                       ColorSpaceManager::get_processor(colorspace);
+
+  img->cache_image = cache->add_image(
+      filepath, img->params.interpolation, img->params.extension, processor);
+  if (img->cache_image == NULL) {
+    return false;
+  }
+
+  /* The texture only contains the handle for the kernel lookup, pixels stay in the cache. */
+  thread_scoped_lock device_lock(device_mutex);
+  img->mem = new device_texture(device,
+                                img->mem_name.c_str(),
+                                slot,
+                                IMAGE_DATA_TYPE_TEXTURE_CACHE,
+                                img->params.interpolation,
+                                img->params.extension);
+  TextureCacheImageHandle *handle = (TextureCacheImageHandle *)img->mem->alloc(
+      sizeof(TextureCacheImageHandle), 0);
+  TextureCache::kernel_handle(img->cache_image, handle);
+  img->mem->copy_to_device();
+
+  return true;
+}
+
 void ImageManager::device_load_image(Device *device, Scene *scene, int slot, Progress *progress)
 {
   if (progress->get_cancel()) {
@@ -710,6 +779,17 @@ void ImageManager::device_load_image(Device *device, Scene *scene, int slot, Pro
     delete img->mem;
     img->mem = NULL;
   }
+  if (img->cache_image) {
+    texture_cache->remove_image(img->cache_image);
+    img->cache_image = NULL;
+  }
+
+  /* Stream file images through the texture cache instead of loading all pixels. */
+  if (texture_cache_load_image(device, scene, slot)) {
+    img->loader->cleanup();
+    img->need_load = false;
+    return;
+  }
 
   img->mem = new device_texture(
       device, img->mem_name.c_str(), slot, type, img->params.interpolation, img->params.extension);
@@ -843,6 +923,9 @@ void ImageManager::device_free_image(Device *, int slot)
     thread_scoped_lock device_lock(device_mutex);
     delete img->mem;
   }
+  if (img->cache_image) {
+    texture_cache->remove_image(img->cache_image);
+  }
 
   delete img->loader;
   delete img;
@@ -939,6 +1022,10 @@ void ImageManager::collect_statistics(RenderStats *stats)
     stats->image.textures.add_entry(
         NamedSizeEntry(image->loader->name(), image->mem->memory_size()));
   }
+  if (texture_cache) {
+    stats->image.textures.add_entry(
+        NamedSizeEntry("Texture Cache", texture_cache->memory_usage()));
+  }
 }
 
 void ImageManager::tag_update()
@@ -26,6 +26,8 @@ class Progress;
 class RenderStats;
 class Scene;
 class ColorSpaceProcessor;
+class TextureCache;
+class TextureCacheImage;
 class VDBImageLoader;
 
 /* Image Parameters */
@@ -206,6 +208,7 @@ class ImageManager {
 
     string mem_name;
     device_texture *mem;
+    TextureCacheImage *cache_image;
 
     int users;
     thread_mutex mutex;
@@ -223,6 +226,9 @@ class ImageManager {
   vector<Image *> images;
   void *osl_texture_system;
 
+  unique_ptr<TextureCache> texture_cache;
+  thread_mutex texture_cache_mutex;
+
   int add_image_slot(ImageLoader *loader, const ImageParams &params, const bool builtin);
   void add_image_user(int slot);
   void remove_image_user(int slot);
@@ -232,6 +238,8 @@ class ImageManager {
   template<TypeDesc::BASETYPE FileFormat, typename StorageType>
   bool file_load_image(Image *img, int texture_limit);
 
+  bool texture_cache_load_image(Device *device, Scene *scene, int slot);
+
   void device_load_image(Device *device, Scene *scene, int slot, Progress *progress);
   void device_free_image(Device *device, int slot);
 
@@ -0,0 +1,172 @@
+/* SPDX-License-Identifier: Apache-2.0
+ * Copyright 2011-2022 Blender Foundation */
+
+#include "scene/image_cache.h"
+#include "scene/colorspace.h"
+
+#include "util/image.h"
+#include "util/log.h"
+
+#include <OpenImageIO/texture.h>
+
+CCL_NAMESPACE_BEGIN
+
+/* Image opened through the texture cache, referenced by the kernel texture info. */
+class TextureCacheImage {
+ public:
+  TextureSystem *texture_system;
+  TextureSystem::TextureHandle *handle;
+  TextureOpt options;
+  ColorSpaceProcessor *processor;
+};
+
+static TextureOpt::Wrap texture_cache_wrap(const ExtensionType extension)
+{
+  switch (extension) {
+    case EXTENSION_REPEAT:
+      return TextureOpt::WrapPeriodic;
+    case EXTENSION_EXTEND:
+      return TextureOpt::WrapClamp;
+    case EXTENSION_MIRROR:
+      return TextureOpt::WrapMirror;
+    case EXTENSION_CLIP:
+    case EXTENSION_NUM_TYPES:
+      break;
+  }
+  return TextureOpt::WrapBlack;
+}
+
+static TextureOpt::InterpMode texture_cache_interp(const InterpolationType interpolation)
+{
+  switch (interpolation) {
+    case INTERPOLATION_CLOSEST:
+      return TextureOpt::InterpClosest;
+    case INTERPOLATION_CUBIC:
+      return TextureOpt::InterpBicubic;
+    case INTERPOLATION_SMART:
+      return TextureOpt::InterpSmartBicubic;
+    case INTERPOLATION_NONE:
+    case INTERPOLATION_LINEAR:
+    case INTERPOLATION_NUM_TYPES:
+      break;
+  }
+  return TextureOpt::InterpBilinear;
+}
+
+static float4 texture_cache_lookup(const void *data, float x, float y, float2 dx, float2 dy)
+{
+  const TextureCacheImage *image = (const TextureCacheImage *)data;
+  TextureSystem *ts = image->texture_system;
+  TextureSystem::Perthread *thread_info = ts->get_perthread_info();
+
+  /* Cycles images are stored bottom to top, the texture system addresses them top to bottom.
+   * Options are modified by the lookup, so use a copy. */
+  TextureOpt options = image->options;
+  float result[4];
+  if (!ts->texture(image->handle,
+                   thread_info,
+                   options,
+                   x,
+                   1.0f - y,
+                   dx.x,
+                   -dx.y,
+                   dy.x,
+                   -dy.y,
+                   4,
+                   result)) {
+    /* Clear error so messages don't accumulate. */
+    ts->geterror();
+    return make_float4(
+        TEX_IMAGE_MISSING_R, TEX_IMAGE_MISSING_G, TEX_IMAGE_MISSING_B, TEX_IMAGE_MISSING_A);
+  }
+
+  if (image->processor) {
+    ColorSpaceManager::to_scene_linear(image->processor, result, 4);
+  }
+
+  return make_float4(result[0], result[1], result[2], result[3]);
+}
+
+TextureCache::TextureCache(const int max_memory_mb)
+{
+  /* Not shared with the OSL texture system, so that the memory budget only applies to images
+   * used by SVM. */
+  TextureSystem *ts = TextureSystem::create(false);
+  ts->attribute("automip", 1);
+  ts->attribute("autotile", 64);
+  ts->attribute("gray_to_rgb", 1);
+  ts->attribute("max_memory_MB", (float)max_memory_mb);
+  texture_system = ts;
+}
+
+TextureCache::~TextureCache()
+{
+  TextureSystem *ts = (TextureSystem *)texture_system;
+  ts->invalidate_all(true);
+  TextureSystem::destroy(ts);
+}
+
+void TextureCache::set_max_memory(const int max_memory_mb)
+{
+  TextureSystem *ts = (TextureSystem *)texture_system;
+  ts->attribute("max_memory_MB", (float)max_memory_mb);
+}
+
+TextureCacheImage *TextureCache::add_image(ustring filepath,
+                                           InterpolationType interpolation,
+                                           ExtensionType extension,
+                                           ColorSpaceProcessor *processor)
+{
+  TextureSystem *ts = (TextureSystem *)texture_system;
+
+  thread_scoped_lock lock(mutex);
+  TextureSystem::TextureHandle *handle = ts->get_texture_handle(filepath);
+  if (handle == NULL || !ts->good(handle)) {
+    VLOG_WARNING << "Texture cache can't read '" << filepath.string()
+                 << "': " << ts->geterror();
+    return NULL;
+  }
+
+  TextureCacheImage *image = new TextureCacheImage();
+  image->texture_system = ts;
+  image->handle = handle;
+  image->options.swrap = texture_cache_wrap(extension);
+  image->options.twrap = image->options.swrap;
+  image->options.interpmode = texture_cache_interp(interpolation);
+  /* Images without alpha channel are opaque. */
+  image->options.fill = 1.0f;
+  image->processor = processor;
+
+  VLOG_WORK << "Texture cache added '" << filepath.string() << "'";
+
+  return image;
+}
+
+void TextureCache::remove_image(TextureCacheImage *image)
+{
+  /* Cached tiles of the file are kept, they are evicted when running out of memory or reused
+   * when the same file is added again. */
+  delete image;
+}
+
+void TextureCache::kernel_handle(const TextureCacheImage *image, TextureCacheImageHandle *handle)
+{
+  handle->image = image;
+  handle->lookup = texture_cache_lookup;
+}
+
+size_t TextureCache::memory_usage() const
+{
+  TextureSystem *ts = (TextureSystem *)texture_system;
+  int64_t memory = 0;
+  ts->getattribute("stat:cache_memory_used", TypeDesc::INT64, &memory);
+  return (size_t)memory;
+}
+
+string TextureCache::full_report() const
+{
+  TextureSystem *ts = (TextureSystem *)texture_system;
+  return ts->getstats(1);
+}
+
+CCL_NAMESPACE_END
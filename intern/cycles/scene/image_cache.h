@@ -0,0 +1,55 @@
+/* SPDX-License-Identifier: Apache-2.0
+ * Copyright 2011-2022 Blender Foundation */
+
+#ifndef __IMAGE_CACHE_H__
+#define __IMAGE_CACHE_H__
+
+#include "util/param.h"
+#include "util/string.h"
+#include "util/texture.h"
+#include "util/thread.h"
+
+CCL_NAMESPACE_BEGIN
+
+class ColorSpaceProcessor;
+class TextureCacheImage;
+
+/* Texture Cache
+ *
+ * Streams 2D image files from disk for CPU rendering instead of loading them fully into memory.
+ * Images are split into tiles and MIP levels that are loaded on demand, and the least recently
+ * used tiles are evicted to stay within a fixed memory budget. Implemented on top of the
+ * OpenImageIO texture system, which also builds tiles and MIP levels for files that were not
+ * prepared with maketx. */
+class TextureCache {
+ public:
+  explicit TextureCache(const int max_memory_mb);
+  ~TextureCache();
+
+  void set_max_memory(const int max_memory_mb);
+
+  /* Open image file for lookups through the cache. Returns NULL if the file can not be read by
+   * the texture system, in which case the image should be loaded in full instead. Alpha of
+   * RGBA images is always associated by the texture system. */
+  TextureCacheImage *add_image(ustring filepath,
+                               InterpolationType interpolation,
+                               ExtensionType extension,
+                               ColorSpaceProcessor *processor);
+  void remove_image(TextureCacheImage *image);
+
+  /* Fill kernel handle used by the CPU image lookup. */
+  static void kernel_handle(const TextureCacheImage *image, TextureCacheImageHandle *handle);
+
+  /* Memory used by cached tiles. */
+  size_t memory_usage() const;
+  /* Statistics report of the underlying texture system. */
+  string full_report() const;
+
+ protected:
+  void *texture_system;
+  thread_mutex mutex;
+};
+
+CCL_NAMESPACE_END
+
+#endif /* __IMAGE_CACHE_H__ */
@@ -40,7 +40,7 @@ class VDBImageLoader : public ImageLoader {
   virtual bool is_vdb_loader() const override;
 
 #ifdef WITH_OPENVDB
-  openvdb::GridBase::ConstPtr get_grid();
+  virtual openvdb::GridBase::ConstPtr get_grid();
 #endif
 
  protected:
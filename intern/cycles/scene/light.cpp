@@ -23,6 +23,7 @@
 #include "util/path.h"
 #include "util/progress.h"
 #include "util/task.h"
+#include "util/tbb.h"
 
 CCL_NAMESPACE_BEGIN
 
@@ -469,6 +470,7 @@ void LightManager::device_update_tree(Device *,
     dscene->light_to_tree.free();
     dscene->object_lookup_offset.free();
     dscene->triangle_to_tree.free();
+    light_tree.reset();
     return;
   }
 
@@ -504,6 +506,7 @@ void LightManager::device_update_tree(Device *,
 
   /* Similarly, we also want to keep track of the index of triangles that are emissive. */
   size_t total_triangles = 0;
+  vector<int> light_objects;
   int object_id = 0;
   foreach (Object *object, scene->objects) {
     if (progress.get_cancel())
@@ -515,25 +518,42 @@ void LightManager::device_update_tree(Device *,
     }
 
     object_lookup_offsets[object_id] = total_triangles;
+    light_objects.push_back(object_id);
 
-    /* Count emissive triangles. */
     Mesh *mesh = static_cast<Mesh *>(object->get_geometry());
-    size_t mesh_num_triangles = mesh->num_triangles();
-
-    for (size_t i = 0; i < mesh_num_triangles; i++) {
-      int shader_index = mesh->get_shader()[i];
-      Shader *shader = (shader_index < mesh->get_used_shaders().size()) ?
-                           static_cast<Shader *>(mesh->get_used_shaders()[shader_index]) :
-                           scene->default_surface;
+    total_triangles += mesh->num_triangles();
+    object_id++;
+  }
 
-      if (shader->emission_sampling != EMISSION_SAMPLING_NONE) {
-        light_prims.emplace_back(scene, i, object_id);
-      }
-    }
+  /* Create primitives for emissive triangles of every object in parallel, meshes with many
+   * emissive triangles would otherwise dominate the update time. */
+  vector<vector<LightTreePrimitive>> object_prims(light_objects.size());
+  parallel_for(blocked_range<size_t>(0, light_objects.size(), 1),
+               [&](const blocked_range<size_t> &r) {
+                 for (size_t index = r.begin(); index != r.end(); index++) {
+                   const int light_object_id = light_objects[index];
+                   Object *object = scene->objects[light_object_id];
+                   Mesh *mesh = static_cast<Mesh *>(object->get_geometry());
+                   size_t mesh_num_triangles = mesh->num_triangles();
+
+                   for (size_t i = 0; i < mesh_num_triangles; i++) {
+                     int shader_index = mesh->get_shader()[i];
+                     Shader *shader = (shader_index < mesh->get_used_shaders().size()) ?
+                                          static_cast<Shader *>(
+                                              mesh->get_used_shaders()[shader_index]) :
+                                          scene->default_surface;
+
+                     if (shader->emission_sampling != EMISSION_SAMPLING_NONE) {
+                       object_prims[index].emplace_back(scene, i, light_object_id);
+                     }
+                   }
+                 }
+               });
 
-    total_triangles += mesh_num_triangles;
-    object_id++;
+  foreach (vector<LightTreePrimitive> &prims, object_prims) {
+    std::move(prims.begin(), prims.end(), std::back_inserter(light_prims));
   }
+  object_prims.clear();
 
   /* Append distant lights to the end of `light_prims` */
   std::move(distant_lights.begin(), distant_lights.end(), std::back_inserter(light_prims));
@@ -541,9 +561,17 @@ void LightManager::device_update_tree(Device *,
   /* Update integrator state. */
   kintegrator->use_direct_light = !light_prims.empty();
 
-  /* TODO: For now, we'll start with a smaller number of max lights in a node.
-   * More benchmarking is needed to determine what number works best. */
-  LightTree light_tree(light_prims, kintegrator->num_distant_lights, 8);
+  /* Refit the tree of the previous update when the same emitters only moved or changed strength,
+   * which is much faster than a new build for many emissive triangles. */
+  if (light_tree && light_tree->refit(light_prims, kintegrator->num_distant_lights)) {
+    VLOG_WORK << "Refitted light tree with " << light_prims.size() << " emitters.";
+  }
+  else {
+    /* TODO: For now, we'll start with a smaller number of max lights in a node.
+     * More benchmarking is needed to determine what number works best. */
+    light_tree = make_unique<LightTree>(light_prims, kintegrator->num_distant_lights, 8);
+    VLOG_WORK << "Built light tree with " << light_prims.size() << " emitters.";
+  }
 
   /* We want to create separate arrays corresponding to triangles and lights,
    * which will be used to index back into the light tree for PDF calculations. */
@@ -557,7 +585,7 @@ void LightManager::device_update_tree(Device *,
   }
 
   /* First initialize the light tree's nodes. */
-  const vector<LightTreeNode> &linearized_bvh = light_tree.get_nodes();
+  const vector<LightTreeNode> &linearized_bvh = light_tree->get_nodes();
   KernelLightTreeNode *light_tree_nodes = dscene->light_tree_nodes.alloc(linearized_bvh.size());
   KernelLightTreeEmitter *light_tree_emitters = dscene->light_tree_emitters.alloc(
       light_prims.size());
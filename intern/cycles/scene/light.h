@@ -16,6 +16,7 @@
 #include "util/ies.h"
 #include "util/thread.h"
 #include "util/types.h"
+#include "util/unique_ptr.h"
 #include "util/vector.h"
 
 CCL_NAMESPACE_BEGIN
@@ -156,6 +157,9 @@ class LightManager {
   bool last_background_enabled;
   int last_background_resolution;
 
+  /* Light tree of the last update, refitted when only emitter transforms or strengths change. */
+  unique_ptr<LightTree> light_tree;
+
   uint32_t update_flags;
 };
 
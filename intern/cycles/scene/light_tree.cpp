@@ -5,6 +5,9 @@
 #include "scene/mesh.h"
 #include "scene/object.h"
 
+#include "util/task.h"
+#include "util/tbb.h"
+
 CCL_NAMESPACE_BEGIN
 
 float OrientationBounds::calculate_measure() const
@@ -205,13 +208,18 @@ LightTree::LightTree(vector<LightTreePrimitive> &prims,
   }
 
   max_lights_in_leaf_ = max_lights_in_leaf;
+  num_distant_lights_ = num_distant_lights;
   int num_prims = prims.size();
   int num_local_lights = num_prims - num_distant_lights;
   /* The amount of nodes is estimated to be twice the amount of primitives */
   nodes_.reserve(2 * num_prims);
 
-  nodes_.emplace_back();                             /* root node */
-  recursive_build(0, num_local_lights, prims, 0, 1); /* build tree */
+  for (int i = 0; i < num_prims; i++) {
+    prims[i].input_index = i;
+  }
+
+  nodes_.emplace_back();                                     /* root node */
+  recursive_build(0, num_local_lights, prims, 0, 1, nodes_); /* build tree */
   nodes_[0].make_interior(nodes_.size());
 
   /* All distant lights are grouped to one node (right child of the root node) */
@@ -226,6 +234,14 @@ LightTree::LightTree(vector<LightTreePrimitive> &prims,
   nodes_.back().make_leaf(num_local_lights, num_distant_lights);
 
   nodes_.shrink_to_fit();
+
+  prim_order_.resize(num_prims);
+  prim_keys_.resize(num_prims);
+  for (int i = 0; i < num_prims; i++) {
+    prim_order_[i] = prims[i].input_index;
+    prim_keys_[i] = make_int2(prims[i].prim_id, prims[i].object_id);
+  }
+  build_cost_ = tree_cost();
 }
 
 const vector<LightTreeNode> &LightTree::get_nodes() const
@@ -233,15 +249,136 @@ const vector<LightTreeNode> &LightTree::get_nodes() const
   return nodes_;
 }
 
-int LightTree::recursive_build(
-    int start, int end, vector<LightTreePrimitive> &prims, uint bit_trail, int depth)
+bool LightTree::refit(vector<LightTreePrimitive> &prims, const int num_distant_lights)
+{
+  const int num_prims = prims.size();
+  if (nodes_.empty() || num_prims != prim_order_.size() ||
+      num_distant_lights != num_distant_lights_)
+  {
+    return false;
+  }
+
+  /* Reorder primitives to match the tree, checking that they are the same emitters. */
+  vector<LightTreePrimitive> tree_prims;
+  tree_prims.reserve(num_prims);
+  for (int i = 0; i < num_prims; i++) {
+    const LightTreePrimitive &prim = prims[prim_order_[i]];
+    if (prim.prim_id != prim_keys_[i].x || prim.object_id != prim_keys_[i].y) {
+      return false;
+    }
+    tree_prims.push_back(prim);
+    tree_prims.back().input_index = prim_order_[i];
+  }
+
+  /* Recompute leaves, and tag the ones that changed so only their ancestors are updated.
+   * Unchanged leaves keep the exact same values they had after the build. */
+  const int num_nodes = nodes_.size();
+  vector<uint8_t> modified(num_nodes, 0);
+  parallel_for(blocked_range<int>(0, num_nodes, 1024), [&](const blocked_range<int> &r) {
+    for (int index = r.begin(); index != r.end(); index++) {
+      LightTreeNode &node = nodes_[index];
+      if (!node.is_leaf()) {
+        continue;
+      }
+
+      BoundBox bbox = BoundBox::empty;
+      OrientationBounds bcone = OrientationBounds::empty;
+      float energy_total = 0.0;
+      for (int i = node.first_prim_index; i < node.first_prim_index + node.num_prims; i++) {
+        const LightTreePrimitive &prim = tree_prims[i];
+        bbox.grow(prim.bbox);
+        bcone = merge(bcone, prim.bcone);
+        energy_total += prim.energy;
+      }
+
+      if (bbox.min == node.bbox.min && bbox.max == node.bbox.max &&
+          bcone.axis == node.bcone.axis && bcone.theta_o == node.bcone.theta_o &&
+          bcone.theta_e == node.bcone.theta_e && energy_total == node.energy)
+      {
+        continue;
+      }
+
+      node.bbox = bbox;
+      node.bcone = bcone;
+      node.energy = energy_total;
+      modified[index] = 1;
+    }
+  });
+
+  /* Children are always stored after their parent, so a reverse traversal updates interior
+   * nodes bottom-up. The root node has no bounds of its own. */
+  for (int index = num_nodes - 1; index > 0; index--) {
+    LightTreeNode &node = nodes_[index];
+    if (node.is_leaf()) {
+      continue;
+    }
+
+    const int left_index = index + 1;
+    const int right_index = node.right_child_index;
+    if (!modified[left_index] && !modified[right_index]) {
+      continue;
+    }
+
+    const LightTreeNode &left = nodes_[left_index];
+    const LightTreeNode &right = nodes_[right_index];
+    node.bbox = left.bbox;
+    node.bbox.grow(right.bbox);
+    node.bcone = merge(left.bcone, right.bcone);
+    node.energy = left.energy + right.energy;
+    modified[index] = 1;
+  }
+
+  /* Lights that moved far from where they were at build time make nodes overlap a lot, rebuild
+   * instead of sampling from an inefficient tree. The primitives are left in input order for
+   * that rebuild, so it records the same order for the next refit. */
+  if (tree_cost() > 2.0f * build_cost_) {
+    return false;
+  }
+
+  prims.swap(tree_prims);
+  return true;
+}
+
+float LightTree::tree_cost() const
+{
+  float cost = 0.0f;
+  for (int index = 1; index < nodes_.size(); index++) {
+    const LightTreeNode &node = nodes_[index];
+    if (!node.bbox.valid()) {
+      continue;
+    }
+    const float area = node.bbox.area();
+    const float measure = (area != 0.0f) ? area : len(node.bbox.size());
+    cost += node.energy * measure * node.bcone.calculate_measure();
+  }
+  return cost;
+}
+
+static int append_subtree(vector<LightTreeNode> &nodes, const vector<LightTreeNode> &subtree)
+{
+  const int offset = nodes.size();
+  for (const LightTreeNode &node : subtree) {
+    nodes.push_back(node);
+    if (!node.is_leaf()) {
+      nodes.back().right_child_index += offset;
+    }
+  }
+  return offset;
+}
+
+int LightTree::recursive_build(int start,
+                               int end,
+                               vector<LightTreePrimitive> &prims,
+                               uint bit_trail,
+                               int depth,
+                               vector<LightTreeNode> &nodes)
 {
   BoundBox bbox = BoundBox::empty;
   OrientationBounds bcone = OrientationBounds::empty;
   BoundBox centroid_bounds = BoundBox::empty;
   float energy_total = 0.0;
   int num_prims = end - start;
-  int current_index = nodes_.size();
+  int current_index = nodes.size();
 
   for (int i = start; i < end; i++) {
     const LightTreePrimitive &prim = prims.at(i);
@@ -252,7 +389,7 @@ int LightTree::recursive_build(
     energy_total += prim.energy;
   }
 
-  nodes_.emplace_back(bbox, bcone, energy_total, bit_trail);
+  nodes.emplace_back(bbox, bcone, energy_total, bit_trail);
 
   bool try_splitting = num_prims > 1 && len(centroid_bounds.size()) > 0.0f;
   int split_dim = -1, split_bucket = 0, num_left_prims = 0;
@@ -283,13 +420,34 @@ int LightTree::recursive_build(
       middle = (start + end) / 2;
     }
 
-    [[maybe_unused]] int left_index = recursive_build(start, middle, prims, bit_trail, depth + 1);
-    int right_index = recursive_build(middle, end, prims, bit_trail | (1u << depth), depth + 1);
-    assert(left_index == current_index + 1);
-    nodes_[current_index].make_interior(right_index);
+    const uint right_bit_trail = bit_trail | (1u << depth);
+    int right_index;
+    if (num_prims >= MIN_PRIMS_PER_TASK) {
+      /* Build both children in parallel into separate arrays, then append them in the same
+       * depth-first order as the serial build, so the tree does not depend on threading. */
+      vector<LightTreeNode> left_nodes, right_nodes;
+      TaskPool pool;
+      pool.push([&]() {
+        left_nodes.reserve(2 * (middle - start));
+        recursive_build(start, middle, prims, bit_trail, depth + 1, left_nodes);
+      });
+      right_nodes.reserve(2 * (end - middle));
+      recursive_build(middle, end, prims, right_bit_trail, depth + 1, right_nodes);
+      pool.wait_work();
+
+      append_subtree(nodes, left_nodes);
+      right_index = append_subtree(nodes, right_nodes);
+    }
+    else {
+      [[maybe_unused]] int left_index = recursive_build(
+          start, middle, prims, bit_trail, depth + 1, nodes);
+      right_index = recursive_build(middle, end, prims, right_bit_trail, depth + 1, nodes);
+      assert(left_index == current_index + 1);
+    }
+    nodes[current_index].make_interior(right_index);
   }
   else {
-    nodes_[current_index].make_leaf(start, num_prims);
+    nodes[current_index].make_leaf(start, num_prims);
   }
   return current_index;
 }
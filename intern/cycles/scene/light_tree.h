@@ -60,6 +60,9 @@ struct LightTreePrimitive {
   int prim_id;
   int object_id;
 
+  /* Index in the array of primitives the light tree is built from. */
+  int input_index = -1;
+
   float energy;
   float3 centroid;
   OrientationBounds bcone;
@@ -134,6 +137,17 @@ class LightTree {
   vector<LightTreeNode> nodes_;
   uint max_lights_in_leaf_;
 
+  /* Input index, prim_id and object_id of the primitives in tree order, to refit the tree. */
+  vector<int> prim_order_;
+  vector<int2> prim_keys_;
+  /* Distant lights are grouped in a single node, their number can't change in a refit. */
+  int num_distant_lights_ = 0;
+  /* Sum of the cost of all nodes after the build, to detect refits that degrade the tree. */
+  float build_cost_ = 0.0f;
+
+  /* Minimum number of primitives to build both children of a node in parallel. */
+  static const int MIN_PRIMS_PER_TASK = 4096;
+
  public:
   LightTree(vector<LightTreePrimitive> &prims,
             const int &num_distant_lights,
@@ -141,9 +155,21 @@ class LightTree {
 
   const vector<LightTreeNode> &get_nodes() const;
 
+  /* Update the nodes containing primitives that were modified, keeping the structure of the
+   * tree. The primitives must be in the same order as passed to the constructor, they are
+   * reordered to match the tree. Returns false if the primitives are not the ones the tree was
+   * built with or the tree became too inefficient, in which case it needs to be rebuilt and the
+   * primitives are left in their input order. */
+  bool refit(vector<LightTreePrimitive> &prims, const int num_distant_lights);
+
  private:
-  int recursive_build(
-      int start, int end, vector<LightTreePrimitive> &prims, uint bit_trail, int depth);
+  int recursive_build(int start,
+                      int end,
+                      vector<LightTreePrimitive> &prims,
+                      uint bit_trail,
+                      int depth,
+                      vector<LightTreeNode> &nodes);
+  float tree_cost() const;
   float min_split_saoh(const BoundBox &centroid_bbox,
                        int start,
                        int end,
@@ -166,6 +166,7 @@ PassInfo Pass::get_info(const PassType type, const bool include_albedo, const bo
       pass_info.num_components = is_lightgroup ? 3 : 4;
       pass_info.use_exposure = true;
       pass_info.support_denoise = !is_lightgroup;
+      pass_info.support_half_float = true;
       break;
     case PASS_DEPTH:
       pass_info.num_components = 1;
@@ -173,6 +174,7 @@ PassInfo Pass::get_info(const PassType type, const bool include_albedo, const bo
       break;
     case PASS_MIST:
       pass_info.num_components = 1;
+      pass_info.support_half_float = true;
       break;
     case PASS_POSITION:
       pass_info.num_components = 3;
@@ -180,9 +182,11 @@ PassInfo Pass::get_info(const PassType type, const bool include_albedo, const bo
       break;
     case PASS_NORMAL:
       pass_info.num_components = 3;
+      pass_info.support_half_float = true;
       break;
     case PASS_ROUGHNESS:
       pass_info.num_components = 1;
+      pass_info.support_half_float = true;
       break;
     case PASS_UV:
       pass_info.num_components = 3;
@@ -204,15 +208,18 @@ PassInfo Pass::get_info(const PassType type, const bool include_albedo, const bo
     case PASS_BACKGROUND:
       pass_info.num_components = 3;
       pass_info.use_exposure = true;
+      pass_info.support_half_float = true;
       break;
     case PASS_AO:
       pass_info.num_components = 3;
+      pass_info.support_half_float = true;
       break;
 
     case PASS_DIFFUSE_COLOR:
     case PASS_GLOSSY_COLOR:
     case PASS_TRANSMISSION_COLOR:
       pass_info.num_components = 3;
+      pass_info.support_half_float = true;
       break;
     case PASS_DIFFUSE:
       pass_info.num_components = 3;
@@ -229,6 +236,7 @@ PassInfo Pass::get_info(const PassType type, const bool include_albedo, const bo
       pass_info.use_exposure = true;
       pass_info.divide_type = (!include_albedo) ? PASS_DIFFUSE_COLOR : PASS_NONE;
       pass_info.use_compositing = true;
+      pass_info.support_half_float = true;
       break;
     case PASS_GLOSSY:
       pass_info.num_components = 3;
@@ -245,6 +253,7 @@ PassInfo Pass::get_info(const PassType type, const bool include_albedo, const bo
       pass_info.use_exposure = true;
       pass_info.divide_type = (!include_albedo) ? PASS_GLOSSY_COLOR : PASS_NONE;
       pass_info.use_compositing = true;
+      pass_info.support_half_float = true;
       break;
     case PASS_TRANSMISSION:
       pass_info.num_components = 3;
@@ -261,6 +270,7 @@ PassInfo Pass::get_info(const PassType type, const bool include_albedo, const bo
       pass_info.use_exposure = true;
       pass_info.divide_type = (!include_albedo) ? PASS_TRANSMISSION_COLOR : PASS_NONE;
       pass_info.use_compositing = true;
+      pass_info.support_half_float = true;
       break;
     case PASS_VOLUME:
       pass_info.num_components = 3;
@@ -274,6 +284,7 @@ PassInfo Pass::get_info(const PassType type, const bool include_albedo, const bo
     case PASS_VOLUME_INDIRECT:
       pass_info.num_components = 3;
       pass_info.use_exposure = true;
+      pass_info.support_half_float = true;
       break;
 
     case PASS_CRYPTOMATTE:
@@ -282,9 +293,11 @@ PassInfo Pass::get_info(const PassType type, const bool include_albedo, const bo
 
     case PASS_DENOISING_NORMAL:
       pass_info.num_components = 3;
+      pass_info.support_half_float = true;
       break;
     case PASS_DENOISING_ALBEDO:
       pass_info.num_components = 3;
+      pass_info.support_half_float = true;
       break;
     case PASS_DENOISING_DEPTH:
       pass_info.num_components = 1;
@@ -292,6 +305,7 @@ PassInfo Pass::get_info(const PassType type, const bool include_albedo, const bo
     case PASS_DENOISING_PREVIOUS:
       pass_info.num_components = 3;
       pass_info.use_exposure = true;
+      pass_info.support_half_float = true;
       break;
 
     case PASS_SHADOW_CATCHER:
@@ -300,6 +314,7 @@ PassInfo Pass::get_info(const PassType type, const bool include_albedo, const bo
       pass_info.use_compositing = true;
       pass_info.use_denoising_albedo = false;
       pass_info.support_denoise = true;
+      pass_info.support_half_float = true;
       break;
     case PASS_SHADOW_CATCHER_SAMPLE_COUNT:
       pass_info.num_components = 1;
@@ -308,6 +323,7 @@ PassInfo Pass::get_info(const PassType type, const bool include_albedo, const bo
       pass_info.num_components = 4;
       pass_info.use_exposure = true;
       pass_info.support_denoise = true;
+      pass_info.support_half_float = true;
       /* Without shadow catcher approximation compositing is not needed.
        * Since we don't know here whether approximation is used or not, leave the decision up to
        * the caller which will know that. */
@@ -323,6 +339,7 @@ PassInfo Pass::get_info(const PassType type, const bool include_albedo, const bo
 
     case PASS_AOV_COLOR:
       pass_info.num_components = 4;
+      pass_info.support_half_float = true;
       break;
     case PASS_AOV_VALUE:
       pass_info.num_components = 1;
@@ -344,6 +361,7 @@ PassInfo Pass::get_info(const PassType type, const bool include_albedo, const bo
       break;
     case PASS_GUIDING_COLOR:
       pass_info.num_components = 3;
+      pass_info.support_half_float = true;
       break;
     case PASS_GUIDING_PROBABILITY:
       pass_info.num_components = 1;
@@ -43,6 +43,9 @@ struct PassInfo {
 
   /* Pass supports denoising. */
   bool support_denoise = false;
+
+  /* Pass tolerates the precision of half float, and can be stored as such in tile files. */
+  bool support_half_float = false;
 };
 
 class Pass : public Node {
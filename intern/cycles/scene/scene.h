@@ -160,6 +160,9 @@ class SceneParams {
   int hair_subdivisions;
   CurveShapeType hair_shape;
   int texture_limit;
+  /* Memory budget in megabytes for streaming file images through the texture cache on the CPU,
+   * zero loads all images fully into memory. */
+  int texture_cache_size;
 
   bool background;
 
@@ -175,6 +178,7 @@ class SceneParams {
     hair_subdivisions = 3;
     hair_shape = CURVE_RIBBON;
     texture_limit = 0;
+    texture_cache_size = 0;
     background = true;
   }
 
@@ -187,7 +191,8 @@ class SceneParams {
              use_bvh_unaligned_nodes == params.use_bvh_unaligned_nodes &&
              num_bvh_time_steps == params.num_bvh_time_steps &&
              hair_subdivisions == params.hair_subdivisions && hair_shape == params.hair_shape &&
-             texture_limit == params.texture_limit);
+             texture_limit == params.texture_limit &&
+             texture_cache_size == params.texture_cache_size);
   }
 
   int curve_subdivisions()
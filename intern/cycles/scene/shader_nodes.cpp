@@ -383,6 +383,17 @@ void ImageTextureNode::compile(SVMCompiler &compiler)
       flags |= NODE_IMAGE_ALPHA_UNASSOCIATE;
     }
   }
+  if (compiler.scene->params.texture_cache_size > 0 && projection == NODE_IMAGE_PROJ_FLAT &&
+      tex_mapping.skip() && vector_in->link) {
+    /* Images in the texture cache use differentials of the default UV map to pick the MIP
+     * level. */
+    ShaderNode *node = vector_in->link->parent;
+    if (node->type == TextureCoordinateNode::get_node_type() &&
+        vector_in->link == node->output("UV") &&
+        !((TextureCoordinateNode *)node)->get_from_dupli()) {
+      flags |= NODE_IMAGE_UV_DIFFERENTIALS;
+    }
+  }
 
   if (projection != NODE_IMAGE_PROJ_BOX) {
     /* If there only is one image (a very common case), we encode it as a negative value. */
@@ -5118,8 +5129,9 @@ void MixColorNode::compile(SVMCompiler &compiler)
   int a_in_stack_offset = compiler.stack_assign(a_in);
   int b_in_stack_offset = compiler.stack_assign(b_in);
 
+  /* The Mix blend type is by far the most common, use a node without dispatch on the type. */
   compiler.add_node(
-      NODE_MIX_COLOR,
+      (blend_type == NODE_MIX_BLEND) ? NODE_MIX_COLOR_BLEND : NODE_MIX_COLOR,
       compiler.encode_uchar4(use_clamp, blend_type, use_clamp_result),
       compiler.encode_uchar4(fac_in_stack_offset, a_in_stack_offset, b_in_stack_offset),
       compiler.stack_assign(result_out));
@@ -6606,9 +6618,51 @@ void MathNode::constant_fold(const ConstantFolder &folder)
   }
   else {
     folder.fold_math(math_type);
+
+    /* Only fuse when the addition was not folded away. */
+    if (math_type == NODE_MATH_ADD && !folder.output->links.empty()) {
+      fuse_multiply_add(folder.graph);
+    }
   }
 }
 
+bool MathNode::fuse_multiply_add(ShaderGraph *graph)
+{
+  ShaderInput *value1_in = input("Value1");
+  ShaderInput *value2_in = input("Value2");
+  ShaderInput *value3_in = input("Value3");
+
+  for (ShaderInput *product_in : {value1_in, value2_in}) {
+    ShaderOutput *product_out = product_in->link;
+    if (product_out == NULL || product_out->links.size() != 1 ||
+        product_out->parent->type != MathNode::get_node_type()) {
+      continue;
+    }
+
+    MathNode *multiply_node = static_cast<MathNode *>(product_out->parent);
+    if (multiply_node->get_math_type() != NODE_MATH_MULTIPLY || multiply_node->get_use_clamp()) {
+      continue;
+    }
+
+    VLOG_DEBUG << "Fusing " << multiply_node->name << "::" << product_out->name()
+               << " into multiply add " << name << ".";
+
+    /* The other operand of the addition becomes the addend, the operands of the multiplication
+     * are moved to this node. The multiplication is left unused and removed by the graph
+     * cleanup. */
+    ShaderInput *addend_in = (product_in == value1_in) ? value2_in : value1_in;
+    graph->relink(addend_in, value3_in);
+    graph->disconnect(product_in);
+    graph->relink(multiply_node->input("Value1"), value1_in);
+    graph->relink(multiply_node->input("Value2"), value2_in);
+
+    set_math_type(NODE_MATH_MULTIPLY_ADD);
+    return true;
+  }
+
+  return false;
+}
+
 void MathNode::compile(SVMCompiler &compiler)
 {
   ShaderInput *value1_in = input("Value1");
@@ -6616,6 +6670,49 @@ void MathNode::compile(SVMCompiler &compiler)
   ShaderInput *value3_in = input("Value3");
   ShaderOutput *value_out = output("Value");
 
+  /* Specialized nodes for the most common operations. The first operand must come from the
+   * stack, other operands which are not linked are stored in the node as constants. Addition and
+   * multiplication are commutative, so the operands are swapped when only the second one is
+   * linked. */
+  ShaderNodeType specialized_type = NODE_END;
+  switch (math_type) {
+    case NODE_MATH_ADD:
+      specialized_type = NODE_MATH_ADD_F;
+      break;
+    case NODE_MATH_MULTIPLY:
+      specialized_type = NODE_MATH_MULTIPLY_F;
+      break;
+    case NODE_MATH_MULTIPLY_ADD:
+      specialized_type = NODE_MATH_MULTIPLY_ADD_F;
+      break;
+    default:
+      break;
+  }
+
+  if (specialized_type != NODE_END && (value1_in->link || value2_in->link)) {
+    ShaderInput *a_in = value1_in;
+    ShaderInput *b_in = value2_in;
+    float b = value2;
+    if (!a_in->link) {
+      std::swap(a_in, b_in);
+      b = value1;
+    }
+
+    const int a_stack_offset = compiler.stack_assign(a_in);
+    const int b_stack_offset = compiler.stack_assign_if_linked(b_in);
+    const int c_stack_offset = (math_type == NODE_MATH_MULTIPLY_ADD) ?
+                                   compiler.stack_assign_if_linked(value3_in) :
+                                   SVM_STACK_INVALID;
+    const int value_stack_offset = compiler.stack_assign(value_out);
+
+    compiler.add_node(
+        specialized_type,
+        compiler.encode_uchar4(a_stack_offset, b_stack_offset, c_stack_offset, value_stack_offset),
+        __float_as_int(b),
+        __float_as_int(value3));
+    return;
+  }
+
   int value1_stack_offset = compiler.stack_assign(value1_in);
   int value2_stack_offset = compiler.stack_assign(value2_in);
   int value3_stack_offset = compiler.stack_assign(value3_in);
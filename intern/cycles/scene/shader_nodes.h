@@ -1372,6 +1372,10 @@ class MathNode : public ShaderNode {
   void expand(ShaderGraph *graph);
   void constant_fold(const ConstantFolder &folder);
 
+  /* Fuse a multiplication which is only used by this addition into a single multiply add.
+   * Returns true if the nodes were fused. */
+  bool fuse_multiply_add(ShaderGraph *graph);
+
   NODE_SOCKET_API(float, value1)
   NODE_SOCKET_API(float, value2)
   NODE_SOCKET_API(float, value3)
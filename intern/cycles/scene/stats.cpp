@@ -38,6 +38,61 @@ bool namedSampleCountPairComparator(const NamedSampleCountPair &a, const NamedSa
   return a.samples > b.samples;
 }
 
+string jsonString(const string &str)
+{
+  string result = "\"";
+  foreach (const char c, str) {
+    if (c == '"' || c == '\\') {
+      result += '\\';
+      result += c;
+    }
+    else if ((unsigned char)c < 0x20) {
+      result += string_printf("\\u%04x", (int)c);
+    }
+    else {
+      result += c;
+    }
+  }
+  result += "\"";
+  return result;
+}
+
+/* Breakdown of render time by kernel, from the number of samples of every profiling event. */
+NamedNestedSampleStats kernelSampleStats(const vector<uint64_t> &event_samples)
+{
+  NamedNestedSampleStats kernel("Total render time", event_samples[PROFILING_UNKNOWN]);
+  kernel.add_entry("Ray setup", event_samples[PROFILING_RAY_SETUP]);
+  kernel.add_entry("Intersect Closest", event_samples[PROFILING_INTERSECT_CLOSEST]);
+  kernel.add_entry("Intersect Shadow", event_samples[PROFILING_INTERSECT_SHADOW]);
+  kernel.add_entry("Intersect Subsurface", event_samples[PROFILING_INTERSECT_SUBSURFACE]);
+  kernel.add_entry("Intersect Volume Stack", event_samples[PROFILING_INTERSECT_VOLUME_STACK]);
+
+  NamedNestedSampleStats &surface = kernel.add_entry("Shade Surface", 0);
+  surface.add_entry("Setup", event_samples[PROFILING_SHADE_SURFACE_SETUP]);
+  surface.add_entry("Shader Evaluation", event_samples[PROFILING_SHADE_SURFACE_EVAL]);
+  surface.add_entry("Render Passes", event_samples[PROFILING_SHADE_SURFACE_PASSES]);
+  surface.add_entry("Direct Light", event_samples[PROFILING_SHADE_SURFACE_DIRECT_LIGHT]);
+  surface.add_entry("Indirect Light", event_samples[PROFILING_SHADE_SURFACE_INDIRECT_LIGHT]);
+  surface.add_entry("Ambient Occlusion", event_samples[PROFILING_SHADE_SURFACE_AO]);
+
+  NamedNestedSampleStats &volume = kernel.add_entry("Shade Volume", 0);
+  volume.add_entry("Setup", event_samples[PROFILING_SHADE_VOLUME_SETUP]);
+  volume.add_entry("Integrate", event_samples[PROFILING_SHADE_VOLUME_INTEGRATE]);
+  volume.add_entry("Direct Light", event_samples[PROFILING_SHADE_VOLUME_DIRECT_LIGHT]);
+  volume.add_entry("Indirect Light", event_samples[PROFILING_SHADE_VOLUME_INDIRECT_LIGHT]);
+
+  NamedNestedSampleStats &shadow = kernel.add_entry("Shade Shadow", 0);
+  shadow.add_entry("Setup", event_samples[PROFILING_SHADE_SHADOW_SETUP]);
+  shadow.add_entry("Surface", event_samples[PROFILING_SHADE_SHADOW_SURFACE]);
+  shadow.add_entry("Volume", event_samples[PROFILING_SHADE_SHADOW_VOLUME]);
+
+  NamedNestedSampleStats &light = kernel.add_entry("Shade Light", 0);
+  light.add_entry("Setup", event_samples[PROFILING_SHADE_LIGHT_SETUP]);
+  light.add_entry("Shader Evaluation", event_samples[PROFILING_SHADE_LIGHT_EVAL]);
+
+  return kernel;
+}
+
 }  // namespace
 
 NamedSizeEntry::NamedSizeEntry() : name(""), size(0)
@@ -157,10 +212,32 @@ string NamedNestedSampleStats::full_report(int indent_level, uint64_t total_samp
   return result;
 }
 
+string NamedNestedSampleStats::json_report()
+{
+  update_sum();
+
+  string result = string_printf("{\"name\": %s, \"total_seconds\": %.3f, \"self_seconds\": %.3f",
+                                jsonString(name).c_str(),
+                                sum_samples * 0.001,
+                                self_samples * 0.001);
+
+  result += ", \"entries\": [";
+  sort(entries.begin(), entries.end(), namedTimeSampleEntryComparator);
+  for (size_t i = 0; i < entries.size(); i++) {
+    result += (i == 0) ? "" : ", ";
+    result += entries[i].json_report();
+  }
+  result += "]}";
+  return result;
+}
+
 /* Named sample count pairs. */
 
-NamedSampleCountPair::NamedSampleCountPair(const ustring &name, uint64_t samples, uint64_t hits)
-    : name(name), samples(samples), hits(hits)
+NamedSampleCountPair::NamedSampleCountPair(const ustring &name,
+                                           uint64_t samples,
+                                           uint64_t hits,
+                                           const vector<uint64_t> &event_samples)
+    : name(name), samples(samples), hits(hits), event_samples(event_samples)
 {
 }
 
@@ -168,15 +245,23 @@ NamedSampleCountStats::NamedSampleCountStats()
 {
 }
 
-void NamedSampleCountStats::add(const ustring &name, uint64_t samples, uint64_t hits)
+void NamedSampleCountStats::add(const ustring &name,
+                                uint64_t samples,
+                                uint64_t hits,
+                                const vector<uint64_t> &event_samples)
 {
   entry_map::iterator entry = entries.find(name);
   if (entry != entries.end()) {
     entry->second.samples += samples;
     entry->second.hits += hits;
+    if (entry->second.event_samples.size() == event_samples.size()) {
+      for (size_t i = 0; i < event_samples.size(); i++) {
+        entry->second.event_samples[i] += event_samples[i];
+      }
+    }
     return;
   }
-  entries.emplace(name, NamedSampleCountPair(name, samples, hits));
+  entries.emplace(name, NamedSampleCountPair(name, samples, hits, event_samples));
 }
 
 string NamedSampleCountStats::full_report(int indent_level)
@@ -211,6 +296,47 @@ string NamedSampleCountStats::full_report(int indent_level)
   return result;
 }
 
+string NamedSampleCountStats::json_report()
+{
+  vector<NamedSampleCountPair> sorted_entries;
+  sorted_entries.reserve(entries.size());
+
+  uint64_t total_hits = 0, total_samples = 0;
+  foreach (entry_map::const_reference entry, entries) {
+    const NamedSampleCountPair &pair = entry.second;
+
+    total_hits += pair.hits;
+    total_samples += pair.samples;
+
+    sorted_entries.push_back(pair);
+  }
+  const double avg_samples_per_hit = (total_hits) ? ((double)total_samples) / total_hits : 0.0;
+
+  sort(sorted_entries.begin(), sorted_entries.end(), namedSampleCountPairComparator);
+
+  string result = "[";
+  for (size_t i = 0; i < sorted_entries.size(); i++) {
+    const NamedSampleCountPair &entry = sorted_entries[i];
+    const double seconds = entry.samples * 0.001;
+    const double relative = (entry.hits && avg_samples_per_hit != 0.0) ?
+                                ((double)entry.samples) / (entry.hits * avg_samples_per_hit) :
+                                0.0;
+
+    result += (i == 0) ? "" : ", ";
+    result += string_printf("{\"name\": %s, \"seconds\": %.3f, \"hits\": %llu",
+                            jsonString(entry.name.string()).c_str(),
+                            seconds,
+                            (unsigned long long)entry.hits);
+    result += string_printf(", \"relative_cost\": %.3f", relative);
+    if (entry.event_samples.size() == PROFILING_NUM_EVENTS) {
+      result += ", \"kernel\": " + kernelSampleStats(entry.event_samples).json_report();
+    }
+    result += "}";
+  }
+  result += "]";
+  return result;
+}
+
 /* Mesh statistics. */
 
 MeshStats::MeshStats()
@@ -244,47 +370,40 @@ string ImageStats::full_report(int indent_level)
 RenderStats::RenderStats()
 {
   has_profiling = false;
+  intersect_samples = 0;
+  shade_samples = 0;
 }
 
 void RenderStats::collect_profiling(Scene *scene, Profiler &prof)
 {
   has_profiling = true;
 
-  kernel = NamedNestedSampleStats("Total render time", prof.get_event(PROFILING_UNKNOWN));
-  kernel.add_entry("Ray setup", prof.get_event(PROFILING_RAY_SETUP));
-  kernel.add_entry("Intersect Closest", prof.get_event(PROFILING_INTERSECT_CLOSEST));
-  kernel.add_entry("Intersect Shadow", prof.get_event(PROFILING_INTERSECT_SHADOW));
-  kernel.add_entry("Intersect Subsurface", prof.get_event(PROFILING_INTERSECT_SUBSURFACE));
-  kernel.add_entry("Intersect Volume Stack", prof.get_event(PROFILING_INTERSECT_VOLUME_STACK));
-
-  NamedNestedSampleStats &surface = kernel.add_entry("Shade Surface", 0);
-  surface.add_entry("Setup", prof.get_event(PROFILING_SHADE_SURFACE_SETUP));
-  surface.add_entry("Shader Evaluation", prof.get_event(PROFILING_SHADE_SURFACE_EVAL));
-  surface.add_entry("Render Passes", prof.get_event(PROFILING_SHADE_SURFACE_PASSES));
-  surface.add_entry("Direct Light", prof.get_event(PROFILING_SHADE_SURFACE_DIRECT_LIGHT));
-  surface.add_entry("Indirect Light", prof.get_event(PROFILING_SHADE_SURFACE_INDIRECT_LIGHT));
-  surface.add_entry("Ambient Occlusion", prof.get_event(PROFILING_SHADE_SURFACE_AO));
-
-  NamedNestedSampleStats &volume = kernel.add_entry("Shade Volume", 0);
-  volume.add_entry("Setup", prof.get_event(PROFILING_SHADE_VOLUME_SETUP));
-  volume.add_entry("Integrate", prof.get_event(PROFILING_SHADE_VOLUME_INTEGRATE));
-  volume.add_entry("Direct Light", prof.get_event(PROFILING_SHADE_VOLUME_DIRECT_LIGHT));
-  volume.add_entry("Indirect Light", prof.get_event(PROFILING_SHADE_VOLUME_INDIRECT_LIGHT));
+  vector<uint64_t> event_samples(PROFILING_NUM_EVENTS);
+  for (int event = 0; event < PROFILING_NUM_EVENTS; event++) {
+    event_samples[event] = prof.get_event((ProfilingEvent)event);
+  }
 
-  NamedNestedSampleStats &shadow = kernel.add_entry("Shade Shadow", 0);
-  shadow.add_entry("Setup", prof.get_event(PROFILING_SHADE_SHADOW_SETUP));
-  shadow.add_entry("Surface", prof.get_event(PROFILING_SHADE_SHADOW_SURFACE));
-  shadow.add_entry("Volume", prof.get_event(PROFILING_SHADE_SHADOW_VOLUME));
+  kernel = kernelSampleStats(event_samples);
 
-  NamedNestedSampleStats &light = kernel.add_entry("Shade Light", 0);
-  light.add_entry("Setup", prof.get_event(PROFILING_SHADE_LIGHT_SETUP));
-  light.add_entry("Shader Evaluation", prof.get_event(PROFILING_SHADE_LIGHT_EVAL));
+  /* Split between ray traversal and intersection, and shading. */
+  intersect_samples = 0;
+  for (int event = PROFILING_INTERSECT_CLOSEST; event <= PROFILING_INTERSECT_VOLUME_STACK;
+       event++) {
+    intersect_samples += event_samples[event];
+  }
+  shade_samples = 0;
+  for (int event = PROFILING_SHADE_SURFACE_SETUP; event < PROFILING_NUM_EVENTS; event++) {
+    shade_samples += event_samples[event];
+  }
 
   shaders.entries.clear();
   foreach (Shader *shader, scene->shaders) {
     uint64_t samples, hits;
     if (prof.get_shader(shader->id, samples, hits)) {
-      shaders.add(shader->name, samples, hits);
+      for (int event = 0; event < PROFILING_NUM_EVENTS; event++) {
+        event_samples[event] = prof.get_shader_event(shader->id, (ProfilingEvent)event);
+      }
+      shaders.add(shader->name, samples, hits, event_samples);
     }
   }
 
@@ -292,7 +411,11 @@ void RenderStats::collect_profiling(Scene *scene, Profiler &prof)
   foreach (Object *object, scene->objects) {
     uint64_t samples, hits;
     if (prof.get_object(object->get_device_index(), samples, hits)) {
-      objects.add(object->name, samples, hits);
+      for (int event = 0; event < PROFILING_NUM_EVENTS; event++) {
+        event_samples[event] = prof.get_object_event(object->get_device_index(),
+                                                     (ProfilingEvent)event);
+      }
+      objects.add(object->name, samples, hits, event_samples);
     }
   }
 }
@@ -313,6 +436,25 @@ string RenderStats::full_report()
   return result;
 }
 
+string RenderStats::json_report()
+{
+  if (!has_profiling) {
+    return "{}";
+  }
+
+  kernel.update_sum();
+
+  string result = "{";
+  result += string_printf("\"total_seconds\": %.3f", kernel.sum_samples * 0.001);
+  result += string_printf(", \"intersect_seconds\": %.3f", intersect_samples * 0.001);
+  result += string_printf(", \"shade_seconds\": %.3f", shade_samples * 0.001);
+  result += ", \"kernel\": " + kernel.json_report();
+  result += ", \"shaders\": " + shaders.json_report();
+  result += ", \"objects\": " + objects.json_report();
+  result += "}\n";
+  return result;
+}
+
 NamedTimeStats::NamedTimeStats() : total_time(0.0)
 {
 }
@@ -101,6 +101,9 @@ class NamedNestedSampleStats {
 
   string full_report(int indent_level = 0, uint64_t total_samples = 0);
 
+  /* Generate report as JSON object, with times in seconds. */
+  string json_report();
+
   string name;
 
   /* self_samples contains only the samples that this specific event got,
@@ -115,11 +118,17 @@ class NamedNestedSampleStats {
  * This allows to estimate the time spent per item. */
 class NamedSampleCountPair {
  public:
-  NamedSampleCountPair(const ustring &name, uint64_t samples, uint64_t hits);
+  NamedSampleCountPair(const ustring &name,
+                       uint64_t samples,
+                       uint64_t hits,
+                       const vector<uint64_t> &event_samples);
 
   ustring name;
   uint64_t samples;
   uint64_t hits;
+
+  /* Samples for each profiling event, for the breakdown by kernel. */
+  vector<uint64_t> event_samples;
 };
 
 /* Contains statistics about pairs of samples and counts as described above. */
@@ -128,7 +137,13 @@ class NamedSampleCountStats {
   NamedSampleCountStats();
 
   string full_report(int indent_level = 0);
-  void add(const ustring &name, uint64_t samples, uint64_t hits);
+  /* Generate report as JSON array, with times in seconds. */
+  string json_report();
+
+  void add(const ustring &name,
+           uint64_t samples,
+           uint64_t hits,
+           const vector<uint64_t> &event_samples = vector<uint64_t>());
 
   typedef unordered_map<ustring, NamedSampleCountPair, ustringHash> entry_map;
   entry_map entries;
@@ -168,11 +183,18 @@ class RenderStats {
   /* Return full report as string. */
   string full_report();
 
+  /* Return profiling information as JSON, for processing by other tools. */
+  string json_report();
+
   /* Collect kernel sampling information from Stats. */
   void collect_profiling(Scene *scene, Profiler &prof);
 
   bool has_profiling;
 
+  /* Samples spent in ray intersection kernels and in shading kernels. */
+  uint64_t intersect_samples;
+  uint64_t shade_samples;
+
   MeshStats mesh;
   ImageStats image;
   NamedNestedSampleStats kernel;
@@ -527,6 +527,7 @@ void Session::do_delayed_reset()
 
   /* Update for new state of scene and passes. */
   buffer_params_.update_passes(scene->passes);
+  tile_manager_.set_use_half_float(params.use_half_float_tiles);
   tile_manager_.update(buffer_params_, scene);
 
   /* Update temp directory on reset.
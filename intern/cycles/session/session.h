@@ -54,6 +54,9 @@ class SessionParams {
   bool use_auto_tile;
   int tile_size;
 
+  /* Store passes which tolerate it as half float in the tile files written to disk. */
+  bool use_half_float_tiles;
+
   bool use_resolution_divider;
 
   ShadingSystem shadingsystem;
@@ -77,6 +80,7 @@ class SessionParams {
 
     use_auto_tile = true;
     tile_size = 2048;
+    use_half_float_tiles = false;
 
     use_resolution_divider = true;
 
@@ -31,6 +31,7 @@ static const char *ATTR_PASSES_COUNT = "cycles.passes.count";
 static const char *ATTR_PASS_SOCKET_PREFIX_FORMAT = "cycles.passes.%d.";
 static const char *ATTR_BUFFER_SOCKET_PREFIX = "cycles.buffer.";
 static const char *ATTR_DENOISE_SOCKET_PREFIX = "cycles.denoise.";
+static const char *ATTR_HALF_FLOAT_SCALE = "cycles.half_float_scale";
 
 /* Global counter of ToleManager object instances. */
 static std::atomic<uint64_t> g_instance_index = 0;
@@ -70,6 +71,64 @@ static std::vector<std::string> exr_channel_names_for_passes(const BufferParams
   return channel_names;
 }
 
+/* Formats of the EXR channels constructed by exr_channel_names_for_passes(). Passes which
+ * tolerate it are stored as half float when requested, all other passes as float. */
+static std::vector<TypeDesc> exr_channel_formats_for_passes(const BufferParams &buffer_params,
+                                                            const bool use_half_float)
+{
+  std::vector<TypeDesc> channel_formats;
+  for (const BufferPass &pass : buffer_params.passes) {
+    if (pass.offset == PASS_UNUSED) {
+      continue;
+    }
+
+    const PassInfo pass_info = pass.get_info();
+    const TypeDesc format = (use_half_float && pass_info.support_half_float) ? TypeDesc::HALF :
+                                                                               TypeDesc::FLOAT;
+
+    for (int i = 0; i < pass_info.num_components; ++i) {
+      channel_formats.push_back(format);
+    }
+  }
+
+  return channel_formats;
+}
+
+/* Scale values of the half float channels, which store pass values divided by the number of
+ * samples. Values are clamped to the half float range when scaling for writing, instead of
+ * turning into infinity. */
+static void image_half_float_channels_scale(const ImageSpec &image_spec,
+                                            float *pixels,
+                                            const int64_t num_pixels,
+                                            const int64_t pixel_stride,
+                                            const bool for_read)
+{
+  if (image_spec.find_attribute(ATTR_HALF_FLOAT_SCALE) == nullptr) {
+    return;
+  }
+
+  const float scale = image_spec.get_float_attribute(ATTR_HALF_FLOAT_SCALE, 1.0f);
+
+  vector<int> half_channels;
+  for (int channel = 0; channel < image_spec.nchannels; ++channel) {
+    if (image_spec.channelformat(channel) == TypeDesc::HALF) {
+      half_channels.push_back(channel);
+    }
+  }
+
+  for (int64_t i = 0; i < num_pixels; ++i) {
+    float *pixel = pixels + i * pixel_stride;
+    for (const int channel : half_channels) {
+      if (for_read) {
+        pixel[channel] /= scale;
+      }
+      else {
+        pixel[channel] = clamp(pixel[channel] * scale, -65504.0f, 65504.0f);
+      }
+    }
+  }
+}
+
 inline string node_socket_attribute_name(const SocketType &socket, const string &attr_name_prefix)
 {
   return attr_name_prefix + string(socket.name);
@@ -274,10 +333,15 @@ static bool buffer_params_from_image_spec_atttributes(BufferParams *buffer_param
  * metadata will be set so that the render buffers and passes can be reconstructed from it.
  *
  * If the tile size different from (0, 0) the image specification will be configured to use the
- * given tile size for tiled IO. */
+ * given tile size for tiled IO.
+ *
+ * With half float enabled, passes which tolerate it are stored as half float. Those channels
+ * store the pass values divided by the number of samples, to keep accumulated values of many
+ * samples within the half float range. */
 static bool configure_image_spec_from_buffer(ImageSpec *image_spec,
                                              const BufferParams &buffer_params,
-                                             const int2 tile_size = make_int2(0, 0))
+                                             const int2 tile_size = make_int2(0, 0),
+                                             const bool use_half_float = false)
 {
   const std::vector<std::string> channel_names = exr_channel_names_for_passes(buffer_params);
   const int num_channels = channel_names.size();
@@ -287,6 +351,14 @@ static bool configure_image_spec_from_buffer(ImageSpec *image_spec,
 
   image_spec->channelnames = move(channel_names);
 
+  /* Lossless compression, the buffers are read back for denoising and final output. */
+  image_spec->attribute("compression", "zip");
+
+  if (use_half_float) {
+    image_spec->channelformats = exr_channel_formats_for_passes(buffer_params, true);
+    image_spec->attribute(ATTR_HALF_FLOAT_SCALE, 1.0f / max(buffer_params.samples, 1));
+  }
+
   if (!buffer_params_to_image_spec_atttributes(image_spec, buffer_params)) {
     return false;
   }
@@ -321,6 +393,8 @@ TileManager::TileManager()
 
 TileManager::~TileManager()
 {
+  /* Finish background writes before the tile file handle is destroyed. */
+  wait_pending_tile_writes();
 }
 
 int TileManager::compute_render_tile_size(const int suggested_tile_size) const
@@ -360,7 +434,8 @@ void TileManager::update(const BufferParams &params, const Scene *scene)
   if (has_multiple_tiles()) {
     /* TODO(sergey): Proper Error handling, so that if configuration has failed we don't attempt to
      * write to a partially configured file. */
-    configure_image_spec_from_buffer(&write_state_.image_spec, buffer_params_, tile_size_);
+    configure_image_spec_from_buffer(
+        &write_state_.image_spec, buffer_params_, tile_size_, use_half_float_);
 
     const DenoiseParams denoise_params = scene->integrator->get_denoise_params();
     const AdaptiveSampling adaptive_sampling = scene->integrator->get_adaptive_sampling();
@@ -388,6 +463,11 @@ void TileManager::set_temp_dir(const string &temp_dir)
   temp_dir_ = temp_dir;
 }
 
+void TileManager::set_use_half_float(const bool use_half_float)
+{
+  use_half_float_ = use_half_float;
+}
+
 bool TileManager::done()
 {
   return tile_state_.next_tile_index == tile_state_.num_tiles;
@@ -480,6 +560,10 @@ bool TileManager::close_tile_output()
     return true;
   }
 
+  if (!wait_pending_tile_writes()) {
+    LOG(ERROR) << "Error writing tiles before closing tile file.";
+  }
+
   const bool success = write_state_.tile_out->close();
   write_state_.tile_out = nullptr;
 
@@ -507,39 +591,85 @@ bool TileManager::write_tile(const RenderBuffers &tile_buffers)
 
   const BufferParams &tile_params = tile_buffers.params;
 
-  const int tile_x = tile_params.full_x - buffer_params_.full_x + tile_params.window_x;
-  const int tile_y = tile_params.full_y - buffer_params_.full_y + tile_params.window_y;
-
   const int64_t pass_stride = tile_params.pass_stride;
   const int64_t tile_row_stride = tile_params.width * pass_stride;
 
-  vector<float> pixel_storage;
+  PendingTile tile;
+  tile.x = tile_params.full_x - buffer_params_.full_x + tile_params.window_x;
+  tile.y = tile_params.full_y - buffer_params_.full_y + tile_params.window_y;
+  tile.width = tile_params.window_width;
+  tile.height = tile_params.window_height;
+  tile.pass_stride = pass_stride;
+
+  /* Copy pixels into single continuous block of memory without any "gaps" from the overscan.
+   * The render buffers are re-used for the next tile while this one is written in the
+   * background, so the copy is always needed.
+   *
+   * The continuous block is also a workaround for bug in OIIO
+   * (https://github.com/OpenImageIO/oiio/pull/3176). Our task reference: T93008. */
+  tile.pixels.resize(pass_stride * tile.width * tile.height);
+
   const float *pixels = tile_buffers.buffer.data() + tile_params.window_x * pass_stride +
                         tile_params.window_y * tile_row_stride;
+  float *pixels_continuous = tile.pixels.data();
 
-  /* If there is an overscan used for the tile copy pixels into single continuous block of memory
-   * without any "gaps".
-   * This is a workaround for bug in OIIO (https://github.com/OpenImageIO/oiio/pull/3176).
-   * Our task reference: T93008. */
-  if (tile_params.window_x || tile_params.window_y ||
-      tile_params.window_width != tile_params.width ||
-      tile_params.window_height != tile_params.height) {
-    pixel_storage.resize(pass_stride * tile_params.window_width * tile_params.window_height);
-    float *pixels_continuous = pixel_storage.data();
-
-    const int64_t pixels_row_stride = pass_stride * tile_params.width;
-    const int64_t pixels_continuous_row_stride = pass_stride * tile_params.window_width;
-
-    for (int i = 0; i < tile_params.window_height; ++i) {
-      memcpy(pixels_continuous, pixels, sizeof(float) * pixels_continuous_row_stride);
-      pixels += pixels_row_stride;
-      pixels_continuous += pixels_continuous_row_stride;
+  const int64_t pixels_continuous_row_stride = pass_stride * tile.width;
+
+  for (int i = 0; i < tile.height; ++i) {
+    memcpy(pixels_continuous, pixels, sizeof(float) * pixels_continuous_row_stride);
+    pixels += tile_row_stride;
+    pixels_continuous += pixels_continuous_row_stride;
+  }
+
+  /* Half float channels are scaled, see configure_image_spec_from_buffer(). */
+  image_half_float_channels_scale(write_state_.image_spec,
+                                  tile.pixels.data(),
+                                  int64_t(tile.width) * tile.height,
+                                  pass_stride,
+                                  false);
+
+  VLOG_WORK << "Queue tile at " << tile.x << ", " << tile.y << " for writing";
+
+  {
+    thread_scoped_lock lock(pending_write_state_.mutex);
+
+    while (pending_write_state_.queue.size() >= size_t(MAX_PENDING_TILE_WRITES)) {
+      pending_write_state_.condition.wait(lock);
     }
 
-    pixels = pixel_storage.data();
+    if (pending_write_state_.write_failed) {
+      return false;
+    }
+
+    pending_write_state_.queue.emplace_back(std::move(tile));
+  }
+
+  if (!pending_write_state_.task_pool) {
+    pending_write_state_.task_pool = make_unique<DedicatedTaskPool>();
+  }
+  pending_write_state_.task_pool->push([this]() { write_pending_tile(); });
+
+  ++write_state_.num_tiles_written;
+
+  VLOG_WORK << "Tile queued in " << time_dt() - time_start << " seconds.";
+
+  return true;
+}
+
+void TileManager::write_pending_tile()
+{
+  /* The tile stays in the queue until it is written, so that its memory is accounted for by the
+   * pending writes limit. */
+  const PendingTile *tile;
+  {
+    thread_scoped_lock lock(pending_write_state_.mutex);
+    DCHECK(!pending_write_state_.queue.empty());
+    tile = &pending_write_state_.queue.front();
   }
 
-  VLOG_WORK << "Write tile at " << tile_x << ", " << tile_y;
+  const double time_start = time_dt();
+
+  VLOG_WORK << "Write tile at " << tile->x << ", " << tile->y;
 
   /* The image tile sizes in the OpenEXR file are different from the size of our big tiles. The
    * write_tiles() method expects a contiguous image region that will be split into tiles
@@ -549,40 +679,59 @@ bool TileManager::write_tile(const RenderBuffers &tile_buffers)
    * The only thing we have to ensure is that the tile_x and tile_y are a multiple of the
    * image tile size, which happens in compute_render_tile_size. */
 
-  const int64_t xstride = pass_stride * sizeof(float);
-  const int64_t ystride = xstride * tile_params.window_width;
-  const int64_t zstride = ystride * tile_params.window_height;
-
-  if (!write_state_.tile_out->write_tiles(tile_x,
-                                          tile_x + tile_params.window_width,
-                                          tile_y,
-                                          tile_y + tile_params.window_height,
-                                          0,
-                                          1,
-                                          TypeDesc::FLOAT,
-                                          pixels,
-                                          xstride,
-                                          ystride,
-                                          zstride)) {
+  const int64_t xstride = tile->pass_stride * sizeof(float);
+  const int64_t ystride = xstride * tile->width;
+  const int64_t zstride = ystride * tile->height;
+
+  const bool success = write_state_.tile_out->write_tiles(tile->x,
+                                                          tile->x + tile->width,
+                                                          tile->y,
+                                                          tile->y + tile->height,
+                                                          0,
+                                                          1,
+                                                          TypeDesc::FLOAT,
+                                                          tile->pixels.data(),
+                                                          xstride,
+                                                          ystride,
+                                                          zstride);
+  if (success) {
+    VLOG_WORK << "Tile written in " << time_dt() - time_start << " seconds.";
+  }
+  else {
     LOG(ERROR) << "Error writing tile " << write_state_.tile_out->geterror();
-    return false;
   }
 
-  ++write_state_.num_tiles_written;
+  thread_scoped_lock lock(pending_write_state_.mutex);
+  if (!success) {
+    pending_write_state_.write_failed = true;
+  }
+  pending_write_state_.queue.pop_front();
+  pending_write_state_.condition.notify_all();
+}
+
+bool TileManager::wait_pending_tile_writes()
+{
+  if (pending_write_state_.task_pool) {
+    pending_write_state_.task_pool->wait();
+  }
 
-  VLOG_WORK << "Tile written in " << time_dt() - time_start << " seconds.";
+  thread_scoped_lock lock(pending_write_state_.mutex);
+  const bool success = !pending_write_state_.write_failed;
+  pending_write_state_.write_failed = false;
 
-  return true;
+  return success;
 }
 
-void TileManager::finish_write_tiles()
+bool TileManager::finish_write_tiles()
 {
   if (!write_state_.tile_out) {
     /* None of the tiles were written hence the file was not created.
      * Avoid creation of fully empty file since it is redundant. */
-    return;
+    return true;
   }
 
+  bool success = wait_pending_tile_writes();
+
   /* EXR expects all tiles to present in file. So explicitly write missing tiles as all-zero. */
   if (write_state_.num_tiles_written < tile_state_.num_tiles) {
     vector<float> pixel_storage(tile_size_.x * tile_size_.y * buffer_params_.pass_stride);
@@ -607,7 +756,9 @@ void TileManager::finish_write_tiles()
     }
   }
 
-  close_tile_output();
+  if (!close_tile_output()) {
+    success = false;
+  }
 
   if (full_buffer_written_cb) {
     full_buffer_written_cb(write_state_.filename);
@@ -622,6 +773,8 @@ void TileManager::finish_write_tiles()
   ++write_state_.tile_file_index;
 
   write_state_.filename = "";
+
+  return success;
 }
 
 bool TileManager::read_full_buffer_from_disk(const string_view filename,
@@ -652,6 +805,12 @@ bool TileManager::read_full_buffer_from_disk(const string_view filename,
     return false;
   }
 
+  image_half_float_channels_scale(image_spec,
+                                  buffers->buffer.data(),
+                                  int64_t(buffers->params.width) * buffers->params.height,
+                                  buffers->params.pass_stride,
+                                  true);
+
   if (!in->close()) {
     LOG(ERROR) << "Error closing tile file " << in->geterror();
     return false;
@@ -5,8 +5,12 @@
 
 #include "session/buffers.h"
 #include "util/image.h"
+#include "util/list.h"
 #include "util/string.h"
+#include "util/task.h"
+#include "util/thread.h"
 #include "util/unique_ptr.h"
+#include "util/vector.h"
 
 CCL_NAMESPACE_BEGIN
 
@@ -60,6 +64,9 @@ class TileManager {
 
   void set_temp_dir(const string &temp_dir);
 
+  /* Store passes which tolerate it as half float in the tile file, to reduce its size. */
+  void set_use_half_float(const bool use_half_float);
+
   inline int get_num_tiles() const
   {
     return tile_state_.num_tiles;
@@ -85,12 +92,19 @@ class TileManager {
    *
    * Opens file for write when first tile is written.
    *
-   * Returns true on success. */
+   * The pixels are copied and written to the file from a background thread, so that rendering of
+   * the next tile can start while the file is being written. The call only blocks when the
+   * maximum number of pending tile writes is reached.
+   *
+   * Returns true on success. Errors of the background writes are reported by the next call. */
   bool write_tile(const RenderBuffers &tile_buffers);
 
   /* Inform the tile manager that no more tiles will be written to disk.
-   * The file will be considered final, all handles to it will be closed. */
-  void finish_write_tiles();
+   * Waits for pending tile writes, after which the file will be considered final and all handles
+   * to it will be closed.
+   *
+   * Returns true if all tiles were successfully written. */
+  bool finish_write_tiles();
 
   /* Check whether any tile has been written to disk. */
   inline bool has_written_tiles() const
@@ -117,6 +131,10 @@ class TileManager {
    * Use conservative value which is safe for most of OpenGL drivers and GPUs. */
   static const int MAX_TILE_SIZE = 8192;
 
+  /* Maximum number of tiles which are copied and waiting to be written to disk.
+   * Bounds the memory used by the background writes to the size of this many tiles. */
+  static const int MAX_PENDING_TILE_WRITES = 1;
+
  protected:
   /* Get tile configuration for its index.
    * The tile index must be within [0, state_.tile_state_). */
@@ -125,7 +143,15 @@ class TileManager {
   bool open_tile_output();
   bool close_tile_output();
 
+  /* Write the oldest pending tile to the file. Executed by the background write thread. */
+  void write_pending_tile();
+
+  /* Wait for all pending tiles to be written to disk.
+   * Returns false if any of the writes has failed since the previous call. */
+  bool wait_pending_tile_writes();
+
   string temp_dir_;
+  bool use_half_float_ = false;
 
   /* Part of an on-disk tile file name which avoids conflicts between several Cycles instances or
    * several sessions. */
@@ -174,6 +200,26 @@ class TileManager {
 
     int num_tiles_written = 0;
   } write_state_;
+
+  /* Tile pixels copied from the render buffers, waiting to be written to the file. */
+  struct PendingTile {
+    int x = 0, y = 0;
+    int width = 0, height = 0;
+    int64_t pass_stride = 0;
+    vector<float> pixels;
+  };
+
+  /* State of the background tile writes, the queue and error flag are guarded by the mutex. */
+  struct {
+    list<PendingTile> queue;
+    bool write_failed = false;
+
+    thread_mutex mutex;
+    thread_condition_variable condition;
+
+    /* Thread which writes tiles to the file, created when the first tile is written. */
+    unique_ptr<DedicatedTaskPool> task_pool;
+  } pending_write_state_;
 };
 
 CCL_NAMESPACE_END
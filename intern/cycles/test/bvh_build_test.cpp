@@ -0,0 +1,126 @@
+/* SPDX-License-Identifier: Apache-2.0
+ * Copyright 2011-2022 Blender Foundation */
+
+#include "testing/testing.h"
+
+#include "bvh_test_util.h"
+
+#include "bvh/build.h"
+#include "bvh/node.h"
+#include "bvh/params.h"
+
+#include "scene/mesh.h"
+#include "scene/object.h"
+
+#include "util/array.h"
+#include "util/progress.h"
+#include "util/task.h"
+#include "util/time.h"
+
+CCL_NAMESPACE_BEGIN
+
+namespace {
+
+/* Build a BVH2 for the mesh with the binning builder, returning the primitive order. */
+array<int> build_bvh(Mesh *mesh, int *r_num_triangles = NULL, double *r_build_time = NULL)
+{
+  Object object;
+  object.set_geometry(mesh);
+  vector<Object *> objects;
+  objects.push_back(&object);
+
+  BVHParams params;
+  params.use_spatial_split = false;
+
+  array<int> prim_type, prim_index, prim_object;
+  array<float2> prim_time;
+  Progress progress;
+
+  const double start_time = time_dt();
+  BVHBuild bvh_build(objects, prim_type, prim_index, prim_object, prim_time, params, progress);
+  BVHNode *root = bvh_build.run();
+  if (r_build_time) {
+    *r_build_time = time_dt() - start_time;
+  }
+
+  if (r_num_triangles) {
+    *r_num_triangles = root->getSubtreeSize(BVH_STAT_TRIANGLE_COUNT);
+  }
+  root->deleteSubtree();
+
+  return prim_index;
+}
+
+}  // namespace
+
+TEST(bvh_build, references_all_triangles)
+{
+  TaskScheduler::init(0);
+
+  /* Large enough for parallel reference generation, binning and partitioning. */
+  Mesh mesh;
+  build_grid_mesh(&mesh, 300);
+  const int num_triangles = mesh.num_triangles();
+
+  int num_leaf_triangles = 0;
+  const array<int> prim_index = build_bvh(&mesh, &num_leaf_triangles);
+
+  TaskScheduler::exit();
+
+  EXPECT_EQ(num_leaf_triangles, num_triangles);
+  ASSERT_EQ(prim_index.size(), size_t(num_triangles));
+
+  vector<int> prim_users(num_triangles, 0);
+  for (size_t i = 0; i < prim_index.size(); i++) {
+    ASSERT_GE(prim_index[i], 0);
+    ASSERT_LT(prim_index[i], num_triangles);
+    prim_users[prim_index[i]]++;
+  }
+  for (int i = 0; i < num_triangles; i++) {
+    EXPECT_EQ(prim_users[i], 1);
+  }
+}
+
+TEST(bvh_build, independent_of_thread_count)
+{
+  Mesh mesh;
+  build_grid_mesh(&mesh, 300);
+
+  TaskScheduler::init(1);
+  const array<int> prim_index_single = build_bvh(&mesh);
+  TaskScheduler::exit();
+
+  TaskScheduler::init(0);
+  const array<int> prim_index_multi = build_bvh(&mesh);
+  TaskScheduler::exit();
+
+  EXPECT_TRUE(prim_index_single == prim_index_multi);
+}
+
+/* Build time of a 10M triangle mesh for an increasing number of threads. Disabled by default
+ * because of the run time, run with --gtest_also_run_disabled_tests. */
+TEST(bvh_build, DISABLED_benchmark_thread_count)
+{
+  Mesh mesh;
+  build_grid_mesh(&mesh, 2237);
+  printf("BVH2 build of %d triangles\n", (int)mesh.num_triangles());
+
+  TaskScheduler::init(0);
+  const int max_threads = TaskScheduler::max_concurrency();
+  TaskScheduler::exit();
+
+  for (int num_threads = 1;; num_threads = min(num_threads * 2, max_threads)) {
+    TaskScheduler::init(num_threads);
+    double build_time = 0.0;
+    build_bvh(&mesh, NULL, &build_time);
+    TaskScheduler::exit();
+
+    printf("  %3d threads: %.3f s\n", num_threads, build_time);
+
+    if (num_threads == max_threads) {
+      break;
+    }
+  }
+}
+
+CCL_NAMESPACE_END
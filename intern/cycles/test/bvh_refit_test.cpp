@@ -0,0 +1,134 @@
+/* SPDX-License-Identifier: Apache-2.0
+ * Copyright 2011-2022 Blender Foundation */
+
+#include "testing/testing.h"
+
+#include "bvh_test_util.h"
+
+#include "bvh/bvh2.h"
+#include "bvh/params.h"
+
+#include "scene/mesh.h"
+#include "scene/object.h"
+
+#include "util/boundbox.h"
+#include "util/progress.h"
+#include "util/transform.h"
+
+CCL_NAMESPACE_BEGIN
+
+namespace {
+
+/* Bounds of both children of the root node. */
+BoundBox root_bounds(const BVH2 *bvh)
+{
+  const int4 *data = &bvh->pack.nodes[0];
+  BoundBox bounds = BoundBox::empty;
+  for (int i = 0; i < 2; i++) {
+    bounds.grow(make_float3(__int_as_float(data[1][i]),
+                            __int_as_float(data[2][i]),
+                            __int_as_float(data[3][i])));
+    bounds.grow(make_float3(__int_as_float(data[1][i + 2]),
+                            __int_as_float(data[2][i + 2]),
+                            __int_as_float(data[3][i + 2])));
+  }
+  return bounds;
+}
+
+BVH2 *create_bvh2(const bool top_level,
+                  const vector<Geometry *> &geometry,
+                  const vector<Object *> &objects)
+{
+  BVHParams params;
+  params.top_level = top_level;
+  params.bvh_layout = BVH_LAYOUT_BVH2;
+  params.use_spatial_split = false;
+  return static_cast<BVH2 *>(BVH::create(params, geometry, objects, NULL));
+}
+
+void expect_bounds_near(const BoundBox &a, const BoundBox &b)
+{
+  EXPECT_NEAR(a.min.x, b.min.x, 1e-5f);
+  EXPECT_NEAR(a.min.y, b.min.y, 1e-5f);
+  EXPECT_NEAR(a.min.z, b.min.z, 1e-5f);
+  EXPECT_NEAR(a.max.x, b.max.x, 1e-5f);
+  EXPECT_NEAR(a.max.y, b.max.y, 1e-5f);
+  EXPECT_NEAR(a.max.z, b.max.z, 1e-5f);
+}
+
+}  // namespace
+
+TEST(bvh_refit, top_level_instances_and_deformed_mesh)
+{
+  Progress progress;
+
+  /* Instanced mesh with its own BVH. */
+  Mesh instanced_mesh;
+  build_grid_mesh(&instanced_mesh, 10);
+
+  Object geometry_object;
+  geometry_object.set_geometry(&instanced_mesh);
+  instanced_mesh.bvh = create_bvh2(false, {&instanced_mesh}, {&geometry_object});
+  static_cast<BVH2 *>(instanced_mesh.bvh)->build(progress, NULL);
+
+  /* Mesh with transform applied, stored in the top level BVH. */
+  Mesh applied_mesh;
+  build_grid_mesh(&applied_mesh, 10);
+  applied_mesh.transform_applied = true;
+  applied_mesh.prim_offset = instanced_mesh.num_triangles();
+
+  Object instance_a, instance_b, applied_object;
+  instance_a.set_geometry(&instanced_mesh);
+  instance_b.set_geometry(&instanced_mesh);
+  instance_b.set_tfm(transform_translate(20.0f, 0.0f, 0.0f));
+  applied_object.set_geometry(&applied_mesh);
+
+  const vector<Geometry *> geometry = {&instanced_mesh, &applied_mesh};
+  const vector<Object *> objects = {&instance_a, &instance_b, &applied_object};
+  for (Object *object : objects) {
+    object->compute_bounds(false);
+  }
+
+  BVH2 *bvh = create_bvh2(true, geometry, objects);
+  bvh->build(progress, NULL);
+  bvh->store_object_layout();
+  const size_t num_nodes = bvh->pack.nodes.size();
+  const size_t num_leaf_nodes = bvh->pack.leaf_nodes.size();
+  const size_t num_prims = bvh->pack.prim_index.size();
+
+  /* Packed data is moved to the device after building. */
+  PackedBVH device_pack = std::move(bvh->pack);
+
+  /* Move an instance and deform the mesh in the top level BVH. */
+  instance_a.set_tfm(transform_translate(0.0f, -30.0f, 5.0f));
+  array<float3> verts = applied_mesh.get_verts();
+  for (size_t i = 0; i < verts.size(); i++) {
+    verts[i].z = float(i % 7);
+  }
+  applied_mesh.set_verts(verts);
+  applied_mesh.compute_bounds();
+  for (Object *object : objects) {
+    object->compute_bounds(false);
+  }
+
+  EXPECT_TRUE(bvh->can_refit_objects(objects));
+  bvh->refit(progress);
+
+  EXPECT_EQ(bvh->pack.nodes.size(), num_nodes);
+  EXPECT_EQ(bvh->pack.leaf_nodes.size(), num_leaf_nodes);
+  EXPECT_EQ(bvh->pack.prim_index.size(), num_prims);
+
+  BoundBox scene_bounds = BoundBox::empty;
+  for (Object *object : objects) {
+    scene_bounds.grow(object->bounds);
+  }
+  expect_bounds_near(root_bounds(bvh), scene_bounds);
+
+  /* Geometry that is no longer instanced needs a rebuild. */
+  applied_mesh.transform_applied = false;
+  EXPECT_FALSE(bvh->can_refit_objects(objects));
+
+  delete bvh;
+}
+
+CCL_NAMESPACE_END
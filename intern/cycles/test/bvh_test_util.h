@@ -0,0 +1,38 @@
+/* SPDX-License-Identifier: Apache-2.0
+ * Copyright 2011-2022 Blender Foundation */
+
+#ifndef __BVH_TEST_UTIL_H__
+#define __BVH_TEST_UTIL_H__
+
+#include "scene/mesh.h"
+
+CCL_NAMESPACE_BEGIN
+
+/* Grid of size x size quads with some height variation, two triangles per quad. */
+inline void build_grid_mesh(Mesh *mesh, const int size)
+{
+  mesh->reserve_mesh((size + 1) * (size + 1), size * size * 2);
+
+  for (int y = 0; y <= size; y++) {
+    for (int x = 0; x <= size; x++) {
+      mesh->add_vertex(make_float3(x, y, 0.1f * ((x * 7 + y * 3) % 5)));
+    }
+  }
+
+  for (int y = 0; y < size; y++) {
+    for (int x = 0; x < size; x++) {
+      const int v0 = y * (size + 1) + x;
+      const int v1 = v0 + 1;
+      const int v2 = v1 + size + 1;
+      const int v3 = v0 + size + 1;
+      mesh->add_triangle(v0, v1, v2, 0, false);
+      mesh->add_triangle(v0, v2, v3, 0, false);
+    }
+  }
+
+  mesh->compute_bounds();
+}
+
+CCL_NAMESPACE_END
+
+#endif /* __BVH_TEST_UTIL_H__ */
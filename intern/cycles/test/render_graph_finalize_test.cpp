@@ -1107,6 +1107,46 @@ TEST_F(RenderGraph, constant_fold_part_math_mul_0)
   graph.finalize(scene);
 }
 
+/*
+ * Tests: fusing Math Mul into Math Add, unless the product is used by other nodes.
+ */
+TEST_F(RenderGraph, constant_fold_math_fuse_multiply_add)
+{
+  EXPECT_ANY_MESSAGE(log);
+  CORRECT_INFO_MESSAGE(log, "Fusing Mul::Value into multiply add Add.");
+  INVALID_INFO_MESSAGE(log, "Fusing SharedMul::");
+
+  builder.add_attribute("Attribute")
+      .add_node(ShaderNodeBuilder<MathNode>(graph, "Mul")
+                    .set_param("math_type", NODE_MATH_MULTIPLY)
+                    .set_param("use_clamp", false)
+                    .set("Value2", 2.0f))
+      .add_connection("Attribute::Fac", "Mul::Value1")
+      .add_node(ShaderNodeBuilder<MathNode>(graph, "Add")
+                    .set_param("math_type", NODE_MATH_ADD)
+                    .set_param("use_clamp", false)
+                    .set("Value1", 0.5f))
+      .add_connection("Mul::Value", "Add::Value2")
+      .add_node(ShaderNodeBuilder<MathNode>(graph, "SharedMul")
+                    .set_param("math_type", NODE_MATH_MULTIPLY)
+                    .set_param("use_clamp", false)
+                    .set("Value2", 3.0f))
+      .add_connection("Attribute::Fac", "SharedMul::Value1")
+      .add_node(ShaderNodeBuilder<MathNode>(graph, "SharedAdd")
+                    .set_param("math_type", NODE_MATH_ADD)
+                    .set_param("use_clamp", false))
+      .add_connection("SharedMul::Value", "SharedAdd::Value1")
+      .add_connection("SharedMul::Value", "SharedAdd::Value2")
+      .add_node(ShaderNodeBuilder<MathNode>(graph, "Out")
+                    .set_param("math_type", NODE_MATH_ADD)
+                    .set_param("use_clamp", false))
+      .add_connection("Add::Value", "Out::Value1")
+      .add_connection("SharedAdd::Value", "Out::Value2")
+      .output_value("Out::Value");
+
+  graph.finalize(scene);
+}
+
 /*
  * Tests: partial folding for Math Div with known 0.
  */
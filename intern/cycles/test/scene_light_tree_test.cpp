@@ -0,0 +1,184 @@
+/* SPDX-License-Identifier: Apache-2.0
+ * Copyright 2011-2022 Blender Foundation */
+
+#include "testing/testing.h"
+
+#include "scene_test_util.h"
+
+#include "scene/light.h"
+#include "scene/light_tree.h"
+
+#include "util/task.h"
+#include "util/vector.h"
+
+CCL_NAMESPACE_BEGIN
+
+namespace {
+
+/* Grid of size x size point lights with varying strength. */
+void add_point_lights(Scene *scene, const int size)
+{
+  for (int y = 0; y < size; y++) {
+    for (int x = 0; x < size; x++) {
+      Light *light = scene->create_node<Light>();
+      light->set_light_type(LIGHT_POINT);
+      light->set_co(make_float3(x, y, 0.1f * ((x * 7 + y * 3) % 5)));
+      light->set_dir(make_float3(0.0f, 0.0f, -1.0f));
+      light->set_size(0.1f);
+      light->set_strength(make_float3(1.0f + (x + y) % 3));
+      light->set_shader(NULL);
+    }
+  }
+}
+
+vector<LightTreePrimitive> create_light_prims(Scene *scene)
+{
+  vector<LightTreePrimitive> prims;
+  for (int i = 0; i < scene->lights.size(); i++) {
+    prims.emplace_back(scene, ~i, i);
+  }
+  return prims;
+}
+
+bool bounds_contain(const BoundBox &a, const BoundBox &b)
+{
+  return a.min.x <= b.min.x && a.min.y <= b.min.y && a.min.z <= b.min.z && a.max.x >= b.max.x &&
+         a.max.y >= b.max.y && a.max.z >= b.max.z;
+}
+
+/* Check that every node bounds its children and primitives, skipping the root node. */
+void expect_nodes_bound_prims(const LightTree &tree, const vector<LightTreePrimitive> &prims)
+{
+  const vector<LightTreeNode> &nodes = tree.get_nodes();
+  for (int index = nodes.size() - 1; index > 0; index--) {
+    const LightTreeNode &node = nodes[index];
+    if (node.is_leaf()) {
+      for (int i = node.first_prim_index; i < node.first_prim_index + node.num_prims; i++) {
+        EXPECT_TRUE(bounds_contain(node.bbox, prims[i].bbox));
+      }
+    }
+    else {
+      EXPECT_TRUE(bounds_contain(node.bbox, nodes[index + 1].bbox));
+      EXPECT_TRUE(bounds_contain(node.bbox, nodes[node.right_child_index].bbox));
+      EXPECT_NEAR(node.energy,
+                  nodes[index + 1].energy + nodes[node.right_child_index].energy,
+                  1e-3f * node.energy);
+    }
+  }
+}
+
+}  // namespace
+
+class LightTreeTest : public SceneTest {
+ protected:
+  virtual void SetUp()
+  {
+    SceneTest::SetUp();
+    /* Large enough to build subtrees in parallel. */
+    add_point_lights(scene, 100);
+  }
+};
+
+TEST_F(LightTreeTest, independent_of_thread_count)
+{
+  TaskScheduler::init(1);
+  vector<LightTreePrimitive> prims_single = create_light_prims(scene);
+  LightTree tree_single(prims_single, 0, 8);
+  TaskScheduler::exit();
+
+  TaskScheduler::init(0);
+  vector<LightTreePrimitive> prims_multi = create_light_prims(scene);
+  LightTree tree_multi(prims_multi, 0, 8);
+  TaskScheduler::exit();
+
+  const vector<LightTreeNode> &nodes_single = tree_single.get_nodes();
+  const vector<LightTreeNode> &nodes_multi = tree_multi.get_nodes();
+  ASSERT_EQ(nodes_single.size(), nodes_multi.size());
+  for (int i = 0; i < nodes_single.size(); i++) {
+    EXPECT_EQ(nodes_single[i].num_prims, nodes_multi[i].num_prims);
+    EXPECT_EQ(nodes_single[i].bit_trail, nodes_multi[i].bit_trail);
+    /* Also compares the index of the right child of interior nodes. */
+    EXPECT_EQ(nodes_single[i].first_prim_index, nodes_multi[i].first_prim_index);
+  }
+
+  ASSERT_EQ(prims_single.size(), prims_multi.size());
+  for (int i = 0; i < prims_single.size(); i++) {
+    EXPECT_EQ(prims_single[i].prim_id, prims_multi[i].prim_id);
+  }
+}
+
+TEST_F(LightTreeTest, refit_moved_lights)
+{
+  TaskScheduler::init(0);
+
+  vector<LightTreePrimitive> prims = create_light_prims(scene);
+  LightTree tree(prims, 0, 8);
+  const vector<LightTreeNode> nodes = tree.get_nodes();
+
+  /* Move a few lights a small distance and change the strength of another. */
+  for (int i = 0; i < scene->lights.size(); i += 97) {
+    Light *light = scene->lights[i];
+    light->set_co(light->get_co() + make_float3(0.3f, -0.2f, 0.5f));
+  }
+  scene->lights[5]->set_strength(make_float3(10.0f));
+
+  vector<LightTreePrimitive> moved_prims = create_light_prims(scene);
+  EXPECT_TRUE(tree.refit(moved_prims, 0));
+
+  /* Same structure and primitive order as the original build. */
+  const vector<LightTreeNode> &refit_nodes = tree.get_nodes();
+  ASSERT_EQ(refit_nodes.size(), nodes.size());
+  for (int i = 0; i < nodes.size(); i++) {
+    EXPECT_EQ(refit_nodes[i].num_prims, nodes[i].num_prims);
+    EXPECT_EQ(refit_nodes[i].first_prim_index, nodes[i].first_prim_index);
+  }
+  ASSERT_EQ(moved_prims.size(), prims.size());
+  for (int i = 0; i < prims.size(); i++) {
+    EXPECT_EQ(moved_prims[i].prim_id, prims[i].prim_id);
+  }
+
+  expect_nodes_bound_prims(tree, moved_prims);
+
+  /* Spreading lights far apart makes the tree inefficient. */
+  for (int i = 0; i < scene->lights.size(); i += 2) {
+    Light *light = scene->lights[i];
+    light->set_co(light->get_co() + make_float3(0.0f, 0.0f, 1000.0f));
+  }
+  vector<LightTreePrimitive> spread_prims = create_light_prims(scene);
+  EXPECT_FALSE(tree.refit(spread_prims, 0));
+
+  /* Primitives stay in input order, so the rebuilt tree can be refitted on the next update. */
+  for (int i = 0; i < spread_prims.size(); i++) {
+    EXPECT_EQ(spread_prims[i].prim_id, ~i);
+  }
+  LightTree rebuilt_tree(spread_prims, 0, 8);
+  vector<LightTreePrimitive> next_prims = create_light_prims(scene);
+  EXPECT_TRUE(rebuilt_tree.refit(next_prims, 0));
+  for (int i = 0; i < next_prims.size(); i++) {
+    EXPECT_EQ(next_prims[i].prim_id, spread_prims[i].prim_id);
+  }
+
+  /* Different emitters need a rebuild. */
+  vector<LightTreePrimitive> fewer_prims = create_light_prims(scene);
+  fewer_prims.pop_back();
+  EXPECT_FALSE(tree.refit(fewer_prims, 0));
+
+  TaskScheduler::exit();
+}
+
+TEST_F(LightTreeTest, refit_changed_distant_lights)
+{
+  TaskScheduler::init(0);
+
+  vector<LightTreePrimitive> prims = create_light_prims(scene);
+  LightTree tree(prims, 0, 8);
+
+  /* Same emitters, but the last one became a distant light, which belongs to another node. */
+  scene->lights.back()->set_light_type(LIGHT_DISTANT);
+  vector<LightTreePrimitive> distant_prims = create_light_prims(scene);
+  EXPECT_FALSE(tree.refit(distant_prims, 1));
+
+  TaskScheduler::exit();
+}
+
+CCL_NAMESPACE_END
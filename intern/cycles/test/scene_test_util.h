@@ -0,0 +1,43 @@
+/* SPDX-License-Identifier: Apache-2.0
+ * Copyright 2011-2023 Blender Foundation */
+
+#ifndef __SCENE_TEST_UTIL_H__
+#define __SCENE_TEST_UTIL_H__
+
+#include "testing/testing.h"
+
+#include "device/device.h"
+
+#include "scene/scene.h"
+
+#include "util/profiling.h"
+#include "util/stats.h"
+
+CCL_NAMESPACE_BEGIN
+
+/* Fixture with an empty scene on the CPU device. */
+class SceneTest : public testing::Test {
+ protected:
+  Stats stats;
+  Profiler profiler;
+  DeviceInfo device_info;
+  Device *device_cpu;
+  SceneParams scene_params;
+  Scene *scene;
+
+  virtual void SetUp()
+  {
+    device_cpu = Device::create(device_info, stats, profiler);
+    scene = new Scene(scene_params, device_cpu);
+  }
+
+  virtual void TearDown()
+  {
+    delete scene;
+    delete device_cpu;
+  }
+};
+
+CCL_NAMESPACE_END
+
+#endif /* __SCENE_TEST_UTIL_H__ */
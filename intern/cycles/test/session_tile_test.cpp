@@ -0,0 +1,127 @@
+/* SPDX-License-Identifier: Apache-2.0
+ * Copyright 2011-2023 Blender Foundation */
+
+#include "testing/testing.h"
+
+#include "scene_test_util.h"
+
+#include <OpenImageIO/filesystem.h>
+
+#include "device/denoise.h"
+
+#include "scene/pass.h"
+
+#include "session/buffers.h"
+#include "session/tile.h"
+
+#include "util/path.h"
+
+CCL_NAMESPACE_BEGIN
+
+namespace {
+
+/* Value of a combined pass channel accumulated over the given number of samples, outside of the
+ * half float range unless divided by the number of samples. */
+float combined_value(const int x, const int y, const int channel, const int samples)
+{
+  return samples * (0.1f + 0.37f * x + 0.53f * y + 0.71f * channel);
+}
+
+/* Sample count which can't be represented exactly as half float. */
+float sample_count_value(const int x, const int y)
+{
+  return float(100000 + x * 7 + y);
+}
+
+}  // namespace
+
+using TileManagerTest = SceneTest;
+
+TEST_F(TileManagerTest, half_float_round_trip)
+{
+  Pass *combined = scene->create_node<Pass>();
+  combined->set_type(PASS_COMBINED);
+  Pass *sample_count = scene->create_node<Pass>();
+  sample_count->set_type(PASS_SAMPLE_COUNT);
+
+  const int samples = 1024;
+  BufferParams params;
+  params.width = params.window_width = params.full_width = 150;
+  params.height = params.window_height = params.full_height = 70;
+  params.samples = samples;
+  params.update_passes(scene->passes);
+
+  TileManager tile_manager;
+  string filename;
+  tile_manager.full_buffer_written_cb = [&](string_view written_filename) {
+    filename = written_filename;
+  };
+  tile_manager.set_temp_dir(OIIO::Filesystem::temp_directory_path());
+  tile_manager.set_use_half_float(true);
+  tile_manager.reset_scheduling(params, make_int2(64, 64));
+  tile_manager.update(params, scene);
+  ASSERT_TRUE(tile_manager.has_multiple_tiles());
+
+  const int combined_offset = params.get_pass_offset(PASS_COMBINED);
+  const int sample_count_offset = params.get_pass_offset(PASS_SAMPLE_COUNT);
+
+  /* Write tiles the way the session does, with overscan if any. */
+  while (tile_manager.next()) {
+    const Tile &tile = tile_manager.get_current_tile();
+
+    BufferParams tile_params = params;
+    tile_params.width = tile.width;
+    tile_params.height = tile.height;
+    tile_params.window_x = tile.window_x;
+    tile_params.window_y = tile.window_y;
+    tile_params.window_width = tile.window_width;
+    tile_params.window_height = tile.window_height;
+    tile_params.full_x = tile.x + params.full_x;
+    tile_params.full_y = tile.y + params.full_y;
+    tile_params.update_offset_stride();
+
+    RenderBuffers tile_buffers(device_cpu);
+    tile_buffers.reset(tile_params);
+    float *pixel = tile_buffers.buffer.data();
+    for (int y = 0; y < tile.height; y++) {
+      for (int x = 0; x < tile.width; x++) {
+        for (int channel = 0; channel < 4; channel++) {
+          pixel[combined_offset + channel] = combined_value(
+              tile.x + x, tile.y + y, channel, samples);
+        }
+        pixel[sample_count_offset] = sample_count_value(tile.x + x, tile.y + y);
+        pixel += tile_params.pass_stride;
+      }
+    }
+
+    ASSERT_TRUE(tile_manager.write_tile(tile_buffers));
+  }
+  ASSERT_TRUE(tile_manager.finish_write_tiles());
+  ASSERT_FALSE(filename.empty());
+
+  RenderBuffers buffers(device_cpu);
+  DenoiseParams denoise_params;
+  const bool is_read = tile_manager.read_full_buffer_from_disk(
+      filename, &buffers, &denoise_params);
+  path_remove(filename);
+  ASSERT_TRUE(is_read);
+  ASSERT_EQ(buffers.params.width, params.width);
+  ASSERT_EQ(buffers.params.height, params.height);
+  ASSERT_EQ(buffers.params.pass_stride, params.pass_stride);
+
+  /* Combined pass is stored as half float, within its relative precision once scaled back.
+   * The sample count pass is stored as float and must be exact. */
+  const float *pixel = buffers.buffer.data();
+  for (int y = 0; y < params.height; y++) {
+    for (int x = 0; x < params.width; x++) {
+      for (int channel = 0; channel < 4; channel++) {
+        const float expected = combined_value(x, y, channel, samples);
+        EXPECT_NEAR(pixel[combined_offset + channel], expected, expected * 1e-3f);
+      }
+      EXPECT_EQ(pixel[sample_count_offset], sample_count_value(x, y));
+      pixel += params.pass_stride;
+    }
+  }
+}
+
+CCL_NAMESPACE_END
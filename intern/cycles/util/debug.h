@@ -51,6 +51,11 @@ class DebugFlags {
      * CPUs and GPUs can be selected here instead.
      */
     BVHLayout bvh_layout = BVH_LAYOUT_AUTO;
+
+    /* Render batches of neighboring pixels together, tracing camera rays as packets and
+     * sorting surface shading by shader, instead of tracing each path from start to end before
+     * moving on to the next pixel. */
+    bool use_wavefront = false;
   };
 
   /* Descriptor of CUDA feature-set to be used. */
@@ -30,16 +30,27 @@ void Profiler::run()
 
       /* The state reads/writes should be atomic, but just to be sure
        * check the values for validity anyways. */
-      if (cur_event < PROFILING_NUM_EVENTS) {
+      const bool valid_event = (cur_event < PROFILING_NUM_EVENTS);
+      if (valid_event) {
         event_samples[cur_event]++;
       }
 
       if (cur_shader >= 0 && cur_shader < shader_samples.size()) {
         shader_samples[cur_shader]++;
+        if (valid_event) {
+          shader_event_samples[cur_shader * PROFILING_NUM_EVENTS + cur_event]++;
+        }
       }
 
       if (cur_object >= 0 && cur_object < object_samples.size()) {
         object_samples[cur_object]++;
+        if (valid_event) {
+          vector<uint64_t> &samples = object_event_samples[cur_object];
+          if (samples.empty()) {
+            samples.resize(PROFILING_NUM_EVENTS, 0);
+          }
+          samples[cur_event]++;
+        }
       }
     }
     lock.unlock();
@@ -68,6 +79,9 @@ void Profiler::reset(int num_shaders, int num_objects)
   shader_samples.assign(num_shaders, 0);
   object_samples.assign(num_objects, 0);
 
+  shader_event_samples.assign(num_shaders * PROFILING_NUM_EVENTS, 0);
+  object_event_samples.clear();
+
   if (running) {
     start();
   }
@@ -158,6 +172,22 @@ bool Profiler::get_object(int object, uint64_t &samples, uint64_t &hits)
   return true;
 }
 
+uint64_t Profiler::get_shader_event(int shader, ProfilingEvent event)
+{
+  assert(worker == NULL);
+  return shader_event_samples[shader * PROFILING_NUM_EVENTS + event];
+}
+
+uint64_t Profiler::get_object_event(int object, ProfilingEvent event)
+{
+  assert(worker == NULL);
+  unordered_map<int, vector<uint64_t>>::const_iterator it = object_event_samples.find(object);
+  if (it == object_event_samples.end()) {
+    return 0;
+  }
+  return it->second[event];
+}
+
 bool Profiler::active() const
 {
   return (worker != nullptr);
@@ -83,6 +83,10 @@ class Profiler {
   bool get_shader(int shader, uint64_t &samples, uint64_t &hits);
   bool get_object(int object, uint64_t &samples, uint64_t &hits);
 
+  /* Samples of the shader or object while the worker was in the given event. */
+  uint64_t get_shader_event(int shader, ProfilingEvent event);
+  uint64_t get_object_event(int object, ProfilingEvent event);
+
   bool active() const;
 
  protected:
@@ -95,6 +99,13 @@ class Profiler {
   vector<uint64_t> shader_samples;
   vector<uint64_t> object_samples;
 
+  /* Breakdown of the shader and object samples by event, to tell apart for example shader
+   * evaluation and light sampling. Shader samples are stored for every event of every shader.
+   * Scenes can contain millions of objects of which only few are sampled, so their samples are
+   * only stored for sampled objects. */
+  vector<uint64_t> shader_event_samples;
+  unordered_map<int, vector<uint64_t>> object_event_samples;
+
   /* Tracks the total amounts every object/shader was hit.
    * Used to evaluate relative cost, written by the render thread.
    * Indexed by the shader and object IDs that the kernel also uses
@@ -39,6 +39,8 @@ typedef enum ImageDataType {
   IMAGE_DATA_TYPE_NANOVDB_FLOAT3 = 9,
   IMAGE_DATA_TYPE_NANOVDB_FPN = 10,
   IMAGE_DATA_TYPE_NANOVDB_FP16 = 11,
+  /* Image file streamed through the texture cache, CPU only. */
+  IMAGE_DATA_TYPE_TEXTURE_CACHE = 12,
 
   IMAGE_DATA_NUM_TYPES
 } ImageDataType;
@@ -85,6 +87,16 @@ typedef struct TextureInfo {
   Transform transform_3d;
 } TextureInfo;
 
+#ifndef __KERNEL_GPU__
+/* Image looked up through the host side texture cache. The texture info data points to this
+ * handle, the lookup function filters the image with the given texture coordinate derivatives
+ * to select the MIP level. */
+typedef struct TextureCacheImageHandle {
+  const void *image;
+  float4 (*lookup)(const void *image, float x, float y, float2 dx, float2 dy);
+} TextureCacheImageHandle;
+#endif
+
 CCL_NAMESPACE_END
 
 #endif /* __UTIL_TEXTURE_H__ */
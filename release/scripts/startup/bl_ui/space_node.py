@@ -761,6 +761,10 @@ class NODE_PT_quality(bpy.types.Panel):
         col = layout.column()
         if prefs.experimental.use_full_frame_compositor:
             col.prop(tree, "execution_mode")
+            if tree.execution_mode == 'FULL_FRAME':
+                col.prop(tree, "max_memory")
+                col.prop(tree, "cache_memory")
+                col.prop(tree, "use_half_buffers")
 
         col.prop(tree, "render_quality", text="Render")
         col.prop(tree, "edit_quality", text="Edit")
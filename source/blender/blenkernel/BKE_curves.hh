@@ -301,6 +301,8 @@ class CurvesGeometry : public ::CurvesGeometry {
    */
   Span<float> evaluated_lengths_for_curve(int curve_index, bool cyclic) const;
   float evaluated_length_total_for_curve(int curve_index, bool cyclic) const;
+  /** Return the slice of #evaluated_length_cache that corresponds to this curve index. */
+  IndexRange lengths_range_for_curve(int curve_index, bool cyclic) const;
 
   /** Calculates the data described by #evaluated_lengths_for_curve if necessary. */
   void ensure_evaluated_lengths() const;
@@ -326,9 +328,6 @@ class CurvesGeometry : public ::CurvesGeometry {
    */
   void ensure_nurbs_basis_cache() const;
 
-  /** Return the slice of #evaluated_length_cache that corresponds to this curve index. */
-  IndexRange lengths_range_for_curve(int curve_index, bool cyclic) const;
-
   /* --------------------------------------------------------------------
    * Operations.
    */
@@ -342,6 +341,12 @@ class CurvesGeometry : public ::CurvesGeometry {
 
   /** Call after deforming the position attribute. */
   void tag_positions_changed();
+  /**
+   * Call after deforming the positions of only some curves. Evaluated data that is already cached
+   * is updated for these curves only, instead of being recomputed for all curves. The topology
+   * must not have changed.
+   */
+  void tag_positions_changed(IndexMask curves);
   /**
    * Call after any operation that changes the topology
    * (number of points, evaluated points, or the total count).
@@ -685,6 +690,22 @@ void interpolate_to_evaluated(const GSpan src,
                               const OffsetIndices<int> evaluated_offsets,
                               GMutableSpan dst);
 
+/**
+ * Calculate the basis weights of every evaluated point in a segment with the given resolution.
+ * The weights only depend on the resolution, so they can be shared between all segments of all
+ * curves with the same resolution, instead of being recalculated for every evaluated point.
+ */
+void calculate_basis_weights(int resolution, MutableSpan<float4> r_weights);
+
+/**
+ * Evaluate the Catmull Rom curve, like the function above, but with basis weights precomputed
+ * with #calculate_basis_weights. The size of #basis_weights is the resolution of the curve.
+ */
+void interpolate_to_evaluated(GSpan src,
+                              bool cyclic,
+                              Span<float4> basis_weights,
+                              GMutableSpan dst);
+
 void calculate_basis(const float parameter, float4 &r_weights);
 
 /**
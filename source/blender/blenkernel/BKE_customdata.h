@@ -361,6 +361,24 @@ void CustomData_interp(const struct CustomData *source,
                        const float *sub_weights,
                        int count,
                        int dest_index);
+/**
+ * Interpolate \a dest_num consecutive destination items at once, starting at \a dest_index.
+ * Every destination item is interpolated from the same number of source items, whose indices and
+ * weights are stored contiguously: destination item `i` uses the \a sources_num values starting
+ * at `src_indices[i * sources_num]` and `weights[i * sources_num]`.
+ *
+ * This is much faster than calling #CustomData_interp for every item, since layers are processed
+ * one after another and common attribute types don't go through their generic callbacks.
+ *
+ * \param weights: If NULL, the source values are averaged.
+ */
+void CustomData_interp_batch(const struct CustomData *source,
+                             struct CustomData *dest,
+                             const int *src_indices,
+                             const float *weights,
+                             int sources_num,
+                             int dest_index,
+                             int dest_num);
 /**
  * \note src_blocks_ofs & dst_block_ofs
  * must be pointers to the data, offset by layer->offset already.
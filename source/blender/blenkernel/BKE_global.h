@@ -204,8 +204,9 @@ enum {
   G_DEBUG_XR = (1 << 20),                     /* XR/OpenXR messages */
   G_DEBUG_XR_TIME = (1 << 21),                /* XR/OpenXR timing messages */
 
-  G_DEBUG_GHOST = (1 << 22),  /* Debug GHOST module. */
-  G_DEBUG_WINTAB = (1 << 23), /* Debug Wintab. */
+  G_DEBUG_GHOST = (1 << 22),      /* Debug GHOST module. */
+  G_DEBUG_WINTAB = (1 << 23),     /* Debug Wintab. */
+  G_DEBUG_COMPOSITOR = (1 << 24), /* Compositor execution timing statistics. */
 };
 
 #define G_DEBUG_ALL \
@@ -183,6 +183,14 @@ typedef struct Subdiv {
      * In total this array has a size of `num base faces + 1`.
      */
     int *face_ptex_offset;
+    /* Indices of coarse mesh vertices which are used by faces, in the order in which the
+     * topology refiner expects them (loose vertices are skipped). Allows to only copy positions
+     * when the topology did not change, without traversing coarse faces on every update.
+     *
+     * Only valid for a coarse mesh with `coarse_vertex_map_num_verts` vertices. */
+    int *coarse_vertex_map;
+    int coarse_vertex_map_num_verts;
+    int coarse_vertex_map_len;
   } cache_;
 } Subdiv;
 
@@ -16,6 +16,7 @@ extern "C" {
 struct Mesh;
 struct OpenSubdiv_EvaluatorCache;
 struct OpenSubdiv_EvaluatorSettings;
+struct OpenSubdiv_PatchCoord;
 struct Subdiv;
 
 typedef enum eSubdivEvaluatorType {
@@ -95,6 +96,19 @@ void BKE_subdiv_eval_displacement(struct Subdiv *subdiv,
 void BKE_subdiv_eval_final_point(
     struct Subdiv *subdiv, int ptex_face_index, float u, float v, float r_P[3]);
 
+/* Batched queries. */
+
+/* Evaluate points at a limit surface for all given patch coordinates, with optional derivatives.
+ * The evaluation is split into chunks which are evaluated in parallel.
+ *
+ * NOTE: Output arrays must contain `num_patch_coords` elements. */
+void BKE_subdiv_eval_limit_patches(struct Subdiv *subdiv,
+                                   const struct OpenSubdiv_PatchCoord *patch_coords,
+                                   int num_patch_coords,
+                                   float (*r_P)[3],
+                                   float (*r_dPdu)[3],
+                                   float (*r_dPdv)[3]);
+
 #ifdef __cplusplus
 }
 #endif
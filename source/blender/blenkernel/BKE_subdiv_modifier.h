@@ -59,6 +59,17 @@ SubdivSettings BKE_subsurf_modifier_settings_init(const struct SubsurfModifierDa
 
 bool BKE_subsurf_modifier_runtime_init(struct SubsurfModifierData *smd, bool use_render_params);
 
+/**
+ * Choose the number of subdivision levels used for rendering when adaptive render levels are
+ * enabled: the coarse edges are subdivided until they are about `adaptive_pixel_size` pixels long
+ * as seen from the scene camera, at the part of the object which is closest to the camera.
+ * The render levels of the modifier are used as the upper bound.
+ */
+int BKE_subsurf_modifier_adaptive_render_levels(const struct SubsurfModifierData *smd,
+                                                const struct Scene *scene,
+                                                const struct Object *ob,
+                                                const struct Mesh *mesh);
+
 bool BKE_subsurf_modifier_use_custom_loop_normals(const struct SubsurfModifierData *smd,
                                                   const struct Mesh *mesh);
 
@@ -4,6 +4,7 @@
  * \ingroup bke
  */
 
+#include "BLI_array.hh"
 #include "BLI_task.hh"
 
 #include "BKE_attribute_math.hh"
@@ -33,6 +34,15 @@ void calculate_basis(const float parameter, float4 &r_weights)
   r_weights[3] = -s * t * t;
 }
 
+void calculate_basis_weights(const int resolution, MutableSpan<float4> r_weights)
+{
+  BLI_assert(r_weights.size() == resolution);
+  const float step = 1.0f / resolution;
+  for (const int i : IndexRange(resolution)) {
+    calculate_basis(i * step, r_weights[i]);
+  }
+}
+
 template<typename T>
 static void evaluate_segment(const T &a, const T &b, const T &c, const T &d, MutableSpan<T> dst)
 {
@@ -43,15 +53,38 @@ static void evaluate_segment(const T &a, const T &b, const T &c, const T &d, Mut
   }
 }
 
+/** Same as #interpolate, with the basis weights of each evaluated point calculated already. */
+template<typename T>
+static void evaluate_segment(const T &a,
+                             const T &b,
+                             const T &c,
+                             const T &d,
+                             const Span<float4> basis_weights,
+                             MutableSpan<T> dst)
+{
+  BLI_assert(dst.size() == basis_weights.size());
+  dst.first() = b;
+  for (const int i : dst.index_range().drop_front(1)) {
+    if constexpr (is_same_any_v<T, float, float2, float3>) {
+      dst[i] = 0.5f * attribute_math::mix4<T>(basis_weights[i], a, b, c, d);
+    }
+    else {
+      dst[i] = attribute_math::mix4<T>(basis_weights[i] * 0.5f, a, b, c, d);
+    }
+  }
+}
+
 /**
  * \param range_fn: Returns an index range describing where in the #dst span each segment should be
  * evaluated to, and how many points to add to it. This is used to avoid the need to allocate an
  * actual offsets array in typical evaluation use cases where the resolution is per-curve.
+ * \param segment_fn: Evaluates a single segment from its four control point values.
  */
-template<typename T, typename RangeForSegmentFn>
+template<typename T, typename RangeForSegmentFn, typename EvaluateSegmentFn>
 static void interpolate_to_evaluated(const Span<T> src,
                                      const bool cyclic,
                                      const RangeForSegmentFn &range_fn,
+                                     const EvaluateSegmentFn &segment_fn,
                                      MutableSpan<T> dst)
 
 {
@@ -68,10 +101,10 @@ static void interpolate_to_evaluated(const Span<T> src,
   const IndexRange first = range_fn(0);
 
   if (src.size() == 2) {
-    evaluate_segment(src.first(), src.first(), src.last(), src.last(), dst.slice(first));
+    segment_fn(src.first(), src.first(), src.last(), src.last(), dst.slice(first));
     if (cyclic) {
       const IndexRange last = range_fn(1);
-      evaluate_segment(src.last(), src.last(), src.first(), src.first(), dst.slice(last));
+      segment_fn(src.last(), src.last(), src.first(), src.first(), dst.slice(last));
     }
     else {
       dst.last() = src.last();
@@ -82,13 +115,13 @@ static void interpolate_to_evaluated(const Span<T> src,
   const IndexRange second_to_last = range_fn(src.index_range().last(1));
   const IndexRange last = range_fn(src.index_range().last());
   if (cyclic) {
-    evaluate_segment(src.last(), src[0], src[1], src[2], dst.slice(first));
-    evaluate_segment(src.last(2), src.last(1), src.last(), src.first(), dst.slice(second_to_last));
-    evaluate_segment(src.last(1), src.last(), src[0], src[1], dst.slice(last));
+    segment_fn(src.last(), src[0], src[1], src[2], dst.slice(first));
+    segment_fn(src.last(2), src.last(1), src.last(), src.first(), dst.slice(second_to_last));
+    segment_fn(src.last(1), src.last(), src[0], src[1], dst.slice(last));
   }
   else {
-    evaluate_segment(src[0], src[0], src[1], src[2], dst.slice(first));
-    evaluate_segment(src.last(2), src.last(1), src.last(), src.last(), dst.slice(second_to_last));
+    segment_fn(src[0], src[0], src[1], src[2], dst.slice(first));
+    segment_fn(src.last(2), src.last(1), src.last(), src.last(), dst.slice(second_to_last));
     /* For non-cyclic curves, the last segment should always just have a single point. We could
      * assert that the size of the provided range is 1 here, but that would require specializing
      * the #range_fn implementation for the last point, which may have a performance cost. */
@@ -100,7 +133,7 @@ static void interpolate_to_evaluated(const Span<T> src,
   threading::parallel_for(inner_range, 512, [&](IndexRange range) {
     for (const int i : range) {
       const IndexRange segment = range_fn(i);
-      evaluate_segment(src[i - 1], src[i], src[i + 1], src[i + 2], dst.slice(segment));
+      segment_fn(src[i - 1], src[i], src[i + 1], src[i + 2], dst.slice(segment));
     }
   });
 }
@@ -108,10 +141,11 @@ static void interpolate_to_evaluated(const Span<T> src,
 template<typename T>
 static void interpolate_to_evaluated(const Span<T> src,
                                      const bool cyclic,
-                                     const int resolution,
+                                     const Span<float4> basis_weights,
                                      MutableSpan<T> dst)
 
 {
+  const int resolution = basis_weights.size();
   BLI_assert(dst.size() == calculate_evaluated_num(src.size(), cyclic, resolution));
   interpolate_to_evaluated(
       src,
@@ -119,9 +153,25 @@ static void interpolate_to_evaluated(const Span<T> src,
       [resolution](const int segment_i) -> IndexRange {
         return {segment_i * resolution, resolution};
       },
+      [basis_weights](const T &a, const T &b, const T &c, const T &d, MutableSpan<T> dst) {
+        evaluate_segment(a, b, c, d, basis_weights, dst);
+      },
       dst);
 }
 
+template<typename T>
+static void interpolate_to_evaluated(const Span<T> src,
+                                     const bool cyclic,
+                                     const int resolution,
+                                     MutableSpan<T> dst)
+
+{
+  /* Only calculate the basis weights once for all segments of the curve. */
+  Array<float4, 32> basis_weights(resolution);
+  calculate_basis_weights(resolution, basis_weights);
+  interpolate_to_evaluated(src, cyclic, basis_weights.as_span(), dst);
+}
+
 template<typename T>
 static void interpolate_to_evaluated(const Span<T> src,
                                      const bool cyclic,
@@ -135,6 +185,9 @@ static void interpolate_to_evaluated(const Span<T> src,
       [evaluated_offsets](const int segment_i) -> IndexRange {
         return evaluated_offsets[segment_i];
       },
+      [](const T &a, const T &b, const T &c, const T &d, MutableSpan<T> dst) {
+        evaluate_segment(a, b, c, d, dst);
+      },
       dst);
 }
 
@@ -149,6 +202,17 @@ void interpolate_to_evaluated(const GSpan src,
   });
 }
 
+void interpolate_to_evaluated(const GSpan src,
+                              const bool cyclic,
+                              const Span<float4> basis_weights,
+                              GMutableSpan dst)
+{
+  attribute_math::convert_to_static_type(src.type(), [&](auto dummy) {
+    using T = decltype(dummy);
+    interpolate_to_evaluated(src.typed<T>(), cyclic, basis_weights, dst.typed<T>());
+  });
+}
+
 void interpolate_to_evaluated(const GSpan src,
                               const bool cyclic,
                               const OffsetIndices<int> evaluated_offsets,
@@ -602,6 +602,79 @@ void CurvesGeometry::ensure_nurbs_basis_cache() const
   });
 }
 
+static void calculate_evaluated_positions(const CurvesGeometry &curves,
+                                          const IndexMask curve_selection,
+                                          MutableSpan<float3> evaluated_positions)
+{
+  const bke::CurvesGeometryRuntime &runtime = *curves.runtime;
+  const OffsetIndices<int> points_by_curve = curves.points_by_curve();
+  const OffsetIndices<int> evaluated_points_by_curve = curves.evaluated_points_by_curve();
+  const VArray<int8_t> types = curves.curve_types();
+  const VArray<bool> cyclic = curves.cyclic();
+  const VArray<int> resolution = curves.resolution();
+  const Span<float3> positions = curves.positions();
+
+  const Span<float3> handle_positions_left = curves.handle_positions_left();
+  const Span<float3> handle_positions_right = curves.handle_positions_right();
+  const Span<int> all_bezier_offsets = runtime.evaluated_offsets_cache.data().all_bezier_offsets;
+
+  const VArray<int8_t> nurbs_orders = curves.nurbs_orders();
+  const Span<float> nurbs_weights = curves.nurbs_weights();
+  const Span<curves::nurbs::BasisCache> nurbs_basis_cache = runtime.nurbs_basis_cache.data();
+
+  threading::parallel_for(curve_selection.index_range(), 128, [&](IndexRange range) {
+    /* Catmull Rom basis weights only depend on the resolution, which is usually the same for
+     * many curves (e.g. hair), so reuse them for consecutive curves with the same resolution. */
+    Vector<float4, 32> catmull_rom_weights;
+    int catmull_rom_weights_resolution = -1;
+
+    for (const int curve_index : curve_selection.slice(range)) {
+      const IndexRange points = points_by_curve[curve_index];
+      const IndexRange evaluated_points = evaluated_points_by_curve[curve_index];
+
+      switch (types[curve_index]) {
+        case CURVE_TYPE_CATMULL_ROM: {
+          const int curve_resolution = resolution[curve_index];
+          if (curve_resolution != catmull_rom_weights_resolution) {
+            catmull_rom_weights.resize(curve_resolution);
+            curves::catmull_rom::calculate_basis_weights(curve_resolution, catmull_rom_weights);
+            catmull_rom_weights_resolution = curve_resolution;
+          }
+          curves::catmull_rom::interpolate_to_evaluated(
+              positions.slice(points),
+              cyclic[curve_index],
+              catmull_rom_weights.as_span(),
+              evaluated_positions.slice(evaluated_points));
+          break;
+        }
+        case CURVE_TYPE_POLY:
+          evaluated_positions.slice(evaluated_points).copy_from(positions.slice(points));
+          break;
+        case CURVE_TYPE_BEZIER: {
+          const IndexRange offsets = curves::per_curve_point_offsets_range(points, curve_index);
+          curves::bezier::calculate_evaluated_positions(
+              positions.slice(points),
+              handle_positions_left.slice(points),
+              handle_positions_right.slice(points),
+              all_bezier_offsets.slice(offsets),
+              evaluated_positions.slice(evaluated_points));
+          break;
+        }
+        case CURVE_TYPE_NURBS:
+          curves::nurbs::interpolate_to_evaluated(nurbs_basis_cache[curve_index],
+                                                  nurbs_orders[curve_index],
+                                                  nurbs_weights.slice_safe(points),
+                                                  positions.slice(points),
+                                                  evaluated_positions.slice(evaluated_points));
+          break;
+        default:
+          BLI_assert_unreachable();
+          break;
+      }
+    }
+  });
+}
+
 Span<float3> CurvesGeometry::evaluated_positions() const
 {
   const bke::CurvesGeometryRuntime &runtime = *this->runtime;
@@ -615,119 +688,70 @@ Span<float3> CurvesGeometry::evaluated_positions() const
 
     r_data.vector.resize(this->evaluated_points_num());
     r_data.span = r_data.vector;
-    MutableSpan<float3> evaluated_positions = r_data.vector;
-
-    const OffsetIndices<int> points_by_curve = this->points_by_curve();
-    const OffsetIndices<int> evaluated_points_by_curve = this->evaluated_points_by_curve();
-    const VArray<int8_t> types = this->curve_types();
-    const VArray<bool> cyclic = this->cyclic();
-    const VArray<int> resolution = this->resolution();
-    const Span<float3> positions = this->positions();
+    calculate_evaluated_positions(*this, this->curves_range(), r_data.vector);
+  });
+  return runtime.evaluated_position_cache.data().span;
+}
 
-    const Span<float3> handle_positions_left = this->handle_positions_left();
-    const Span<float3> handle_positions_right = this->handle_positions_right();
-    const Span<int> all_bezier_offsets = runtime.evaluated_offsets_cache.data().all_bezier_offsets;
+static void calculate_evaluated_tangents(const CurvesGeometry &curves,
+                                         const IndexMask curve_selection,
+                                         const Span<float3> evaluated_positions,
+                                         MutableSpan<float3> tangents)
+{
+  const OffsetIndices<int> evaluated_points_by_curve = curves.evaluated_points_by_curve();
+  const VArray<bool> cyclic = curves.cyclic();
 
-    const VArray<int8_t> nurbs_orders = this->nurbs_orders();
-    const Span<float> nurbs_weights = this->nurbs_weights();
-    const Span<curves::nurbs::BasisCache> nurbs_basis_cache = runtime.nurbs_basis_cache.data();
+  threading::parallel_for(curve_selection.index_range(), 128, [&](IndexRange range) {
+    for (const int curve_index : curve_selection.slice(range)) {
+      const IndexRange evaluated_points = evaluated_points_by_curve[curve_index];
+      curves::poly::calculate_tangents(evaluated_positions.slice(evaluated_points),
+                                       cyclic[curve_index],
+                                       tangents.slice(evaluated_points));
+    }
+  });
 
-    threading::parallel_for(this->curves_range(), 128, [&](IndexRange curves_range) {
-      for (const int curve_index : curves_range) {
-        const IndexRange points = points_by_curve[curve_index];
-        const IndexRange evaluated_points = evaluated_points_by_curve[curve_index];
+  /* Correct the first and last tangents of non-cyclic Bezier curves so that they align with
+   * the inner handles. This is a separate loop to avoid the cost when Bezier type curves are
+   * not used. */
+  if (!curves.has_curve_with_type(CURVE_TYPE_BEZIER)) {
+    return;
+  }
+  const VArray<int8_t> types = curves.curve_types();
+  const OffsetIndices<int> points_by_curve = curves.points_by_curve();
+  const Span<float3> positions = curves.positions();
+  const Span<float3> handles_left = curves.handle_positions_left();
+  const Span<float3> handles_right = curves.handle_positions_right();
+
+  threading::parallel_for(curve_selection.index_range(), 1024, [&](IndexRange range) {
+    for (const int curve_index : curve_selection.slice(range)) {
+      if (types[curve_index] != CURVE_TYPE_BEZIER || cyclic[curve_index]) {
+        continue;
+      }
+      const IndexRange points = points_by_curve[curve_index];
+      const IndexRange evaluated_points = evaluated_points_by_curve[curve_index];
 
-        switch (types[curve_index]) {
-          case CURVE_TYPE_CATMULL_ROM:
-            curves::catmull_rom::interpolate_to_evaluated(
-                positions.slice(points),
-                cyclic[curve_index],
-                resolution[curve_index],
-                evaluated_positions.slice(evaluated_points));
-            break;
-          case CURVE_TYPE_POLY:
-            evaluated_positions.slice(evaluated_points).copy_from(positions.slice(points));
-            break;
-          case CURVE_TYPE_BEZIER: {
-            const IndexRange offsets = curves::per_curve_point_offsets_range(points, curve_index);
-            curves::bezier::calculate_evaluated_positions(
-                positions.slice(points),
-                handle_positions_left.slice(points),
-                handle_positions_right.slice(points),
-                all_bezier_offsets.slice(offsets),
-                evaluated_positions.slice(evaluated_points));
-            break;
-          }
-          case CURVE_TYPE_NURBS:
-            curves::nurbs::interpolate_to_evaluated(nurbs_basis_cache[curve_index],
-                                                    nurbs_orders[curve_index],
-                                                    nurbs_weights.slice_safe(points),
-                                                    positions.slice(points),
-                                                    evaluated_positions.slice(evaluated_points));
-            break;
-          default:
-            BLI_assert_unreachable();
-            break;
-        }
+      const float epsilon = 1e-6f;
+      if (!math::almost_equal_relative(
+              handles_right[points.first()], positions[points.first()], epsilon)) {
+        tangents[evaluated_points.first()] = math::normalize(handles_right[points.first()] -
+                                                             positions[points.first()]);
       }
-    });
+      if (!math::almost_equal_relative(
+              handles_left[points.last()], positions[points.last()], epsilon)) {
+        tangents[evaluated_points.last()] = math::normalize(positions[points.last()] -
+                                                            handles_left[points.last()]);
+      }
+    }
   });
-  return runtime.evaluated_position_cache.data().span;
 }
 
 Span<float3> CurvesGeometry::evaluated_tangents() const
 {
   const bke::CurvesGeometryRuntime &runtime = *this->runtime;
   runtime.evaluated_tangent_cache.ensure([&](Vector<float3> &r_data) {
-    const OffsetIndices<int> evaluated_points_by_curve = this->evaluated_points_by_curve();
     const Span<float3> evaluated_positions = this->evaluated_positions();
-    const VArray<bool> cyclic = this->cyclic();
-
     r_data.resize(this->evaluated_points_num());
-    MutableSpan<float3> tangents = r_data;
-
-    threading::parallel_for(this->curves_range(), 128, [&](IndexRange curves_range) {
-      for (const int curve_index : curves_range) {
-        const IndexRange evaluated_points = evaluated_points_by_curve[curve_index];
-        curves::poly::calculate_tangents(evaluated_positions.slice(evaluated_points),
-                                         cyclic[curve_index],
-                                         tangents.slice(evaluated_points));
-      }
-    });
-
-    /* Correct the first and last tangents of non-cyclic Bezier curves so that they align with
-     * the inner handles. This is a separate loop to avoid the cost when Bezier type curves are
-     * not used. */
-    Vector<int64_t> bezier_indices;
-    const IndexMask bezier_mask = this->indices_for_curve_type(CURVE_TYPE_BEZIER, bezier_indices);
-    if (!bezier_mask.is_empty()) {
-      const OffsetIndices<int> points_by_curve = this->points_by_curve();
-      const Span<float3> positions = this->positions();
-      const Span<float3> handles_left = this->handle_positions_left();
-      const Span<float3> handles_right = this->handle_positions_right();
-
-      threading::parallel_for(bezier_mask.index_range(), 1024, [&](IndexRange range) {
-        for (const int curve_index : bezier_mask.slice(range)) {
-          if (cyclic[curve_index]) {
-            continue;
-          }
-          const IndexRange points = points_by_curve[curve_index];
-          const IndexRange evaluated_points = evaluated_points_by_curve[curve_index];
-
-          const float epsilon = 1e-6f;
-          if (!math::almost_equal_relative(
-                  handles_right[points.first()], positions[points.first()], epsilon)) {
-            tangents[evaluated_points.first()] = math::normalize(handles_right[points.first()] -
-                                                                 positions[points.first()]);
-          }
-          if (!math::almost_equal_relative(
-                  handles_left[points.last()], positions[points.last()], epsilon)) {
-            tangents[evaluated_points.last()] = math::normalize(positions[points.last()] -
-                                                                handles_left[points.last()]);
-          }
-        }
-      });
-    }
+    calculate_evaluated_tangents(*this, this->curves_range(), evaluated_positions, r_data);
   });
   return runtime.evaluated_tangent_cache.data();
 }
@@ -778,79 +802,86 @@ static void evaluate_generic_data_for_curve(
   }
 }
 
-Span<float3> CurvesGeometry::evaluated_normals() const
+static void calculate_evaluated_normals(const CurvesGeometry &curves,
+                                        const IndexMask curve_selection,
+                                        const Span<float3> evaluated_tangents,
+                                        MutableSpan<float3> evaluated_normals)
 {
-  const bke::CurvesGeometryRuntime &runtime = *this->runtime;
-  runtime.evaluated_normal_cache.ensure([&](Vector<float3> &r_data) {
-    const OffsetIndices<int> points_by_curve = this->points_by_curve();
-    const OffsetIndices<int> evaluated_points_by_curve = this->evaluated_points_by_curve();
-    const VArray<int8_t> types = this->curve_types();
-    const VArray<bool> cyclic = this->cyclic();
-    const VArray<int8_t> normal_mode = this->normal_mode();
-    const VArray<int> resolution = this->resolution();
-    const VArray<int8_t> nurbs_orders = this->nurbs_orders();
-    const Span<float> nurbs_weights = this->nurbs_weights();
-    const Span<int> all_bezier_offsets = runtime.evaluated_offsets_cache.data().all_bezier_offsets;
-    const Span<curves::nurbs::BasisCache> nurbs_basis_cache = runtime.nurbs_basis_cache.data();
+  const bke::CurvesGeometryRuntime &runtime = *curves.runtime;
+  const OffsetIndices<int> points_by_curve = curves.points_by_curve();
+  const OffsetIndices<int> evaluated_points_by_curve = curves.evaluated_points_by_curve();
+  const VArray<int8_t> types = curves.curve_types();
+  const VArray<bool> cyclic = curves.cyclic();
+  const VArray<int8_t> normal_mode = curves.normal_mode();
+  const VArray<int> resolution = curves.resolution();
+  const VArray<int8_t> nurbs_orders = curves.nurbs_orders();
+  const Span<float> nurbs_weights = curves.nurbs_weights();
+  const Span<int> all_bezier_offsets = runtime.evaluated_offsets_cache.data().all_bezier_offsets;
+  const Span<curves::nurbs::BasisCache> nurbs_basis_cache = runtime.nurbs_basis_cache.data();
 
-    const Span<float3> evaluated_tangents = this->evaluated_tangents();
-    const VArray<float> tilt = this->tilt();
-    VArraySpan<float> tilt_span;
-    const bool use_tilt = !(tilt.is_single() && tilt.get_internal_single() == 0.0f);
-    if (use_tilt) {
-      tilt_span = tilt;
-    }
+  const VArray<float> tilt = curves.tilt();
+  VArraySpan<float> tilt_span;
+  const bool use_tilt = !(tilt.is_single() && tilt.get_internal_single() == 0.0f);
+  if (use_tilt) {
+    tilt_span = tilt;
+  }
 
-    r_data.resize(this->evaluated_points_num());
-    MutableSpan<float3> evaluated_normals = r_data;
+  threading::parallel_for(curve_selection.index_range(), 128, [&](IndexRange range) {
+    /* Reuse a buffer for the evaluated tilts. */
+    Vector<float> evaluated_tilts;
 
-    threading::parallel_for(this->curves_range(), 128, [&](IndexRange curves_range) {
-      /* Reuse a buffer for the evaluated tilts. */
-      Vector<float> evaluated_tilts;
+    for (const int curve_index : curve_selection.slice(range)) {
+      const IndexRange evaluated_points = evaluated_points_by_curve[curve_index];
+      switch (normal_mode[curve_index]) {
+        case NORMAL_MODE_Z_UP:
+          curves::poly::calculate_normals_z_up(evaluated_tangents.slice(evaluated_points),
+                                               evaluated_normals.slice(evaluated_points));
+          break;
+        case NORMAL_MODE_MINIMUM_TWIST:
+          curves::poly::calculate_normals_minimum(evaluated_tangents.slice(evaluated_points),
+                                                  cyclic[curve_index],
+                                                  evaluated_normals.slice(evaluated_points));
+          break;
+      }
 
-      for (const int curve_index : curves_range) {
-        const IndexRange evaluated_points = evaluated_points_by_curve[curve_index];
-        switch (normal_mode[curve_index]) {
-          case NORMAL_MODE_Z_UP:
-            curves::poly::calculate_normals_z_up(evaluated_tangents.slice(evaluated_points),
-                                                 evaluated_normals.slice(evaluated_points));
-            break;
-          case NORMAL_MODE_MINIMUM_TWIST:
-            curves::poly::calculate_normals_minimum(evaluated_tangents.slice(evaluated_points),
-                                                    cyclic[curve_index],
-                                                    evaluated_normals.slice(evaluated_points));
-            break;
+      /* If the "tilt" attribute exists, rotate the normals around the tangents by the
+       * evaluated angles. We can avoid copying the tilts to evaluate them for poly curves. */
+      if (use_tilt) {
+        const IndexRange points = points_by_curve[curve_index];
+        if (types[curve_index] == CURVE_TYPE_POLY) {
+          rotate_directions_around_axes(evaluated_normals.slice(evaluated_points),
+                                        evaluated_tangents.slice(evaluated_points),
+                                        tilt_span.slice(points));
         }
-
-        /* If the "tilt" attribute exists, rotate the normals around the tangents by the
-         * evaluated angles. We can avoid copying the tilts to evaluate them for poly curves. */
-        if (use_tilt) {
-          const IndexRange points = points_by_curve[curve_index];
-          if (types[curve_index] == CURVE_TYPE_POLY) {
-            rotate_directions_around_axes(evaluated_normals.slice(evaluated_points),
-                                          evaluated_tangents.slice(evaluated_points),
-                                          tilt_span.slice(points));
-          }
-          else {
-            evaluated_tilts.reinitialize(evaluated_points.size());
-            evaluate_generic_data_for_curve(curve_index,
-                                            points,
-                                            types,
-                                            cyclic,
-                                            resolution,
-                                            all_bezier_offsets,
-                                            nurbs_basis_cache,
-                                            nurbs_orders,
-                                            nurbs_weights,
-                                            tilt_span.slice(points),
-                                            evaluated_tilts.as_mutable_span());
-            rotate_directions_around_axes(evaluated_normals.slice(evaluated_points),
-                                          evaluated_tangents.slice(evaluated_points),
-                                          evaluated_tilts.as_span());
-          }
+        else {
+          evaluated_tilts.reinitialize(evaluated_points.size());
+          evaluate_generic_data_for_curve(curve_index,
+                                          points,
+                                          types,
+                                          cyclic,
+                                          resolution,
+                                          all_bezier_offsets,
+                                          nurbs_basis_cache,
+                                          nurbs_orders,
+                                          nurbs_weights,
+                                          tilt_span.slice(points),
+                                          evaluated_tilts.as_mutable_span());
+          rotate_directions_around_axes(evaluated_normals.slice(evaluated_points),
+                                        evaluated_tangents.slice(evaluated_points),
+                                        evaluated_tilts.as_span());
         }
       }
-    });
+    }
+  });
+}
+
+Span<float3> CurvesGeometry::evaluated_normals() const
+{
+  const bke::CurvesGeometryRuntime &runtime = *this->runtime;
+  runtime.evaluated_normal_cache.ensure([&](Vector<float3> &r_data) {
+    const Span<float3> evaluated_tangents = this->evaluated_tangents();
+    r_data.resize(this->evaluated_points_num());
+    calculate_evaluated_normals(*this, this->curves_range(), evaluated_tangents, r_data);
   });
   return this->runtime->evaluated_normal_cache.data();
 }
@@ -909,6 +940,26 @@ void CurvesGeometry::interpolate_to_evaluated(const GSpan src, GMutableSpan dst)
   });
 }
 
+static void calculate_evaluated_lengths(const CurvesGeometry &curves,
+                                        const IndexMask curve_selection,
+                                        const Span<float3> evaluated_positions,
+                                        MutableSpan<float> evaluated_lengths)
+{
+  const OffsetIndices<int> evaluated_points_by_curve = curves.evaluated_points_by_curve();
+  const VArray<bool> curves_cyclic = curves.cyclic();
+
+  threading::parallel_for(curve_selection.index_range(), 128, [&](IndexRange range) {
+    for (const int curve_index : curve_selection.slice(range)) {
+      const bool cyclic = curves_cyclic[curve_index];
+      const IndexRange evaluated_points = evaluated_points_by_curve[curve_index];
+      const IndexRange lengths_range = curves.lengths_range_for_curve(curve_index, cyclic);
+      length_parameterize::accumulate_lengths(evaluated_positions.slice(evaluated_points),
+                                              cyclic,
+                                              evaluated_lengths.slice(lengths_range));
+    }
+  });
+}
+
 void CurvesGeometry::ensure_evaluated_lengths() const
 {
   const bke::CurvesGeometryRuntime &runtime = *this->runtime;
@@ -917,22 +968,7 @@ void CurvesGeometry::ensure_evaluated_lengths() const
      * (see comment on #evaluated_length_cache). */
     const int total_num = this->evaluated_points_num() + this->curves_num();
     r_data.resize(total_num);
-    MutableSpan<float> evaluated_lengths = r_data;
-
-    const OffsetIndices<int> evaluated_points_by_curve = this->evaluated_points_by_curve();
-    const Span<float3> evaluated_positions = this->evaluated_positions();
-    const VArray<bool> curves_cyclic = this->cyclic();
-
-    threading::parallel_for(this->curves_range(), 128, [&](IndexRange curves_range) {
-      for (const int curve_index : curves_range) {
-        const bool cyclic = curves_cyclic[curve_index];
-        const IndexRange evaluated_points = evaluated_points_by_curve[curve_index];
-        const IndexRange lengths_range = this->lengths_range_for_curve(curve_index, cyclic);
-        length_parameterize::accumulate_lengths(evaluated_positions.slice(evaluated_points),
-                                                cyclic,
-                                                evaluated_lengths.slice(lengths_range));
-      }
-    });
+    calculate_evaluated_lengths(*this, this->curves_range(), this->evaluated_positions(), r_data);
   });
 }
 
@@ -970,6 +1006,40 @@ void CurvesGeometry::tag_positions_changed()
   this->runtime->evaluated_length_cache.tag_dirty();
   this->runtime->bounds_cache.tag_dirty();
 }
+void CurvesGeometry::tag_positions_changed(const IndexMask curves)
+{
+  if (curves.is_empty()) {
+    return;
+  }
+  if (curves.size() == this->curves_num()) {
+    this->tag_positions_changed();
+    return;
+  }
+  /* Only re-evaluate the changed curves in the caches that are already calculated. Caches that
+   * are dirty anyway are calculated fully when they are accessed next. */
+  bke::CurvesGeometryRuntime &runtime = *this->runtime;
+  runtime.evaluated_position_cache.update([&](CurvesGeometryRuntime::EvaluatedPositions &r_data) {
+    if (r_data.vector.is_empty()) {
+      /* All curves are poly curves, the evaluated positions are the original positions, which
+       * might have been reallocated. */
+      r_data.span = this->positions();
+      return;
+    }
+    r_data.span = r_data.vector;
+    this->ensure_nurbs_basis_cache();
+    calculate_evaluated_positions(*this, curves, r_data.vector);
+  });
+  runtime.evaluated_tangent_cache.update([&](Vector<float3> &r_data) {
+    calculate_evaluated_tangents(*this, curves, this->evaluated_positions(), r_data);
+  });
+  runtime.evaluated_normal_cache.update([&](Vector<float3> &r_data) {
+    calculate_evaluated_normals(*this, curves, this->evaluated_tangents(), r_data);
+  });
+  runtime.evaluated_length_cache.update([&](Vector<float> &r_data) {
+    calculate_evaluated_lengths(*this, curves, this->evaluated_positions(), r_data);
+  });
+  runtime.bounds_cache.tag_dirty();
+}
 void CurvesGeometry::tag_topology_changed()
 {
   this->tag_positions_changed();
@@ -231,6 +231,46 @@ TEST(curves_geometry, CatmullRomTwoPointCyclic)
   EXPECT_EQ(curves.evaluated_points_num(), 24);
 }
 
+TEST(curves_geometry, PartialPositionsUpdate)
+{
+  CurvesGeometry curves = create_basic_curves(40, 4);
+  curves.fill_curve_types(CURVE_TYPE_CATMULL_ROM);
+  curves.resolution_for_write().fill(4);
+
+  /* Calculate the caches before changing the positions of a single curve. */
+  curves.evaluated_normals();
+  curves.ensure_evaluated_lengths();
+
+  MutableSpan<float3> positions = curves.positions_for_write();
+  for (const int i : curves.points_by_curve()[2]) {
+    positions[i] += float3(0.0f, 2.0f * i, 1.0f);
+  }
+  Vector<int64_t> changed_curves = {2};
+  curves.tag_positions_changed(IndexMask(changed_curves));
+
+  CurvesGeometry curves_full = curves;
+  curves_full.tag_positions_changed();
+
+  const Span<float3> evaluated_positions = curves.evaluated_positions();
+  const Span<float3> expected_positions = curves_full.evaluated_positions();
+  for (const int i : evaluated_positions.index_range()) {
+    EXPECT_V3_NEAR(evaluated_positions[i], expected_positions[i], 1e-6f);
+  }
+  const Span<float3> evaluated_normals = curves.evaluated_normals();
+  const Span<float3> expected_normals = curves_full.evaluated_normals();
+  for (const int i : evaluated_normals.index_range()) {
+    EXPECT_V3_NEAR(evaluated_normals[i], expected_normals[i], 1e-6f);
+  }
+  curves.ensure_evaluated_lengths();
+  curves_full.ensure_evaluated_lengths();
+  const VArray<bool> cyclic = curves.cyclic();
+  for (const int curve_i : curves.curves_range()) {
+    EXPECT_NEAR(curves.evaluated_length_total_for_curve(curve_i, cyclic[curve_i]),
+                curves_full.evaluated_length_total_for_curve(curve_i, cyclic[curve_i]),
+                1e-5f);
+  }
+}
+
 TEST(curves_geometry, BezierPositionEvaluation)
 {
   CurvesGeometry curves(2, 1);
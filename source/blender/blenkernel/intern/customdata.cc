@@ -17,6 +17,7 @@
 #include "DNA_customdata_types.h"
 #include "DNA_meshdata_types.h"
 
+#include "BLI_array.hh"
 #include "BLI_bitmap.h"
 #include "BLI_color.hh"
 #include "BLI_endian_switch.h"
@@ -31,6 +32,7 @@
 #include "BLI_string.h"
 #include "BLI_string_ref.hh"
 #include "BLI_string_utils.h"
+#include "BLI_task.hh"
 #include "BLI_utildefines.h"
 
 #ifndef NDEBUG
@@ -3250,6 +3252,116 @@ void CustomData_free_elem(CustomData *data, const int index, const int count)
 
 #define SOURCE_BUF_SIZE 100
 
+/**
+ * Weighted sum of source values, with the same order of operations as the `interp` callbacks of
+ * the corresponding layer types. A compile-time number of sources allows unrolling the loop.
+ */
+template<typename T, int SourcesNum>
+static T interp_weighted_sum(const T *src, const int *indices, const float *weights)
+{
+  T result(0);
+  for (int i = 0; i < SourcesNum; i++) {
+    result += src[indices[i]] * weights[i];
+  }
+  return result;
+}
+
+template<typename T>
+static T interp_weighted_sum(const T *src,
+                             const int *indices,
+                             const float *weights,
+                             const int sources_num)
+{
+  T result(0);
+  for (int i = 0; i < sources_num; i++) {
+    result += src[indices[i]] * weights[i];
+  }
+  return result;
+}
+
+template<typename T>
+static void interp_weighted_sum_range(const T *src,
+                                      const int *src_indices,
+                                      const float *weights,
+                                      const int sources_num,
+                                      T *dst,
+                                      const IndexRange range)
+{
+  switch (sources_num) {
+    case 2:
+      for (const int i : range) {
+        dst[i] = interp_weighted_sum<T, 2>(src, &src_indices[i * 2], &weights[i * 2]);
+      }
+      break;
+    case 4:
+      for (const int i : range) {
+        dst[i] = interp_weighted_sum<T, 4>(src, &src_indices[i * 4], &weights[i * 4]);
+      }
+      break;
+    default:
+      for (const int i : range) {
+        dst[i] = interp_weighted_sum<T>(
+            src, &src_indices[i * sources_num], &weights[i * sources_num], sources_num);
+      }
+      break;
+  }
+}
+
+/**
+ * Interpolate layers of the most common attribute types without their `interp` callback, which
+ * needs an array of source pointers for every destination item.
+ *
+ * \param dst_data: The layer data, offset to the first destination item.
+ * \return False if there is no specialized implementation for the layer type.
+ */
+static bool customData_interp_layer_typed(const int type,
+                                          const void *src_data,
+                                          void *dst_data,
+                                          const int *src_indices,
+                                          const float *weights,
+                                          const int sources_num,
+                                          const IndexRange range)
+{
+  using blender::float3;
+  using blender::float4;
+  switch (type) {
+    case CD_PROP_FLOAT:
+      interp_weighted_sum_range(static_cast<const float *>(src_data),
+                                src_indices,
+                                weights,
+                                sources_num,
+                                static_cast<float *>(dst_data),
+                                range);
+      return true;
+    case CD_PROP_FLOAT2:
+      interp_weighted_sum_range(static_cast<const float2 *>(src_data),
+                                src_indices,
+                                weights,
+                                sources_num,
+                                static_cast<float2 *>(dst_data),
+                                range);
+      return true;
+    case CD_PROP_FLOAT3:
+      interp_weighted_sum_range(static_cast<const float3 *>(src_data),
+                                src_indices,
+                                weights,
+                                sources_num,
+                                static_cast<float3 *>(dst_data),
+                                range);
+      return true;
+    case CD_PROP_COLOR:
+      /* #MPropCol has the same layout as #float4. */
+      interp_weighted_sum_range(static_cast<const float4 *>(src_data),
+                                src_indices,
+                                weights,
+                                sources_num,
+                                static_cast<float4 *>(dst_data),
+                                range);
+      return true;
+  }
+  return false;
+}
+
 void CustomData_interp(const CustomData *source,
                        CustomData *dest,
                        const int *src_indices,
@@ -3305,17 +3417,22 @@ void CustomData_interp(const CustomData *source,
     /* if we found a matching layer, copy the data */
     if (dest->layers[dest_i].type == source->layers[src_i].type) {
       void *src_data = source->layers[src_i].data;
+      void *dst_data = POINTER_OFFSET(dest->layers[dest_i].data,
+                                      size_t(dest_index) * typeInfo->size);
 
-      for (int j = 0; j < count; j++) {
-        sources[j] = POINTER_OFFSET(src_data, size_t(src_indices[j]) * typeInfo->size);
-      }
+      if (!customData_interp_layer_typed(source->layers[src_i].type,
+                                         src_data,
+                                         dst_data,
+                                         src_indices,
+                                         weights,
+                                         count,
+                                         IndexRange(1))) {
+        for (int j = 0; j < count; j++) {
+          sources[j] = POINTER_OFFSET(src_data, size_t(src_indices[j]) * typeInfo->size);
+        }
 
-      typeInfo->interp(
-          sources,
-          weights,
-          sub_weights,
-          count,
-          POINTER_OFFSET(dest->layers[dest_i].data, size_t(dest_index) * typeInfo->size));
+        typeInfo->interp(sources, weights, sub_weights, count, dst_data);
+      }
 
       /* if there are multiple source & dest layers of the same type,
        * we don't want to copy all source layers to the same dest, so
@@ -3333,6 +3450,73 @@ void CustomData_interp(const CustomData *source,
   }
 }
 
+void CustomData_interp_batch(const CustomData *source,
+                             CustomData *dest,
+                             const int *src_indices,
+                             const float *weights,
+                             const int sources_num,
+                             const int dest_index,
+                             const int dest_num)
+{
+  using namespace blender;
+  if (sources_num <= 0 || dest_num <= 0) {
+    return;
+  }
+
+  /* If no weights are given, generate default ones to produce an average result. */
+  Array<float> default_weights;
+  if (weights == nullptr) {
+    default_weights.reinitialize(int64_t(sources_num) * dest_num);
+    default_weights.fill(1.0f / sources_num);
+    weights = default_weights.data();
+  }
+
+  int dest_i = 0;
+  for (int src_i = 0; src_i < source->totlayer; src_i++) {
+    const int type = source->layers[src_i].type;
+    const LayerTypeInfo *typeInfo = layerType_getInfo(type);
+    if (!typeInfo->interp) {
+      continue;
+    }
+
+    /* Layers are ordered by type, see #CustomData_interp. */
+    while (dest_i < dest->totlayer && dest->layers[dest_i].type < type) {
+      dest_i++;
+    }
+    if (dest_i >= dest->totlayer) {
+      break;
+    }
+    if (dest->layers[dest_i].type != type) {
+      continue;
+    }
+
+    const void *src_data = source->layers[src_i].data;
+    void *dst_data = POINTER_OFFSET(dest->layers[dest_i].data,
+                                    size_t(dest_index) * typeInfo->size);
+
+    threading::parallel_for(IndexRange(dest_num), 2048, [&](const IndexRange range) {
+      if (customData_interp_layer_typed(
+              type, src_data, dst_data, src_indices, weights, sources_num, range)) {
+        return;
+      }
+      Array<const void *, SOURCE_BUF_SIZE> sources(sources_num);
+      for (const int i : range) {
+        const int *elem_indices = &src_indices[int64_t(i) * sources_num];
+        for (int j = 0; j < sources_num; j++) {
+          sources[j] = POINTER_OFFSET(src_data, size_t(elem_indices[j]) * typeInfo->size);
+        }
+        typeInfo->interp(sources.data(),
+                         &weights[int64_t(i) * sources_num],
+                         nullptr,
+                         sources_num,
+                         POINTER_OFFSET(dst_data, size_t(i) * typeInfo->size));
+      }
+    });
+
+    dest_i++;
+  }
+}
+
 void CustomData_swap_corners(CustomData *data, const int index, const int *corner_indices)
 {
   for (int i = 0; i < data->totlayer; i++) {
@@ -4817,7 +5001,10 @@ static void customdata_data_transfer_interp_generic(const CustomDataTransferLaye
     copy_cd = type_info->copy;
   }
 
-  void *tmp_dst = MEM_mallocN(data_size, __func__);
+  /* Avoid a heap allocation for every element, this is called for every transferred item. */
+  blender::AlignedBuffer<64, 16> tmp_buffer;
+  void *tmp_dst = (data_size <= sizeof(tmp_buffer)) ? tmp_buffer.ptr() :
+                                                      MEM_mallocN(data_size, __func__);
 
   if (count > 1 && !interp_cd) {
     if (data_flag) {
@@ -4888,7 +5075,9 @@ static void customdata_data_transfer_interp_generic(const CustomDataTransferLaye
     }
   }
 
-  MEM_freeN(tmp_dst);
+  if (tmp_dst != tmp_buffer.ptr()) {
+    MEM_freeN(tmp_dst);
+  }
 }
 
 void customdata_data_transfer_interp_normal_normals(const CustomDataTransferLayerMap *laymap,
@@ -4927,6 +5116,64 @@ void customdata_data_transfer_interp_normal_normals(const CustomDataTransferLaye
   CustomData_data_mix_value(data_type, tmp_dst, data_dst, mix_mode, mix_factor);
 }
 
+template<typename T>
+static void customdata_data_transfer_typed(const MeshPairRemap *me_remap,
+                                           const CustomDataTransferLayerMap *laymap)
+{
+  const T *src = static_cast<const T *>(laymap->data_src);
+  T *dst = static_cast<T *>(laymap->data_dst);
+  blender::threading::parallel_for(
+      IndexRange(me_remap->items_num), 1024, [&](const IndexRange range) {
+        for (const int i : range) {
+          const MeshPairRemapItem &item = me_remap->items[i];
+          if (item.sources_num == 0) {
+            continue;
+          }
+          const float mix_factor = laymap->mix_factor *
+                                   (laymap->mix_weights ? laymap->mix_weights[i] : 1.0f);
+          const T value = interp_weighted_sum(
+              src, item.indices_src, item.weights_src, item.sources_num);
+          CustomData_data_mix_value(
+              laymap->data_type, &value, &dst[i], laymap->mix_mode, mix_factor);
+        }
+      });
+}
+
+/**
+ * Transfer layers of the most common attribute types with the interpolation kernels of
+ * #CustomData_interp instead of the generic per-item callbacks.
+ * \return False if the layer map is not supported.
+ */
+static bool customdata_data_transfer_try_typed(const MeshPairRemap *me_remap,
+                                               const CustomDataTransferLayerMap *laymap)
+{
+  using blender::float3;
+  using blender::float4;
+  const int data_type = laymap->data_type;
+  if ((data_type & CD_FAKE) || laymap->interp != nullptr || laymap->data_flag != 0 ||
+      laymap->data_src == nullptr || laymap->data_offset != 0) {
+    return false;
+  }
+  if (laymap->elem_size != 0 && laymap->elem_size != size_t(CustomData_sizeof(data_type))) {
+    return false;
+  }
+  switch (data_type) {
+    case CD_PROP_FLOAT:
+      customdata_data_transfer_typed<float>(me_remap, laymap);
+      return true;
+    case CD_PROP_FLOAT2:
+      customdata_data_transfer_typed<float2>(me_remap, laymap);
+      return true;
+    case CD_PROP_FLOAT3:
+      customdata_data_transfer_typed<float3>(me_remap, laymap);
+      return true;
+    case CD_PROP_COLOR:
+      customdata_data_transfer_typed<float4>(me_remap, laymap);
+      return true;
+  }
+  return false;
+}
+
 void CustomData_data_transfer(const MeshPairRemap *me_remap,
                               const CustomDataTransferLayerMap *laymap)
 {
@@ -4951,6 +5198,10 @@ void CustomData_data_transfer(const MeshPairRemap *me_remap,
     return;
   }
 
+  if (customdata_data_transfer_try_typed(me_remap, laymap)) {
+    return;
+  }
+
   if (data_src) {
     tmp_data_src = (const void **)MEM_malloc_arrayN(
         tmp_buff_size, sizeof(*tmp_data_src), __func__);
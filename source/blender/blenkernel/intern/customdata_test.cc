@@ -0,0 +1,77 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup bke
+ */
+
+#include "DNA_customdata_types.h"
+
+#include "BLI_array.hh"
+#include "BLI_math_vector_types.hh"
+#include "BLI_span.hh"
+
+#include "BKE_customdata.h"
+
+#include "testing/testing.h"
+
+namespace blender::bke::tests {
+
+TEST(customdata, InterpBatchMatchesInterp)
+{
+  const int src_size = 16;
+  const int dst_size = 8;
+  CustomData src;
+  CustomData_reset(&src);
+  float3 *src_positions = static_cast<float3 *>(CustomData_add_layer_named(
+      &src, CD_PROP_FLOAT3, CD_CONSTRUCT, nullptr, src_size, "position"));
+  int *src_ids = static_cast<int *>(
+      CustomData_add_layer_named(&src, CD_PROP_INT32, CD_CONSTRUCT, nullptr, src_size, "id"));
+  for (const int i : IndexRange(src_size)) {
+    src_positions[i] = float3(float(i), float(i * i), -float(i));
+    src_ids[i] = i * 3;
+  }
+
+  const int sources_num = 4;
+  Array<int> indices(dst_size * sources_num);
+  Array<float> weights(dst_size * sources_num);
+  for (const int i : indices.index_range()) {
+    indices[i] = (i * 7) % src_size;
+    weights[i] = float(i % sources_num + 1) / 10.0f;
+  }
+
+  CustomData dst_single;
+  CustomData dst_batch;
+  CustomData_copy(&src, &dst_single, CD_MASK_PROP_ALL, CD_SET_DEFAULT, dst_size);
+  CustomData_copy(&src, &dst_batch, CD_MASK_PROP_ALL, CD_SET_DEFAULT, dst_size);
+
+  for (const int i : IndexRange(dst_size)) {
+    CustomData_interp(&src,
+                      &dst_single,
+                      &indices[i * sources_num],
+                      &weights[i * sources_num],
+                      nullptr,
+                      sources_num,
+                      i);
+  }
+  CustomData_interp_batch(
+      &src, &dst_batch, indices.data(), weights.data(), sources_num, 0, dst_size);
+
+  const float3 *single_positions = static_cast<const float3 *>(
+      CustomData_get_layer_named(&dst_single, CD_PROP_FLOAT3, "position"));
+  const float3 *batch_positions = static_cast<const float3 *>(
+      CustomData_get_layer_named(&dst_batch, CD_PROP_FLOAT3, "position"));
+  const int *single_ids = static_cast<const int *>(
+      CustomData_get_layer_named(&dst_single, CD_PROP_INT32, "id"));
+  const int *batch_ids = static_cast<const int *>(
+      CustomData_get_layer_named(&dst_batch, CD_PROP_INT32, "id"));
+  for (const int i : IndexRange(dst_size)) {
+    EXPECT_EQ(single_positions[i], batch_positions[i]);
+    EXPECT_EQ(single_ids[i], batch_ids[i]);
+  }
+
+  CustomData_free(&src, src_size);
+  CustomData_free(&dst_single, dst_size);
+  CustomData_free(&dst_batch, dst_size);
+}
+
+}  // namespace blender::bke::tests
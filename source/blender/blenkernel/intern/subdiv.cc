@@ -199,6 +199,9 @@ void BKE_subdiv_free(Subdiv *subdiv)
   if (subdiv->cache_.face_ptex_offset != nullptr) {
     MEM_freeN(subdiv->cache_.face_ptex_offset);
   }
+  if (subdiv->cache_.coarse_vertex_map != nullptr) {
+    MEM_freeN(subdiv->cache_.coarse_vertex_map);
+  }
   MEM_freeN(subdiv);
 }
 
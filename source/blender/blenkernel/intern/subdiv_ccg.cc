@@ -12,9 +12,11 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "BLI_array.hh"
 #include "BLI_ghash.h"
 #include "BLI_math_bits.h"
 #include "BLI_math_vector.h"
+#include "BLI_math_vector_types.hh"
 #include "BLI_task.h"
 
 #include "BKE_DerivedMesh.h"
@@ -24,6 +26,7 @@
 #include "BKE_subdiv.h"
 #include "BKE_subdiv_eval.h"
 
+#include "opensubdiv_capi_type.h"
 #include "opensubdiv_topology_refiner_capi.h"
 
 /* -------------------------------------------------------------------- */
@@ -222,16 +225,62 @@ static void subdiv_ccg_eval_grid_element(CCGEvalGridsData *data,
   subdiv_ccg_eval_grid_element_mask(data, ptex_face_index, u, v, element);
 }
 
+/* Evaluate all elements of a grid, for the given patch coordinates of every grid element.
+ * Limit surface is evaluated in a batch, unless displacement is to be applied to it. */
+static void subdiv_ccg_eval_grid_elements(CCGEvalGridsData *data,
+                                          const OpenSubdiv_PatchCoord *patch_coords,
+                                          const int num_elements,
+                                          uchar *grid)
+{
+  Subdiv *subdiv = data->subdiv;
+  SubdivCCG *subdiv_ccg = data->subdiv_ccg;
+  const int element_size = element_size_bytes_get(subdiv_ccg);
+  if (subdiv->displacement_evaluator != nullptr) {
+    for (int i = 0; i < num_elements; i++) {
+      const OpenSubdiv_PatchCoord &patch_coord = patch_coords[i];
+      subdiv_ccg_eval_grid_element(data,
+                                   patch_coord.ptex_face,
+                                   patch_coord.u,
+                                   patch_coord.v,
+                                   &grid[size_t(i) * element_size]);
+    }
+    return;
+  }
+  blender::Array<blender::float3> P(num_elements);
+  blender::Array<blender::float3> dPdu(subdiv_ccg->has_normal ? num_elements : 0);
+  blender::Array<blender::float3> dPdv(subdiv_ccg->has_normal ? num_elements : 0);
+  BKE_subdiv_eval_limit_patches(
+      subdiv,
+      patch_coords,
+      num_elements,
+      reinterpret_cast<float(*)[3]>(P.data()),
+      subdiv_ccg->has_normal ? reinterpret_cast<float(*)[3]>(dPdu.data()) : nullptr,
+      subdiv_ccg->has_normal ? reinterpret_cast<float(*)[3]>(dPdv.data()) : nullptr);
+  for (int i = 0; i < num_elements; i++) {
+    uchar *element = &grid[size_t(i) * element_size];
+    copy_v3_v3((float *)element, P[i]);
+    if (subdiv_ccg->has_normal) {
+      float *normal = (float *)(element + subdiv_ccg->normal_offset);
+      cross_v3_v3v3(normal, dPdu[i], dPdv[i]);
+      normalize_v3(normal);
+    }
+    const OpenSubdiv_PatchCoord &patch_coord = patch_coords[i];
+    subdiv_ccg_eval_grid_element_mask(
+        data, patch_coord.ptex_face, patch_coord.u, patch_coord.v, element);
+  }
+}
+
 static void subdiv_ccg_eval_regular_grid(CCGEvalGridsData *data, const int face_index)
 {
   SubdivCCG *subdiv_ccg = data->subdiv_ccg;
   const int ptex_face_index = data->face_ptex_offset[face_index];
   const int grid_size = subdiv_ccg->grid_size;
+  const int grid_area = grid_size * grid_size;
   const float grid_size_1_inv = 1.0f / (grid_size - 1);
-  const int element_size = element_size_bytes_get(subdiv_ccg);
   SubdivCCGFace *faces = subdiv_ccg->faces;
   SubdivCCGFace **grid_faces = subdiv_ccg->grid_faces;
   const SubdivCCGFace *face = &faces[face_index];
+  blender::Array<OpenSubdiv_PatchCoord> patch_coords(grid_area);
   for (int corner = 0; corner < face->num_grids; corner++) {
     const int grid_index = face->start_grid_index + corner;
     uchar *grid = (uchar *)subdiv_ccg->grids[grid_index];
@@ -239,13 +288,13 @@ static void subdiv_ccg_eval_regular_grid(CCGEvalGridsData *data, const int face_
       const float grid_v = y * grid_size_1_inv;
       for (int x = 0; x < grid_size; x++) {
         const float grid_u = x * grid_size_1_inv;
-        float u, v;
-        BKE_subdiv_rotate_grid_to_quad(corner, grid_u, grid_v, &u, &v);
         const size_t grid_element_index = size_t(y) * grid_size + x;
-        const size_t grid_element_offset = grid_element_index * element_size;
-        subdiv_ccg_eval_grid_element(data, ptex_face_index, u, v, &grid[grid_element_offset]);
+        OpenSubdiv_PatchCoord &patch_coord = patch_coords[grid_element_index];
+        patch_coord.ptex_face = ptex_face_index;
+        BKE_subdiv_rotate_grid_to_quad(corner, grid_u, grid_v, &patch_coord.u, &patch_coord.v);
       }
     }
+    subdiv_ccg_eval_grid_elements(data, patch_coords.data(), grid_area, grid);
     /* Assign grid's face. */
     grid_faces[grid_index] = &faces[face_index];
     /* Assign material flags. */
@@ -258,11 +307,12 @@ static void subdiv_ccg_eval_special_grid(CCGEvalGridsData *data, const int face_
 {
   SubdivCCG *subdiv_ccg = data->subdiv_ccg;
   const int grid_size = subdiv_ccg->grid_size;
+  const int grid_area = grid_size * grid_size;
   const float grid_size_1_inv = 1.0f / (grid_size - 1);
-  const int element_size = element_size_bytes_get(subdiv_ccg);
   SubdivCCGFace *faces = subdiv_ccg->faces;
   SubdivCCGFace **grid_faces = subdiv_ccg->grid_faces;
   const SubdivCCGFace *face = &faces[face_index];
+  blender::Array<OpenSubdiv_PatchCoord> patch_coords(grid_area);
   for (int corner = 0; corner < face->num_grids; corner++) {
     const int grid_index = face->start_grid_index + corner;
     const int ptex_face_index = data->face_ptex_offset[face_index] + corner;
@@ -272,10 +322,13 @@ static void subdiv_ccg_eval_special_grid(CCGEvalGridsData *data, const int face_
       for (int x = 0; x < grid_size; x++) {
         const float v = 1.0f - (x * grid_size_1_inv);
         const size_t grid_element_index = size_t(y) * grid_size + x;
-        const size_t grid_element_offset = grid_element_index * element_size;
-        subdiv_ccg_eval_grid_element(data, ptex_face_index, u, v, &grid[grid_element_offset]);
+        OpenSubdiv_PatchCoord &patch_coord = patch_coords[grid_element_index];
+        patch_coord.ptex_face = ptex_face_index;
+        patch_coord.u = u;
+        patch_coord.v = v;
       }
     }
+    subdiv_ccg_eval_grid_elements(data, patch_coords.data(), grid_area, grid);
     /* Assign grid's face. */
     grid_faces[grid_index] = &faces[face_index];
     /* Assign material flags. */
@@ -13,6 +13,7 @@
 #include "BLI_bitmap.h"
 #include "BLI_math_vector.h"
 #include "BLI_task.h"
+#include "BLI_task.hh"
 #include "BLI_utildefines.h"
 
 #include "BKE_customdata.h"
@@ -21,6 +22,7 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "opensubdiv_capi_type.h"
 #include "opensubdiv_evaluator_capi.h"
 #include "opensubdiv_topology_refiner_capi.h"
 
@@ -77,17 +79,24 @@ bool BKE_subdiv_eval_begin(Subdiv *subdiv,
   return true;
 }
 
-static void set_coarse_positions(Subdiv *subdiv,
-                                 const Mesh *mesh,
-                                 const float (*coarse_vertex_cos)[3])
+/* Get indices of coarse vertices which are used by faces, in the order the topology refiner
+ * expects them. The mapping only depends on topology, so it is cached in the subdiv descriptor
+ * and re-used for as long as the descriptor is (which is as long as the topology is the same). */
+static const int *coarse_vertex_map_ensure(Subdiv *subdiv, const Mesh *mesh, int *r_map_len)
 {
-  const float(*positions)[3] = BKE_mesh_vert_positions(mesh);
+  OpenSubdiv_TopologyRefiner *topology_refiner = subdiv->topology_refiner;
+  const int num_refiner_vertices = topology_refiner->getNumVertices(topology_refiner);
+  if (subdiv->cache_.coarse_vertex_map != nullptr &&
+      subdiv->cache_.coarse_vertex_map_num_verts == mesh->totvert &&
+      subdiv->cache_.coarse_vertex_map_len == num_refiner_vertices) {
+    *r_map_len = subdiv->cache_.coarse_vertex_map_len;
+    return subdiv->cache_.coarse_vertex_map;
+  }
+  MEM_SAFE_FREE(subdiv->cache_.coarse_vertex_map);
+
   const MPoly *mpoly = BKE_mesh_polys(mesh);
   const MLoop *mloop = BKE_mesh_loops(mesh);
   /* Mark vertices which needs new coordinates. */
-  /* TODO(sergey): This is annoying to calculate this on every update,
-   * maybe it's better to cache this mapping. Or make it possible to have
-   * OpenSubdiv's vertices match mesh ones? */
   BLI_bitmap *vertex_used_map = BLI_BITMAP_NEW(mesh->totvert, "vert used map");
   for (int poly_index = 0; poly_index < mesh->totpoly; poly_index++) {
     const MPoly *poly = &mpoly[poly_index];
@@ -96,29 +105,42 @@ static void set_coarse_positions(Subdiv *subdiv,
       BLI_BITMAP_ENABLE(vertex_used_map, loop->v);
     }
   }
-  /* Use a temporary buffer so we do not upload vertices one at a time to the GPU. */
-  float(*buffer)[3] = static_cast<float(*)[3]>(
-      MEM_mallocN(sizeof(float[3]) * mesh->totvert, __func__));
+  int *vertex_map = static_cast<int *>(
+      MEM_malloc_arrayN(mesh->totvert, sizeof(int), "subdiv coarse vertex map"));
   int manifold_vertex_count = 0;
-  for (int vertex_index = 0, manifold_vertex_index = 0; vertex_index < mesh->totvert;
-       vertex_index++) {
-    if (!BLI_BITMAP_TEST_BOOL(vertex_used_map, vertex_index)) {
-      continue;
+  for (int vertex_index = 0; vertex_index < mesh->totvert; vertex_index++) {
+    if (BLI_BITMAP_TEST_BOOL(vertex_used_map, vertex_index)) {
+      vertex_map[manifold_vertex_count++] = vertex_index;
     }
-    const float *vertex_co;
-    if (coarse_vertex_cos != nullptr) {
-      vertex_co = coarse_vertex_cos[vertex_index];
-    }
-    else {
-      vertex_co = positions[vertex_index];
-    }
-    copy_v3_v3(&buffer[manifold_vertex_index][0], vertex_co);
-    manifold_vertex_index++;
-    manifold_vertex_count++;
   }
+  MEM_freeN(vertex_used_map);
+
+  subdiv->cache_.coarse_vertex_map = vertex_map;
+  subdiv->cache_.coarse_vertex_map_num_verts = mesh->totvert;
+  subdiv->cache_.coarse_vertex_map_len = manifold_vertex_count;
+  *r_map_len = manifold_vertex_count;
+  return vertex_map;
+}
+
+static void set_coarse_positions(Subdiv *subdiv,
+                                 const Mesh *mesh,
+                                 const float (*coarse_vertex_cos)[3])
+{
+  const float(*positions)[3] = (coarse_vertex_cos != nullptr) ? coarse_vertex_cos :
+                                                                 BKE_mesh_vert_positions(mesh);
+  int manifold_vertex_count;
+  const int *vertex_map = coarse_vertex_map_ensure(subdiv, mesh, &manifold_vertex_count);
+  /* Use a temporary buffer so we do not upload vertices one at a time to the GPU. */
+  float(*buffer)[3] = static_cast<float(*)[3]>(
+      MEM_malloc_arrayN(manifold_vertex_count, sizeof(float[3]), __func__));
+  blender::threading::parallel_for(
+      blender::IndexRange(manifold_vertex_count), 4096, [&](const blender::IndexRange range) {
+        for (const int manifold_vertex_index : range) {
+          copy_v3_v3(buffer[manifold_vertex_index], positions[vertex_map[manifold_vertex_index]]);
+        }
+      });
   subdiv->evaluator->setCoarsePositions(
       subdiv->evaluator, &buffer[0][0], 0, manifold_vertex_count);
-  MEM_freeN(vertex_used_map);
   MEM_freeN(buffer);
 }
 
@@ -383,3 +405,46 @@ void BKE_subdiv_eval_final_point(
     BKE_subdiv_eval_limit_point(subdiv, ptex_face_index, u, v, r_P);
   }
 }
+
+/* --------------------------------------------------------------------
+ * Batched queries.
+ */
+
+void BKE_subdiv_eval_limit_patches(Subdiv *subdiv,
+                                   const OpenSubdiv_PatchCoord *patch_coords,
+                                   const int num_patch_coords,
+                                   float (*r_P)[3],
+                                   float (*r_dPdu)[3],
+                                   float (*r_dPdv)[3])
+{
+  using namespace blender;
+  OpenSubdiv_Evaluator *evaluator = subdiv->evaluator;
+  const bool need_derivatives = (r_dPdu != nullptr && r_dPdv != nullptr);
+  /* The CPU evaluator only reads from the refined buffers and patch tables, so chunks of patch
+   * coordinates can be evaluated from multiple threads at once. */
+  threading::parallel_for(IndexRange(num_patch_coords), 1024, [&](const IndexRange range) {
+    const int start = int(range.start());
+    evaluator->evaluatePatchesLimit(evaluator,
+                                    patch_coords + start,
+                                    int(range.size()),
+                                    r_P[start],
+                                    need_derivatives ? r_dPdu[start] : nullptr,
+                                    need_derivatives ? r_dPdv[start] : nullptr);
+    if (!need_derivatives) {
+      return;
+    }
+    /* Same as for the single point query: step inside of the patch for degenerate derivatives. */
+    for (const int i : range) {
+      if ((is_zero_v3(r_dPdu[i]) || is_zero_v3(r_dPdv[i])) || equals_v3v3(r_dPdu[i], r_dPdv[i])) {
+        const OpenSubdiv_PatchCoord &patch_coord = patch_coords[i];
+        BKE_subdiv_eval_limit_point_and_derivatives(subdiv,
+                                                    patch_coord.ptex_face,
+                                                    patch_coord.u,
+                                                    patch_coord.v,
+                                                    r_P[i],
+                                                    r_dPdu[i],
+                                                    r_dPdv[i]);
+      }
+    }
+  });
+}
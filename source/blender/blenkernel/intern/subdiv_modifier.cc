@@ -11,8 +11,14 @@
 #include "DNA_scene_types.h"
 #include "DNA_userdef_types.h"
 
+#include "BLI_math_matrix.h"
+#include "BLI_math_vector.hh"
+#include "BLI_rect.h"
+
+#include "BKE_camera.h"
 #include "BKE_mesh.h"
 #include "BKE_modifier.h"
+#include "BKE_scene.h"
 #include "BKE_subdiv.h"
 
 #include "GPU_capabilities.h"
@@ -65,6 +71,63 @@ bool BKE_subsurf_modifier_runtime_init(SubsurfModifierData *smd, const bool use_
   return true;
 }
 
+int BKE_subsurf_modifier_adaptive_render_levels(const SubsurfModifierData *smd,
+                                                const Scene *scene,
+                                                const Object *ob,
+                                                const Mesh *mesh)
+{
+  using namespace blender;
+  const int max_levels = smd->renderLevels;
+  const Object *camera = scene->camera;
+  if (camera == nullptr || camera->type != OB_CAMERA || mesh->totedge == 0) {
+    return max_levels;
+  }
+
+  /* Average length of coarse edges in world space. */
+  const Span<float3> positions = mesh->vert_positions();
+  const Span<MEdge> edges = mesh->edges();
+  double edge_length_sum = 0.0;
+  for (const MEdge &edge : edges) {
+    edge_length_sum += math::distance(positions[edge.v1], positions[edge.v2]);
+  }
+  const float edge_length = float(edge_length_sum / edges.size()) *
+                            mat4_to_scale(ob->object_to_world);
+
+  /* Distance from the camera to the closest point of the object bounds. */
+  float3 min, max;
+  INIT_MINMAX(min, max);
+  if (!BKE_mesh_minmax(mesh, min, max)) {
+    return max_levels;
+  }
+  float3 local_camera_position;
+  mul_v3_m4v3(local_camera_position, ob->world_to_object, camera->object_to_world[3]);
+  const float3 closest_local = math::clamp(local_camera_position, min, max);
+  float3 closest_world;
+  mul_v3_m4v3(closest_world, ob->object_to_world, closest_local);
+
+  /* Size of a pixel in world space at that distance. */
+  int width, height;
+  BKE_render_resolution(&scene->r, false, &width, &height);
+  CameraParams params;
+  BKE_camera_params_init(&params);
+  BKE_camera_params_from_object(&params, camera);
+  BKE_camera_params_compute_viewplane(&params, width, height, scene->r.xasp, scene->r.yasp);
+  float pixel_size = BLI_rctf_size_x(&params.viewplane) / float(width);
+  if (!params.is_ortho) {
+    const float distance = max_ff(math::distance(closest_world, float3(camera->object_to_world[3])),
+                                  params.clip_start);
+    pixel_size *= distance / params.clip_start;
+  }
+
+  /* Every level halves the length of the edges. */
+  const float target_length = max_ff(smd->adaptive_pixel_size, 0.1f) * pixel_size;
+  if (target_length <= 0.0f || edge_length <= target_length) {
+    return 0;
+  }
+  const int levels = int(ceilf(log2f(edge_length / target_length)));
+  return min_ii(levels, max_levels);
+}
+
 static ModifierData *modifier_get_last_enabled_for_mode(const Scene *scene,
                                                         const Object *ob,
                                                         int required_mode)
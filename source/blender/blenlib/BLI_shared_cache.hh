@@ -49,6 +49,26 @@ template<typename T> class SharedCache {
     }
   }
 
+  /**
+   * Modify valid cached data in place, for changes that only affect part of the data and are
+   * cheaper to apply than a full recomputation. If the cache is shared with other objects, the
+   * data is copied first so that the other objects are not affected. If the cache is dirty, there
+   * is nothing to update, and it is computed with #ensure as usual later on.
+   */
+  void update(FunctionRef<void(T &data)> update_fn)
+  {
+    if (!cache_->mutex.is_cached()) {
+      this->tag_dirty();
+      return;
+    }
+    if (!cache_.unique()) {
+      std::shared_ptr<CacheData> new_cache = std::make_shared<CacheData>();
+      new_cache->mutex.ensure([&]() { new_cache->data = cache_->data; });
+      cache_ = std::move(new_cache);
+    }
+    update_fn(cache_->data);
+  }
+
   /**
    * If the cache is dirty, trigger its computation with the provided function which should set
    * the proper data.
@@ -3911,6 +3911,18 @@ void blo_do_versions_300(FileData *fd, Library * /*lib*/, Main *bmain)
       }
     }
 
+    if (!DNA_struct_elem_find(
+            fd->filesdna, "SubsurfModifierData", "float", "adaptive_pixel_size")) {
+      LISTBASE_FOREACH (Object *, ob, &bmain->objects) {
+        LISTBASE_FOREACH (ModifierData *, md, &ob->modifiers) {
+          if (md->type == eModifierType_Subsurf) {
+            SubsurfModifierData *smd = (SubsurfModifierData *)md;
+            smd->adaptive_pixel_size = 1.0f;
+          }
+        }
+      }
+    }
+
     /* Keep this block, even when empty. */
   }
 }
@@ -101,6 +101,11 @@ enum class ChunkOrdering {
   TopDown = 2,
   /** \brief experimental ordering with 9 hot-spots. */
   RuleOfThirds = 3,
+  /**
+   * \brief order along a Hilbert curve. Consecutive chunks are next to each other, so chunks
+   * scheduled together share most of their input chunks, used for renders.
+   */
+  SpaceFillingCurve = 4,
 
   Default = ChunkOrdering::CenterOut,
 };
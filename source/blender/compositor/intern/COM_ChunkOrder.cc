@@ -2,6 +2,7 @@
  * Copyright 2011 Blender Foundation. */
 
 #include <cfloat>
+#include <utility>
 
 #include "COM_ChunkOrder.h"
 
@@ -19,6 +20,27 @@ void ChunkOrder::update_distance(ChunkOrderHotspot *hotspots, uint len_hotspots)
   this->distance = new_distance;
 }
 
+void ChunkOrder::update_curve_distance(const uint chunk_size, const uint curve_size)
+{
+  uint curve_x = x / chunk_size;
+  uint curve_y = y / chunk_size;
+  uint64_t curve_distance = 0;
+  for (uint s = curve_size / 2; s > 0; s /= 2) {
+    const uint rx = (curve_x & s) ? 1 : 0;
+    const uint ry = (curve_y & s) ? 1 : 0;
+    curve_distance += uint64_t(s) * s * ((3 * rx) ^ ry);
+    /* Rotate the quadrant so the curve of the next level is continuous. */
+    if (ry == 0) {
+      if (rx == 1) {
+        curve_x = curve_size - 1 - curve_x;
+        curve_y = curve_size - 1 - curve_y;
+      }
+      std::swap(curve_x, curve_y);
+    }
+  }
+  this->distance = double(curve_distance);
+}
+
 bool operator<(const ChunkOrder &a, const ChunkOrder &b)
 {
   return a.distance < b.distance;
@@ -24,6 +24,12 @@ struct ChunkOrder {
 
   void update_distance(ChunkOrderHotspot *hotspots, uint len_hotspots);
 
+  /**
+   * Set distance to the position of the chunk along a Hilbert curve covering a grid of
+   * `curve_size` by `curve_size` chunks, which must be a power of two.
+   */
+  void update_curve_distance(uint chunk_size, uint curve_size);
+
 #ifdef WITH_CXX_GUARDEDALLOC
   MEM_CXX_CLASS_ALLOC_FUNCS("COM:ChunkOrderHotspot")
 #endif
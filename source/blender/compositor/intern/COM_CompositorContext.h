@@ -13,6 +13,8 @@ struct bNodeInstanceHash;
 
 namespace blender::compositor {
 
+class ResultCache;
+
 /**
  * \brief Overall context of the compositor
  */
@@ -69,6 +71,11 @@ class CompositorContext {
    */
   const char *view_name_;
 
+  /**
+   * \brief Results kept between executions, null when disabled.
+   */
+  ResultCache *result_cache_;
+
  public:
   /**
    * \brief constructor initializes the context with default values.
@@ -212,6 +219,31 @@ class CompositorContext {
     return this->get_bnodetree()->chunksize;
   }
 
+  /**
+   * Get the memory limit of the full frame execution model in bytes, 0 when unlimited.
+   */
+  size_t get_max_memory() const
+  {
+    return size_t(this->get_bnodetree()->max_memory) * 1024 * 1024;
+  }
+
+  /**
+   * Get the memory budget of results kept between executions in bytes, 0 when disabled.
+   */
+  size_t get_cache_memory() const
+  {
+    return size_t(this->get_bnodetree()->cache_memory) * 1024 * 1024;
+  }
+
+  void set_result_cache(ResultCache *result_cache)
+  {
+    result_cache_ = result_cache;
+  }
+  ResultCache *get_result_cache() const
+  {
+    return result_cache_;
+  }
+
   void set_fast_calculation(bool fast_calculation)
   {
     fast_calculation_ = fast_calculation;
@@ -224,6 +256,10 @@ class CompositorContext {
   {
     return (this->get_bnodetree()->flag & NTREE_COM_GROUPNODE_BUFFER) != 0;
   }
+  bool is_half_buffers_enabled() const
+  {
+    return (this->get_bnodetree()->flag & NTREE_COM_HALF_BUFFERS) != 0;
+  }
 
   /**
    * \brief Get the render percentage as a factor.
@@ -86,6 +86,7 @@
 #include "COM_SeparateColorNodeLegacy.h"
 #include "COM_SeparateXYZNode.h"
 #include "COM_SetAlphaNode.h"
+#include "COM_SetAlphaReplaceOperation.h"
 #include "COM_SetValueOperation.h"
 #include "COM_SplitViewerNode.h"
 #include "COM_Stabilize2dNode.h"
@@ -467,6 +468,90 @@ NodeOperation *COM_convert_data_type(const NodeOperationOutput &from, const Node
   return nullptr;
 }
 
+/**
+ * Returns the input of given operation when it's a data type conversion to more channels with
+ * the same canvas as its input, otherwise null.
+ *
+ * The area outside of a translated input is transparent black. Value to color conversions set
+ * alpha to one, so their alpha is resized separately from a coverage mask (see
+ * #convert_canvas_before_data_type). That mask relies on constant buffers being clipped to their
+ * canvas, which is only the case in full frame execution. Vector to color conversions are not
+ * worth the additional mask.
+ */
+static NodeOperationOutput *get_unexpanded_output(const CompositorContext &context,
+                                                  NodeOperation *operation)
+{
+  const bool is_value_to_color = dynamic_cast<ConvertValueToColorOperation *>(operation) &&
+                                 context.get_execution_model() == eExecutionModel::FullFrame;
+  if (!is_value_to_color && dynamic_cast<ConvertValueToVectorOperation *>(operation) == nullptr) {
+    return nullptr;
+  }
+  NodeOperationOutput *input_link = operation->get_input_socket(0)->get_link();
+  if (input_link == nullptr) {
+    return nullptr;
+  }
+  const int num_input_channels = COM_data_type_num_channels(input_link->get_data_type());
+  const int num_output_channels = COM_data_type_num_channels(
+      operation->get_output_socket()->get_data_type());
+  if (num_input_channels >= num_output_channels ||
+      !BLI_rcti_compare(&input_link->get_operation().get_canvas(), &operation->get_canvas())) {
+    return nullptr;
+  }
+  return input_link;
+}
+
+/**
+ * Converts the canvas of \a unexpanded_socket to the one of \a to_socket and converts its data
+ * type afterwards, so that scaling and translating operate on less channels.
+ */
+static void convert_canvas_before_data_type(NodeOperationBuilder &builder,
+                                            NodeOperationOutput *unexpanded_socket,
+                                            NodeOperationInput *to_socket)
+{
+  const ResizeMode mode = to_socket->get_resize_mode();
+  const rcti &to_canvas = to_socket->get_operation().get_canvas();
+
+  NodeOperation *converter = COM_convert_data_type(*unexpanded_socket, *to_socket);
+  BLI_assert(converter != nullptr);
+  builder.add_operation(converter);
+  NodeOperationInput *converter_input = converter->get_input_socket(0);
+  converter_input->set_resize_mode(mode);
+  converter->set_canvas(to_canvas);
+
+  builder.remove_input_link(to_socket);
+  to_socket->set_resize_mode(ResizeMode::None);
+  builder.add_link(unexpanded_socket, converter_input);
+  COM_convert_canvas(builder, unexpanded_socket, converter_input);
+
+  /* Converter has the canvas of the converted input. */
+  const rcti converted_canvas = converter_input->get_link()->get_operation().get_canvas();
+  converter->set_canvas(converted_canvas);
+
+  if (to_socket->get_data_type() != DataType::Color) {
+    builder.add_link(converter->get_output_socket(), to_socket);
+    return;
+  }
+
+  /* Resizing a converted color resizes its alpha of one like any other channel. Get the same
+   * alpha by resizing a value of one with the canvas of the unexpanded input. */
+  SetValueOperation *coverage = new SetValueOperation();
+  coverage->set_value(1.0f);
+  coverage->set_canvas(unexpanded_socket->get_operation().get_canvas());
+  builder.add_operation(coverage);
+
+  SetAlphaReplaceOperation *set_alpha = new SetAlphaReplaceOperation();
+  set_alpha->get_input_socket(0)->set_resize_mode(ResizeMode::None);
+  set_alpha->get_input_socket(1)->set_resize_mode(mode);
+  set_alpha->set_canvas(to_canvas);
+  builder.add_operation(set_alpha);
+  builder.add_link(converter->get_output_socket(), set_alpha->get_input_socket(0));
+  builder.add_link(coverage->get_output_socket(), set_alpha->get_input_socket(1));
+  COM_convert_canvas(builder, coverage->get_output_socket(), set_alpha->get_input_socket(1));
+
+  set_alpha->set_canvas(converted_canvas);
+  builder.add_link(set_alpha->get_output_socket(), to_socket);
+}
+
 void COM_convert_canvas(NodeOperationBuilder &builder,
                         NodeOperationOutput *from_socket,
                         NodeOperationInput *to_socket)
@@ -478,6 +563,15 @@ void COM_convert_canvas(NodeOperationBuilder &builder,
   ResizeMode mode = to_socket->get_resize_mode();
   BLI_assert(mode != ResizeMode::None);
 
+  /* Convert canvas of data converted to more channels (e.g. value to color) before the data type
+   * conversion. The original conversion is pruned when it has no other users. */
+  NodeOperationOutput *unexpanded_socket = get_unexpanded_output(builder.context(),
+                                                                 &from_socket->get_operation());
+  if (unexpanded_socket) {
+    convert_canvas_before_data_type(builder, unexpanded_socket, to_socket);
+    return;
+  }
+
   NodeOperation *to_operation = &to_socket->get_operation();
   const float to_width = to_operation->get_width();
   const float to_height = to_operation->get_height();
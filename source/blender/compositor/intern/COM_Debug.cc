@@ -1,17 +1,23 @@
 /* SPDX-License-Identifier: GPL-2.0-or-later
  * Copyright 2013 Blender Foundation. */
 
+#include <sstream>
+
 #include "COM_Debug.h"
 
 extern "C" {
 #include "BLI_fileops.h"
 #include "BLI_path_util.h"
+#include "BLI_string.h"
 
 #include "BKE_appdir.h"
+#include "BKE_global.h"
 #include "IMB_imbuf.h"
 #include "IMB_imbuf_types.h"
 }
 
+#include "MEM_guardedalloc.h"
+
 #include "COM_ExecutionGroup.h"
 #include "COM_ReadBufferOperation.h"
 #include "COM_SetValueOperation.h"
@@ -26,6 +32,12 @@ DebugInfo::OpNameMap DebugInfo::op_names_;
 std::string DebugInfo::current_node_name_;
 std::string DebugInfo::current_op_name_;
 DebugInfo::GroupStateMap DebugInfo::group_states_;
+timeit::TimePoint DebugInfo::execution_start_;
+timeit::TimePoint DebugInfo::operation_render_start_;
+size_t DebugInfo::start_memory_ = 0;
+size_t DebugInfo::peak_memory_ = 0;
+Vector<DebugInfo::OperationStatistics> DebugInfo::operations_statistics_;
+Map<const NodeOperation *, int> DebugInfo::operations_statistics_indices_;
 
 static std::string operation_class_name(const NodeOperation *op)
 {
@@ -484,4 +496,81 @@ void DebugInfo::delete_operation_exports()
   }
 }
 
+bool DebugInfo::is_statistics_enabled()
+{
+  return G.debug & G_DEBUG_COMPOSITOR;
+}
+
+void DebugInfo::start_statistics()
+{
+  operations_statistics_.clear();
+  operations_statistics_indices_.clear();
+  start_memory_ = MEM_get_memory_in_use();
+  peak_memory_ = start_memory_;
+  execution_start_ = timeit::Clock::now();
+}
+
+void DebugInfo::add_operation_statistics(const NodeOperation *op)
+{
+  const timeit::Nanoseconds render_time = timeit::Clock::now() - operation_render_start_;
+  peak_memory_ = std::max(peak_memory_, MEM_get_memory_in_use());
+
+  const int index = operations_statistics_indices_.lookup_or_add_cb(op, [&]() {
+    operations_statistics_.append({op->get_name(), op->get_id(), timeit::Nanoseconds(0)});
+    return int(operations_statistics_.size()) - 1;
+  });
+  operations_statistics_[index].render_time += render_time;
+}
+
+static std::string json_string(StringRefNull str)
+{
+  std::string result = "\"";
+  for (const char c : str) {
+    if (ELEM(c, '"', '\\')) {
+      result += '\\';
+      result += c;
+    }
+    else if (uchar(c) < 0x20) {
+      char escaped[8];
+      BLI_snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+      result += escaped;
+    }
+    else {
+      result += c;
+    }
+  }
+  return result + "\"";
+}
+
+static double to_seconds(const timeit::Nanoseconds duration)
+{
+  return std::chrono::duration<double>(duration).count();
+}
+
+void DebugInfo::print_statistics(const ExecutionSystem *system)
+{
+  const timeit::Nanoseconds time = timeit::Clock::now() - execution_start_;
+  /* Tiled execution keeps its buffers until the execution system is freed. */
+  peak_memory_ = std::max(peak_memory_, MEM_get_memory_in_use());
+
+  const bool is_full_frame = system->get_context().get_execution_model() ==
+                             eExecutionModel::FullFrame;
+  std::stringstream ss;
+  ss << "{\"execution_model\": " << (is_full_frame ? "\"full_frame\"" : "\"tiled\"");
+  ss << ", \"time\": " << to_seconds(time);
+  ss << ", \"start_memory\": " << start_memory_;
+  ss << ", \"peak_memory\": " << peak_memory_;
+  ss << ", \"operations\": [";
+  for (const int i : operations_statistics_.index_range()) {
+    const OperationStatistics &stats = operations_statistics_[i];
+    ss << (i == 0 ? "" : ", ");
+    ss << "{\"id\": " << stats.id << ", \"name\": " << json_string(stats.name)
+       << ", \"time\": " << to_seconds(stats.render_time) << "}";
+  }
+  ss << "]}";
+
+  printf("Compositor statistics: %s\n", ss.str().c_str());
+  fflush(stdout);
+}
+
 }  // namespace blender::compositor
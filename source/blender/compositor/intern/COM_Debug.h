@@ -6,6 +6,8 @@
 #include <map>
 #include <string>
 
+#include "BLI_map.hh"
+#include "BLI_timeit.hh"
 #include "BLI_vector.hh"
 
 #include "COM_ExecutionSystem.h"
@@ -49,6 +51,20 @@ class DebugInfo {
   /** For visualizing group states. */
   static GroupStateMap group_states_;
 
+  struct OperationStatistics {
+    std::string name;
+    int id;
+    timeit::Nanoseconds render_time;
+  };
+  /** Execution statistics printed with `--debug-compositor`. */
+  static timeit::TimePoint execution_start_;
+  static timeit::TimePoint operation_render_start_;
+  static size_t start_memory_;
+  static size_t peak_memory_;
+  /** Rendered operations in rendering order. */
+  static Vector<OperationStatistics> operations_statistics_;
+  static Map<const NodeOperation *, int> operations_statistics_indices_;
+
  public:
   static void convert_started()
   {
@@ -69,8 +85,18 @@ class DebugInfo {
     if (COM_EXPORT_OPERATION_BUFFERS) {
       delete_operation_exports();
     }
+    if (is_statistics_enabled()) {
+      start_statistics();
+    }
   };
 
+  static void execute_finished(const ExecutionSystem *system)
+  {
+    if (is_statistics_enabled()) {
+      print_statistics(system);
+    }
+  }
+
   static void node_added(const Node *node)
   {
     if (COM_EXPORT_GRAPHVIZ) {
@@ -112,14 +138,40 @@ class DebugInfo {
     }
   };
 
+  static void operation_render_started(const NodeOperation * /*op*/)
+  {
+    if (is_statistics_enabled()) {
+      operation_render_start_ = timeit::Clock::now();
+    }
+  }
+
   static void operation_rendered(const NodeOperation *op, MemoryBuffer *render)
   {
     /* Don't export constant operations as there are too many and it's rarely useful. */
     if (COM_EXPORT_OPERATION_BUFFERS && render && !render->is_a_single_elem()) {
       export_operation(op, render);
     }
+    if (is_statistics_enabled()) {
+      add_operation_statistics(op);
+    }
   }
 
+  /**
+   * Called after rendering a strip of an operation, operations may be rendered in several strips.
+   */
+  static void operation_strip_rendered(const NodeOperation *op)
+  {
+    if (is_statistics_enabled()) {
+      add_operation_statistics(op);
+    }
+  }
+
+  /**
+   * Whether execution statistics are printed, enabled with `--debug-compositor`. Operations
+   * render times and memory usage are printed as JSON after every execution.
+   */
+  static bool is_statistics_enabled();
+
   static void graphviz(const ExecutionSystem *system, StringRefNull name = "");
 
  protected:
@@ -138,6 +190,10 @@ class DebugInfo {
 
   static void export_operation(const NodeOperation *op, MemoryBuffer *render);
   static void delete_operation_exports();
+
+  static void start_statistics();
+  static void add_operation_statistics(const NodeOperation *op);
+  static void print_statistics(const ExecutionSystem *system);
 };
 
 }  // namespace blender::compositor
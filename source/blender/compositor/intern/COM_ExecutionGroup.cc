@@ -193,7 +193,7 @@ void ExecutionGroup::init_number_of_chunks()
   }
 }
 
-blender::Array<uint> ExecutionGroup::get_execution_order() const
+blender::Array<uint> ExecutionGroup::get_execution_order(const CompositorContext &context) const
 {
   blender::Array<uint> chunk_order(chunks_len_);
   for (int chunk_index = 0; chunk_index < chunks_len_; chunk_index++) {
@@ -211,6 +211,9 @@ blender::Array<uint> ExecutionGroup::get_execution_order() const
     centerY = viewer->getCenterY();
     order_type = viewer->get_chunk_order();
   }
+  else if (context.is_rendering()) {
+    order_type = ChunkOrdering::SpaceFillingCurve;
+  }
 
   const int border_width = BLI_rcti_size_x(&viewer_border_);
   const int border_height = BLI_rcti_size_y(&viewer_border_);
@@ -280,6 +283,28 @@ blender::Array<uint> ExecutionGroup::get_execution_order() const
 
       break;
     }
+    case ChunkOrdering::SpaceFillingCurve: {
+      uint curve_size = 1;
+      while (curve_size < x_chunks_len_ || curve_size < y_chunks_len_) {
+        curve_size *= 2;
+      }
+
+      blender::Array<ChunkOrder> chunk_orders(chunks_len_);
+      for (index = 0; index < chunks_len_; index++) {
+        const WorkPackage &work_package = work_packages_[index];
+        chunk_orders[index].index = index;
+        chunk_orders[index].x = work_package.rect.xmin - viewer_border_.xmin;
+        chunk_orders[index].y = work_package.rect.ymin - viewer_border_.ymin;
+        chunk_orders[index].update_curve_distance(chunk_size_, curve_size);
+      }
+
+      std::sort(&chunk_orders[0], &chunk_orders[chunks_len_]);
+      for (index = 0; index < chunks_len_; index++) {
+        chunk_order[index] = chunk_orders[index].index;
+      }
+
+      break;
+    }
     case ChunkOrdering::TopDown:
     default:
       break;
@@ -307,7 +332,7 @@ void ExecutionGroup::execute(ExecutionSystem *graph)
   chunks_finished_ = 0;
   bTree_ = bTree;
 
-  blender::Array<uint> chunk_order = get_execution_order();
+  blender::Array<uint> chunk_order = get_execution_order(context);
 
   DebugInfo::execution_group_started(this);
   DebugInfo::graphviz(graph);
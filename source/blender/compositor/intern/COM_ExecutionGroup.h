@@ -20,6 +20,7 @@
 
 namespace blender::compositor {
 
+class CompositorContext;
 class ExecutionSystem;
 class NodeOperation;
 class MemoryProxy;
@@ -214,7 +215,7 @@ class ExecutionGroup {
   /**
    * Return the execution order of the user visible chunks.
    */
-  blender::Array<unsigned int> get_execution_order() const;
+  blender::Array<unsigned int> get_execution_order(const CompositorContext &context) const;
 
   void init_read_buffer_operations();
   void init_work_packages();
@@ -343,6 +344,10 @@ class ExecutionGroup {
    *   - CenterX
    *   - CenterY
    *
+   * When rendering, chunks of other groups are ordered along a space filling curve, so that
+   * chunks scheduled together and the chunks of input groups they depend on are close to each
+   * other and their buffers are reused while still in cache.
+   *
    * After determining the order of the chunks the chunks will be scheduled
    *
    * \see ViewerOperation
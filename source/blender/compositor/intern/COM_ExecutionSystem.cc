@@ -8,6 +8,7 @@
 #include "COM_FullFrameExecutionModel.h"
 #include "COM_NodeOperation.h"
 #include "COM_NodeOperationBuilder.h"
+#include "COM_ResultCache.h"
 #include "COM_TiledExecutionModel.h"
 #include "COM_WorkPackage.h"
 #include "COM_WorkScheduler.h"
@@ -23,7 +24,8 @@ ExecutionSystem::ExecutionSystem(RenderData *rd,
                                  bNodeTree *editingtree,
                                  bool rendering,
                                  bool fastcalculation,
-                                 const char *view_name)
+                                 const char *view_name,
+                                 ResultCache *result_cache)
 {
   num_work_threads_ = WorkScheduler::get_num_cpu_threads();
   context_.set_view_name(view_name);
@@ -44,6 +46,13 @@ ExecutionSystem::ExecutionSystem(RenderData *rd,
 
   context_.set_render_data(rd);
 
+  if (result_cache && context_.get_execution_model() == eExecutionModel::FullFrame) {
+    result_cache->set_max_size(context_.get_cache_memory());
+    if (context_.get_cache_memory() > 0) {
+      context_.set_result_cache(result_cache);
+    }
+  }
+
   BLI_mutex_init(&work_mutex_);
   BLI_condition_init(&work_finished_cond_);
 
@@ -97,6 +106,7 @@ void ExecutionSystem::execute()
     op->init_data();
   }
   execution_model_->execute(*this);
+  DebugInfo::execute_finished(this);
 }
 
 void ExecutionSystem::execute_work(const rcti &work_rect,
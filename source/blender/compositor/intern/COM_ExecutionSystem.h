@@ -107,6 +107,7 @@ namespace blender::compositor {
 class ExecutionGroup;
 class ExecutionModel;
 class NodeOperation;
+class ResultCache;
 
 /**
  * \brief the ExecutionSystem contains the whole compositor tree.
@@ -154,13 +155,16 @@ class ExecutionSystem {
    *
    * \param editingtree: [bNodeTree *]
    * \param rendering: [true false]
+   * \param result_cache: Results kept between executions, used in full frame execution model
+   * when the node tree has a cache memory budget.
    */
   ExecutionSystem(RenderData *rd,
                   Scene *scene,
                   bNodeTree *editingtree,
                   bool rendering,
                   bool fastcalculation,
-                  const char *view_name);
+                  const char *view_name,
+                  ResultCache *result_cache = nullptr);
 
   /**
    * Destructor
@@ -0,0 +1,416 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later
+ * Copyright 2023 Blender Foundation. */
+
+#include <algorithm>
+
+#include "COM_FFTConvolution.h"
+#include "COM_MemoryBuffer.h"
+
+#include "BLI_array.hh"
+#include "BLI_math_base.h"
+#include "BLI_task.hh"
+
+namespace blender::compositor {
+
+/*
+ *  2D Fast Hartley Transform, used for convolution
+ */
+
+using fREAL = float;
+
+/* Returns next highest power of 2 of x, as well its log2 in L2. */
+static uint next_pow2(uint x, uint *L2)
+{
+  uint pw, x_notpow2 = x & (x - 1);
+  *L2 = 0;
+  while (x >>= 1) {
+    ++(*L2);
+  }
+  pw = 1 << (*L2);
+  if (x_notpow2) {
+    (*L2)++;
+    pw <<= 1;
+  }
+  return pw;
+}
+
+//------------------------------------------------------------------------------
+
+/* From FXT library by Joerg Arndt, faster in order bit-reversal
+ * use: `r = revbin_upd(r, h)` where `h = N>>1`. */
+static uint revbin_upd(uint r, uint h)
+{
+  while (!((r ^= h) & h)) {
+    h >>= 1;
+  }
+  return r;
+}
+//------------------------------------------------------------------------------
+static void FHT(fREAL *data, uint M, uint inverse)
+{
+  double tt, fc, dc, fs, ds, a = M_PI;
+  fREAL t1, t2;
+  int n2, bd, bl, istep, k, len = 1 << M, n = 1;
+
+  int i, j = 0;
+  uint Nh = len >> 1;
+  for (i = 1; i < (len - 1); i++) {
+    j = revbin_upd(j, Nh);
+    if (j > i) {
+      t1 = data[i];
+      data[i] = data[j];
+      data[j] = t1;
+    }
+  }
+
+  do {
+    fREAL *data_n = &data[n];
+
+    istep = n << 1;
+    for (k = 0; k < len; k += istep) {
+      t1 = data_n[k];
+      data_n[k] = data[k] - t1;
+      data[k] += t1;
+    }
+
+    n2 = n >> 1;
+    if (n > 2) {
+      fc = dc = cos(a);
+      fs = ds = sqrt(1.0 - fc * fc);  // sin(a);
+      bd = n - 2;
+      for (bl = 1; bl < n2; bl++) {
+        fREAL *data_nbd = &data_n[bd];
+        fREAL *data_bd = &data[bd];
+        for (k = bl; k < len; k += istep) {
+          t1 = fc * double(data_n[k]) + fs * double(data_nbd[k]);
+          t2 = fs * double(data_n[k]) - fc * double(data_nbd[k]);
+          data_n[k] = data[k] - t1;
+          data_nbd[k] = data_bd[k] - t2;
+          data[k] += t1;
+          data_bd[k] += t2;
+        }
+        tt = fc * dc - fs * ds;
+        fs = fs * dc + fc * ds;
+        fc = tt;
+        bd -= 2;
+      }
+    }
+
+    if (n > 1) {
+      for (k = n2; k < len; k += istep) {
+        t1 = data_n[k];
+        data_n[k] = data[k] - t1;
+        data[k] += t1;
+      }
+    }
+
+    n = istep;
+    a *= 0.5;
+  } while (n < len);
+
+  if (inverse) {
+    fREAL sc = (fREAL)1 / (fREAL)len;
+    for (k = 0; k < len; k++) {
+      data[k] *= sc;
+    }
+  }
+}
+//------------------------------------------------------------------------------
+/* 2D Fast Hartley Transform, Mx/My -> log2 of width/height,
+ * nzp -> the row where zero pad data starts,
+ * inverse -> see above. */
+static void FHT2D(fREAL *data, uint Mx, uint My, uint nzp, uint inverse)
+{
+  uint i, j, Nx, Ny, maxy;
+
+  Nx = 1 << Mx;
+  Ny = 1 << My;
+
+  /* Rows (forward transform skips 0 pad data). */
+  maxy = inverse ? Ny : nzp;
+  for (j = 0; j < maxy; j++) {
+    FHT(&data[Nx * j], Mx, inverse);
+  }
+
+  /* Transpose data. */
+  if (Nx == Ny) { /* Square. */
+    for (j = 0; j < Ny; j++) {
+      for (i = j + 1; i < Nx; i++) {
+        uint op = i + (j << Mx), np = j + (i << My);
+        std::swap(data[op], data[np]);
+      }
+    }
+  }
+  else { /* Rectangular. */
+    uint k, Nym = Ny - 1, stm = 1 << (Mx + My);
+    for (i = 0; stm > 0; i++) {
+#define PRED(k) (((k & Nym) << Mx) + (k >> My))
+      for (j = PRED(i); j > i; j = PRED(j)) {
+        /* Pass. */
+      }
+      if (j < i) {
+        continue;
+      }
+      for (k = i, j = PRED(i); j != i; k = j, j = PRED(j), stm--) {
+        std::swap(data[j], data[k]);
+      }
+#undef PRED
+      stm--;
+    }
+  }
+
+  std::swap(Nx, Ny);
+  std::swap(Mx, My);
+
+  /* Now columns == transposed rows. */
+  for (j = 0; j < Ny; j++) {
+    FHT(&data[Nx * j], Mx, inverse);
+  }
+
+  /* Finalize. */
+  for (j = 0; j <= (Ny >> 1); j++) {
+    uint jm = (Ny - j) & (Ny - 1);
+    uint ji = j << Mx;
+    uint jmi = jm << Mx;
+    for (i = 0; i <= (Nx >> 1); i++) {
+      uint im = (Nx - i) & (Nx - 1);
+      fREAL A = data[ji + i];
+      fREAL B = data[jmi + i];
+      fREAL C = data[ji + im];
+      fREAL D = data[jmi + im];
+      fREAL E = (fREAL)0.5 * ((A + D) - (B + C));
+      data[ji + i] = A - E;
+      data[jmi + i] = B + E;
+      data[ji + im] = C + E;
+      data[jmi + im] = D - E;
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+
+/* 2D convolution calc, d1 *= d2, M/N - > log2 of width/height. */
+static void fht_convolve(fREAL *d1, const fREAL *d2, uint M, uint N)
+{
+  fREAL a, b;
+  uint i, j, k, L, mj, mL;
+  uint m = 1 << M, n = 1 << N;
+  uint m2 = 1 << (M - 1), n2 = 1 << (N - 1);
+  uint mn2 = m << (N - 1);
+
+  d1[0] *= d2[0];
+  d1[mn2] *= d2[mn2];
+  d1[m2] *= d2[m2];
+  d1[m2 + mn2] *= d2[m2 + mn2];
+  for (i = 1; i < m2; i++) {
+    k = m - i;
+    a = d1[i] * d2[i] - d1[k] * d2[k];
+    b = d1[k] * d2[i] + d1[i] * d2[k];
+    d1[i] = (b + a) * (fREAL)0.5;
+    d1[k] = (b - a) * (fREAL)0.5;
+    a = d1[i + mn2] * d2[i + mn2] - d1[k + mn2] * d2[k + mn2];
+    b = d1[k + mn2] * d2[i + mn2] + d1[i + mn2] * d2[k + mn2];
+    d1[i + mn2] = (b + a) * (fREAL)0.5;
+    d1[k + mn2] = (b - a) * (fREAL)0.5;
+  }
+  for (j = 1; j < n2; j++) {
+    L = n - j;
+    mj = j << M;
+    mL = L << M;
+    a = d1[mj] * d2[mj] - d1[mL] * d2[mL];
+    b = d1[mL] * d2[mj] + d1[mj] * d2[mL];
+    d1[mj] = (b + a) * (fREAL)0.5;
+    d1[mL] = (b - a) * (fREAL)0.5;
+    a = d1[m2 + mj] * d2[m2 + mj] - d1[m2 + mL] * d2[m2 + mL];
+    b = d1[m2 + mL] * d2[m2 + mj] + d1[m2 + mj] * d2[m2 + mL];
+    d1[m2 + mj] = (b + a) * (fREAL)0.5;
+    d1[m2 + mL] = (b - a) * (fREAL)0.5;
+  }
+  for (i = 1; i < m2; i++) {
+    k = m - i;
+    for (j = 1; j < n2; j++) {
+      L = n - j;
+      mj = j << M;
+      mL = L << M;
+      a = d1[i + mj] * d2[i + mj] - d1[k + mL] * d2[k + mL];
+      b = d1[k + mL] * d2[i + mj] + d1[i + mj] * d2[k + mL];
+      d1[i + mj] = (b + a) * (fREAL)0.5;
+      d1[k + mL] = (b - a) * (fREAL)0.5;
+      a = d1[i + mL] * d2[i + mL] - d1[k + mj] * d2[k + mj];
+      b = d1[k + mj] * d2[i + mL] + d1[i + mL] * d2[k + mj];
+      d1[i + mL] = (b + a) * (fREAL)0.5;
+      d1[k + mj] = (b - a) * (fREAL)0.5;
+    }
+  }
+}
+
+/* Minimum size of the transforms, smaller transforms need more tiles for the same output. */
+constexpr int MIN_FFT_SIZE = 64;
+
+/* Size of the transforms convolving a kernel dimension of given size over an image dimension. */
+static uint get_fft_size(const int kernel_size, const int image_size, uint *r_log2)
+{
+  const int size = std::min(std::max(2 * kernel_size - 1, MIN_FFT_SIZE),
+                            image_size + kernel_size - 1);
+  return next_pow2(std::max(size, 2), r_log2);
+}
+
+void convolve_fft(const MemoryBuffer &image,
+                  const MemoryBuffer &kernel,
+                  const int kernel_center_x,
+                  const int kernel_center_y,
+                  MemoryBuffer &r_output)
+{
+  const rcti &image_rect = image.get_rect();
+  const rcti &kernel_rect = kernel.get_rect();
+  const rcti &output_rect = r_output.get_rect();
+  const int kernel_width = kernel.get_width();
+  const int kernel_height = kernel.get_height();
+  const int output_width = r_output.get_width();
+  const int output_height = r_output.get_height();
+
+  const int num_image_channels = image.get_num_channels();
+  const int num_kernel_channels = kernel.get_num_channels();
+  int num_channels = r_output.get_num_channels();
+  if (num_image_channels > 1) {
+    num_channels = std::min(num_channels, num_image_channels);
+  }
+  if (num_kernel_channels > 1) {
+    num_channels = std::min(num_channels, num_kernel_channels);
+  }
+  if (num_channels < r_output.get_num_channels()) {
+    r_output.clear();
+  }
+  if (output_width == 0 || output_height == 0 || kernel_width == 0 || kernel_height == 0) {
+    return;
+  }
+
+  uint log2_w, log2_h;
+  const uint fft_width = get_fft_size(kernel_width, BLI_rcti_size_x(&image_rect), &log2_w);
+  const uint fft_height = get_fft_size(kernel_height, BLI_rcti_size_y(&image_rect), &log2_h);
+  const int fft_len = fft_width * fft_height;
+
+  /* Transform kernel channels once, they are shared by all tiles. */
+  const int num_kernel_transforms = num_kernel_channels == 1 ? 1 : num_channels;
+  Array<fREAL> kernel_data(int64_t(num_kernel_transforms) * fft_len, 0.0f);
+  threading::parallel_for(IndexRange(num_kernel_transforms), 1, [&](const IndexRange range) {
+    for (const int64_t ch : range) {
+      fREAL *data = &kernel_data[ch * fft_len];
+      for (int y = 0; y < kernel_height; y++) {
+        const float *elem = kernel.get_elem(kernel_rect.xmin, kernel_rect.ymin + y);
+        for (int x = 0; x < kernel_width; x++, elem += kernel.elem_stride) {
+          data[y * fft_width + x] = elem[ch];
+        }
+      }
+      FHT2D(data, log2_w, log2_h, kernel_height, 0);
+    }
+  });
+
+  /* Output pixels of a tile that don't wrap around the transform. */
+  const int tile_width = fft_width - kernel_width + 1;
+  const int tile_height = fft_height - kernel_height + 1;
+  const int num_tiles_x = divide_ceil_u(output_width, tile_width);
+  const int num_tiles_y = divide_ceil_u(output_height, tile_height);
+
+  threading::parallel_for(IndexRange(num_tiles_x * num_tiles_y), 1, [&](const IndexRange range) {
+    Array<fREAL> data(fft_len);
+    for (const int64_t tile : range) {
+      const int tile_x = output_rect.xmin + (tile % num_tiles_x) * tile_width;
+      const int tile_y = output_rect.ymin + (tile / num_tiles_x) * tile_height;
+      const int tile_xmax = std::min(tile_x + tile_width, output_rect.xmax);
+      const int tile_ymax = std::min(tile_y + tile_height, output_rect.ymax);
+
+      /* Image area the tile depends on, clipped to the image. */
+      const int src_x = tile_x + kernel_center_x - kernel_width + 1;
+      const int src_y = tile_y + kernel_center_y - kernel_height + 1;
+      const int src_xmin = std::max(src_x, image_rect.xmin);
+      const int src_xmax = std::min(src_x + int(fft_width), image_rect.xmax);
+      const int src_ymin = std::max(src_y, image_rect.ymin);
+      const int src_ymax = std::min(src_y + int(fft_height), image_rect.ymax);
+
+      for (int ch = 0; ch < num_channels; ch++) {
+        data.fill(0.0f);
+        if (src_xmin >= src_xmax || src_ymin >= src_ymax) {
+          /* Tile doesn't overlap the image. */
+        }
+        else {
+          const int image_ch = num_image_channels == 1 ? 0 : ch;
+          for (int y = src_ymin; y < src_ymax; y++) {
+            fREAL *row = data.data() + (y - src_y) * fft_width;
+            const float *elem = image.get_elem(src_xmin, y);
+            for (int x = src_xmin; x < src_xmax; x++, elem += image.elem_stride) {
+              row[x - src_x] = elem[image_ch];
+            }
+          }
+
+          /* Forward transform, convolve and inverse transform. Transforms transpose data, so
+           * rows and columns are swapped for the convolution. */
+          const int kernel_ch = num_kernel_channels == 1 ? 0 : ch;
+          FHT2D(data.data(), log2_w, log2_h, src_ymax - src_y, 0);
+          fht_convolve(data.data(), &kernel_data[kernel_ch * fft_len], log2_h, log2_w);
+          FHT2D(data.data(), log2_h, log2_w, 0, 1);
+        }
+
+        for (int y = tile_y; y < tile_ymax; y++) {
+          const fREAL *row = data.data() + (y - tile_y + kernel_height - 1) * fft_width +
+                             kernel_width - 1;
+          float *elem = r_output.get_elem(tile_x, y);
+          for (int x = tile_x; x < tile_xmax; x++, elem += r_output.elem_stride) {
+            elem[ch] = row[x - tile_x];
+          }
+        }
+      }
+    }
+  });
+}
+
+void convolve_fft_normalized(const MemoryBuffer &image,
+                             const MemoryBuffer &kernel,
+                             const int kernel_center_x,
+                             const int kernel_center_y,
+                             MemoryBuffer &r_output)
+{
+  convolve_fft(image, kernel, kernel_center_x, kernel_center_y, r_output);
+
+  /* Sum of kernel weights overlapping the image, convolving a constant image of ones. */
+  const float one = 1.0f;
+  MemoryBuffer image_mask(const_cast<float *>(&one), 1, image.get_rect(), true);
+  MemoryBuffer weights(COM_num_channels_data_type(kernel.get_num_channels()),
+                       r_output.get_rect());
+  convolve_fft(image_mask, kernel, kernel_center_x, kernel_center_y, weights);
+
+  /* Transforms leave errors relative to the kernel sum where no kernel weights overlap the image,
+   * smaller weights are considered zero. */
+  const int num_channels = r_output.get_num_channels();
+  const int num_weight_channels = weights.get_num_channels();
+  float min_weights[4] = {0.0f};
+  const rcti &kernel_rect = kernel.get_rect();
+  for (int y = kernel_rect.ymin; y < kernel_rect.ymax; y++) {
+    for (int x = kernel_rect.xmin; x < kernel_rect.xmax; x++) {
+      const float *elem = kernel.get_elem(x, y);
+      for (int ch = 0; ch < num_weight_channels; ch++) {
+        min_weights[ch] += fabsf(elem[ch]) * 1e-5f;
+      }
+    }
+  }
+
+  threading::parallel_for(
+      IndexRange(r_output.get_height()), 16, [&](const IndexRange range) {
+        const rcti &rect = r_output.get_rect();
+        for (const int64_t y : range) {
+          float *elem = r_output.get_elem(rect.xmin, rect.ymin + y);
+          const float *weight = weights.get_elem(rect.xmin, rect.ymin + y);
+          for (int x = rect.xmin; x < rect.xmax;
+               x++, elem += r_output.elem_stride, weight += weights.elem_stride) {
+            for (int ch = 0; ch < num_channels; ch++) {
+              /* Output channels missing in the kernel are zero. */
+              const int weight_ch = std::min(ch, num_weight_channels - 1);
+              const float w = weight[weight_ch];
+              elem[ch] = w > min_weights[weight_ch] ? elem[ch] / w : 0.0f;
+            }
+          }
+        }
+      });
+}
+
+}  // namespace blender::compositor
@@ -0,0 +1,44 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later
+ * Copyright 2023 Blender Foundation. */
+
+#pragma once
+
+namespace blender::compositor {
+
+class MemoryBuffer;
+
+/**
+ * Kernel radius from which convolving with #convolve_fft is faster than convolving directly.
+ */
+constexpr int FFT_CONVOLUTION_MIN_RADIUS = 16;
+
+/**
+ * Convolves an image with a kernel using the Fast Hartley Transform. The output area is split
+ * in tiles that are convolved in parallel, each one reading the image area it depends on
+ * (overlap-save). Image is considered to be zero outside its rect.
+ *
+ * Output pixel at (x, y) is the sum of the image pixels at (x + center_x - i, y + center_y - j)
+ * weighted by kernel element (i, j), relative to kernel rect.
+ *
+ * A kernel or image of a single channel is used for all output channels. Otherwise each output
+ * channel is the convolution of the same image and kernel channels, and output channels missing
+ * in image or kernel are zero.
+ */
+void convolve_fft(const MemoryBuffer &image,
+                  const MemoryBuffer &kernel,
+                  int kernel_center_x,
+                  int kernel_center_y,
+                  MemoryBuffer &r_output);
+
+/**
+ * Convolves as #convolve_fft, and divides each output channel by the sum of the kernel weights
+ * overlapping the image rect. Output pixels are weighted averages of the image pixels inside its
+ * rect, as when convolving directly and skipping pixels outside the image.
+ */
+void convolve_fft_normalized(const MemoryBuffer &image,
+                             const MemoryBuffer &kernel,
+                             int kernel_center_x,
+                             int kernel_center_y,
+                             MemoryBuffer &r_output);
+
+}  // namespace blender::compositor
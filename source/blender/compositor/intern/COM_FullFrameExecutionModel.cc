@@ -3,9 +3,13 @@
 
 #include "COM_FullFrameExecutionModel.h"
 
+#include "BLI_set.hh"
+
 #include "BLT_translation.h"
 
 #include "COM_Debug.h"
+#include "COM_ResultCache.h"
+#include "COM_SharedOperationBuffers.h"
 #include "COM_ViewerOperation.h"
 #include "COM_WorkScheduler.h"
 
@@ -20,8 +24,13 @@ FullFrameExecutionModel::FullFrameExecutionModel(CompositorContext &context,
                                                  Span<NodeOperation *> operations)
     : ExecutionModel(context, operations),
       active_buffers_(shared_buffers),
-      num_operations_finished_(0)
+      num_operations_finished_(0),
+      max_memory_(context.get_max_memory()),
+      strip_buffers_(nullptr)
 {
+  active_buffers_.set_use_half_storage(context.is_half_buffers_enabled());
+  active_buffers_.set_result_cache(context.get_result_cache());
+
   priorities_.append(eCompositorPriority::High);
   if (!context.is_fast_calculation()) {
     priorities_.append(eCompositorPriority::Medium);
@@ -52,8 +61,13 @@ void FullFrameExecutionModel::determine_areas_to_render_and_reads()
       op->set_bnodetree(node_tree);
       if (op->is_output_operation(is_rendering) && op->get_render_priority() == priority) {
         get_output_render_area(op, area);
-        determine_areas_to_render(op, area);
-        determine_reads(op);
+        determine_areas_to_render(op, area, active_buffers_);
+        determine_reads(op, active_buffers_);
+
+        const int num_strips = determine_num_strips(op, area);
+        if (num_strips > 1) {
+          output_num_strips_.add(op, num_strips);
+        }
       }
     }
   }
@@ -69,7 +83,9 @@ Vector<MemoryBuffer *> FullFrameExecutionModel::get_input_buffers(NodeOperation
     NodeOperation *input = op->get_input_operation(i);
     const int offset_x = (input->get_canvas().xmin - op->get_canvas().xmin) + output_x;
     const int offset_y = (input->get_canvas().ymin - op->get_canvas().ymin) + output_y;
-    MemoryBuffer *buf = active_buffers_.get_rendered_buffer(input);
+    const bool is_strip_input = strip_buffers_ && strip_buffers_->is_operation_rendered(input);
+    MemoryBuffer *buf = is_strip_input ? strip_buffers_->get_rendered_buffer(input) :
+                                         active_buffers_.get_rendered_buffer(input);
 
     rcti rect = buf->get_rect();
     BLI_rcti_translate(&rect, offset_x, offset_y);
@@ -105,6 +121,7 @@ void FullFrameExecutionModel::render_operation(NodeOperation *op)
     const int op_offset_x = output_x - op->get_canvas().xmin;
     const int op_offset_y = output_y - op->get_canvas().ymin;
     Vector<rcti> areas = active_buffers_.get_areas_to_render(op, op_offset_x, op_offset_y);
+    DebugInfo::operation_render_started(op);
     op->render(op_buf, areas, input_bufs);
     DebugInfo::operation_rendered(op, op_buf);
 
@@ -119,6 +136,49 @@ void FullFrameExecutionModel::render_operation(NodeOperation *op)
   operation_finished(op);
 }
 
+void FullFrameExecutionModel::render_strip_operation(NodeOperation *op)
+{
+  SharedOperationBuffers &buffers = *strip_buffers_;
+  const int op_offset_x = -op->get_canvas().xmin;
+  const int op_offset_y = -op->get_canvas().ymin;
+  Vector<rcti> areas = buffers.get_areas_to_render(op, op_offset_x, op_offset_y);
+
+  /* Only allocate the bounds of the areas needed by the strip. */
+  rcti rect;
+  BLI_rcti_init(&rect, 0, 0, 0, 0);
+  if (!areas.is_empty()) {
+    rect = areas[0];
+    for (const rcti &area : areas.as_span().drop_front(1)) {
+      BLI_rcti_union(&rect, &area);
+    }
+  }
+
+  const DataType data_type = op->get_output_socket(0)->get_data_type();
+  const bool is_a_single_elem = op->get_flags().is_constant_operation;
+  MemoryBuffer *op_buf = new MemoryBuffer(data_type, rect, is_a_single_elem);
+  if (!areas.is_empty()) {
+    Vector<MemoryBuffer *> input_bufs = get_input_buffers(op, 0, 0);
+    DebugInfo::operation_render_started(op);
+    op->render(op_buf, areas, input_bufs);
+    DebugInfo::operation_strip_rendered(op);
+
+    for (MemoryBuffer *buf : input_bufs) {
+      delete buf;
+    }
+  }
+  buffers.set_rendered_buffer(op, std::unique_ptr<MemoryBuffer>(op_buf));
+
+  /* Reads of inputs rendered before the strips are reported once all strips are finished, see
+   * #render_output_dependencies_in_strips. */
+  const int num_inputs = op->get_number_of_input_sockets();
+  for (int i = 0; i < num_inputs; i++) {
+    NodeOperation *input = op->get_input_operation(i);
+    if (buffers.is_operation_rendered(input)) {
+      buffers.read_finished(input);
+    }
+  }
+}
+
 void FullFrameExecutionModel::render_operations()
 {
   const bool is_rendering = context_.is_rendering();
@@ -130,7 +190,13 @@ void FullFrameExecutionModel::render_operations()
       const bool is_priority_output = op->is_output_operation(is_rendering) &&
                                       op->get_render_priority() == priority;
       if (is_priority_output && has_size) {
-        render_output_dependencies(op);
+        const int num_strips = output_num_strips_.lookup_default(op, 1);
+        if (num_strips > 1) {
+          render_output_dependencies_in_strips(op, num_strips);
+        }
+        else {
+          render_output_dependencies(op);
+        }
         render_operation(op);
       }
       else if (is_priority_output && !has_size && op->is_active_viewer_output()) {
@@ -141,11 +207,8 @@ void FullFrameExecutionModel::render_operations()
   WorkScheduler::stop();
 }
 
-/**
- * Returns all dependencies from inputs to outputs. A dependency may be repeated when
- * several operations depend on it.
- */
-static Vector<NodeOperation *> get_operation_dependencies(NodeOperation *operation)
+Vector<NodeOperation *> FullFrameExecutionModel::get_operation_dependencies(
+    NodeOperation *operation)
 {
   /* Get dependencies from outputs to inputs. */
   Vector<NodeOperation *> dependencies;
@@ -155,6 +218,10 @@ static Vector<NodeOperation *> get_operation_dependencies(NodeOperation *operati
     Vector<NodeOperation *> outputs(next_outputs);
     next_outputs.clear();
     for (NodeOperation *output : outputs) {
+      /* Inputs of an operation rendered in strips for another output may not be rendered. */
+      if (active_buffers_.is_operation_rendered(output)) {
+        continue;
+      }
       for (int i = 0; i < output->get_number_of_input_sockets(); i++) {
         next_outputs.append(output->get_input_operation(i));
       }
@@ -179,8 +246,168 @@ void FullFrameExecutionModel::render_output_dependencies(NodeOperation *output_o
   }
 }
 
+void FullFrameExecutionModel::render_output_dependencies_in_strips(NodeOperation *output_op,
+                                                                   const int num_strips)
+{
+  rcti output_area;
+  get_output_render_area(output_op, output_area);
+
+  Vector<rcti> strips;
+  const int height = BLI_rcti_size_y(&output_area);
+  for (int i = 0; i < num_strips; i++) {
+    rcti strip = output_area;
+    strip.ymin = output_area.ymin + int64_t(height) * i / num_strips;
+    strip.ymax = output_area.ymin + int64_t(height) * (i + 1) / num_strips;
+    strips.append(strip);
+  }
+
+  /* Operations with an unbounded area of interest would be rendered in full for every strip,
+   * render them once instead, together with their dependencies. */
+  Vector<NodeOperation *> dependencies = get_operation_dependencies(output_op);
+  Set<NodeOperation *> full_frame_ops;
+  for (const rcti &strip : strips) {
+    SharedOperationBuffers strip_areas;
+    determine_areas_to_render(output_op, strip, strip_areas);
+    for (NodeOperation *op : dependencies) {
+      if (op != output_op && strip_areas.is_area_registered(op, op->get_canvas())) {
+        full_frame_ops.add(op);
+      }
+    }
+  }
+  for (NodeOperation *op : dependencies) {
+    if (full_frame_ops.contains(op) && !active_buffers_.is_operation_rendered(op)) {
+      for (NodeOperation *dependency : get_operation_dependencies(op)) {
+        if (!active_buffers_.is_operation_rendered(dependency)) {
+          render_operation(dependency);
+        }
+      }
+      render_operation(op);
+    }
+  }
+
+  /* Output operation inputs are filled strip by strip. */
+  Map<NodeOperation *, std::unique_ptr<MemoryBuffer>> output_inputs;
+  for (int i = 0; i < output_op->get_number_of_input_sockets(); i++) {
+    NodeOperation *input = output_op->get_input_operation(i);
+    if (!active_buffers_.is_operation_rendered(input)) {
+      output_inputs.lookup_or_add_cb(input, [&]() {
+        return std::unique_ptr<MemoryBuffer>(create_operation_buffer(input, 0, 0));
+      });
+    }
+  }
+
+  Vector<NodeOperation *> strip_ops;
+  Set<NodeOperation *> visited;
+  for (NodeOperation *op : get_operation_dependencies(output_op)) {
+    if (op != output_op && !active_buffers_.is_operation_rendered(op) && visited.add(op)) {
+      strip_ops.append(op);
+    }
+  }
+
+  for (const rcti &strip : strips) {
+    SharedOperationBuffers strip_buffers;
+    strip_buffers_ = &strip_buffers;
+    determine_areas_to_render(output_op, strip, strip_buffers);
+    determine_reads(output_op, strip_buffers);
+
+    for (NodeOperation *op : strip_ops) {
+      render_strip_operation(op);
+    }
+
+    for (auto item : output_inputs.items()) {
+      MemoryBuffer *strip_buf = strip_buffers.get_rendered_buffer(item.key);
+      item.value->copy_from(strip_buf, strip_buf->get_rect());
+    }
+    strip_buffers_ = nullptr;
+  }
+
+  for (auto item : output_inputs.items()) {
+    active_buffers_.set_rendered_buffer(item.key, std::move(item.value));
+  }
+
+  /* Report the reads of operations rendered in strips registered by #determine_reads, so that
+   * their inputs rendered in full, including the output operation inputs, are disposed or cached
+   * once their remaining readers finish. */
+  for (NodeOperation *op : strip_ops) {
+    for (int i = 0; i < op->get_number_of_input_sockets(); i++) {
+      NodeOperation *input = op->get_input_operation(i);
+      if (active_buffers_.is_operation_rendered(input)) {
+        active_buffers_.read_finished(input);
+      }
+    }
+  }
+}
+
+int FullFrameExecutionModel::determine_num_strips(NodeOperation *output_op,
+                                                  const rcti &output_area)
+{
+  if (max_memory_ == 0) {
+    return 1;
+  }
+
+  auto get_buffer_bytes = [](NodeOperation *op) -> size_t {
+    if (op->get_number_of_output_sockets() == 0 || op->get_flags().is_constant_operation) {
+      return 0;
+    }
+    const DataType data_type = op->get_output_socket(0)->get_data_type();
+    return size_t(op->get_width()) * op->get_height() * COM_data_type_bytes_len(data_type);
+  };
+
+  /* Simulate rendering in order, freeing buffers once all their readers are rendered. */
+  Vector<NodeOperation *> dependencies = get_operation_dependencies(output_op);
+  Map<NodeOperation *, int> remaining_reads;
+  Set<NodeOperation *> visited;
+  for (NodeOperation *op : dependencies) {
+    if (visited.add(op)) {
+      for (int i = 0; i < op->get_number_of_input_sockets(); i++) {
+        remaining_reads.lookup_or_add(op->get_input_operation(i), 0)++;
+      }
+    }
+  }
+
+  size_t memory = 0;
+  size_t peak_memory = 0;
+  visited.clear();
+  for (NodeOperation *op : dependencies) {
+    if (!visited.add(op)) {
+      continue;
+    }
+    memory += get_buffer_bytes(op);
+    peak_memory = std::max(peak_memory, memory);
+    for (int i = 0; i < op->get_number_of_input_sockets(); i++) {
+      NodeOperation *input = op->get_input_operation(i);
+      if (--remaining_reads.lookup(input) == 0) {
+        memory -= get_buffer_bytes(input);
+      }
+    }
+  }
+
+  if (peak_memory <= max_memory_) {
+    return 1;
+  }
+
+  /* Output operation inputs are kept in full, the remaining memory is used by strips. */
+  size_t inputs_memory = 0;
+  Set<NodeOperation *> inputs;
+  for (int i = 0; i < output_op->get_number_of_input_sockets(); i++) {
+    NodeOperation *input = output_op->get_input_operation(i);
+    if (inputs.add(input)) {
+      inputs_memory += get_buffer_bytes(input);
+    }
+  }
+
+  const int max_num_strips = std::max(BLI_rcti_size_y(&output_area) / MIN_STRIP_HEIGHT, 1);
+  if (inputs_memory >= max_memory_) {
+    return max_num_strips;
+  }
+  const size_t strips_memory = max_memory_ - inputs_memory;
+  const size_t num_strips = (peak_memory + strips_memory - 1) / strips_memory;
+  return int(std::min(num_strips, size_t(max_num_strips)));
+}
+
 void FullFrameExecutionModel::determine_areas_to_render(NodeOperation *output_op,
-                                                        const rcti &output_area)
+                                                        const rcti &output_area,
+                                                        SharedOperationBuffers &buffers)
 {
   BLI_assert(output_op->is_output_operation(context_.is_rendering()));
 
@@ -190,12 +417,15 @@ void FullFrameExecutionModel::determine_areas_to_render(NodeOperation *output_op
     std::pair<NodeOperation *, rcti> pair = stack.pop_last();
     NodeOperation *operation = pair.first;
     const rcti &render_area = pair.second;
-    if (BLI_rcti_is_empty(&render_area) ||
-        active_buffers_.is_area_registered(operation, render_area)) {
+    if (BLI_rcti_is_empty(&render_area) || active_buffers_.is_operation_rendered(operation) ||
+        buffers.is_area_registered(operation, render_area)) {
+      continue;
+    }
+    if (&buffers == &active_buffers_ && use_cached_result(operation)) {
       continue;
     }
 
-    active_buffers_.register_area(operation, render_area);
+    buffers.register_area(operation, render_area);
 
     const int num_inputs = operation->get_number_of_input_sockets();
     for (int i = 0; i < num_inputs; i++) {
@@ -211,7 +441,24 @@ void FullFrameExecutionModel::determine_areas_to_render(NodeOperation *output_op
   }
 }
 
-void FullFrameExecutionModel::determine_reads(NodeOperation *output_op)
+bool FullFrameExecutionModel::use_cached_result(NodeOperation *op)
+{
+  ResultCache *result_cache = context_.get_result_cache();
+  const std::optional<size_t> result_hash = op->get_result_hash();
+  if (result_cache == nullptr || !result_hash) {
+    return false;
+  }
+
+  std::unique_ptr<MemoryBuffer> buffer = result_cache->take(*result_hash);
+  if (buffer == nullptr) {
+    return false;
+  }
+  active_buffers_.set_cached_buffer(op, std::move(buffer));
+  return true;
+}
+
+void FullFrameExecutionModel::determine_reads(NodeOperation *output_op,
+                                              SharedOperationBuffers &buffers)
 {
   BLI_assert(output_op->is_output_operation(context_.is_rendering()));
 
@@ -222,10 +469,17 @@ void FullFrameExecutionModel::determine_reads(NodeOperation *output_op)
     const int num_inputs = operation->get_number_of_input_sockets();
     for (int i = 0; i < num_inputs; i++) {
       NodeOperation *input_op = operation->get_input_operation(i);
-      if (!active_buffers_.has_registered_reads(input_op)) {
+      if (active_buffers_.is_operation_rendered(input_op)) {
+        /* Results taken from the cache are read as rendered ones, without rendering inputs. */
+        if (&buffers == &active_buffers_) {
+          buffers.register_read(input_op);
+        }
+        continue;
+      }
+      if (!buffers.has_registered_reads(input_op)) {
         stack.append(input_op);
       }
-      active_buffers_.register_read(input_op);
+      buffers.register_read(input_op);
     }
   }
 }
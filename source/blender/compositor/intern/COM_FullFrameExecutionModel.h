@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include "BLI_map.hh"
 #include "BLI_vector.hh"
 
 #include "COM_Enums.h"
@@ -42,6 +43,26 @@ class FullFrameExecutionModel : public ExecutionModel {
    */
   Vector<eCompositorPriority> priorities_;
 
+  /**
+   * Maximum bytes of buffers to render an output operation at once, 0 for no limit.
+   */
+  size_t max_memory_;
+
+  /**
+   * Output operations exceeding the memory limit and the number of strips they are split into.
+   */
+  Map<NodeOperation *, int> output_num_strips_;
+
+  /**
+   * Buffers of the strip being rendered, null when not rendering a strip.
+   */
+  SharedOperationBuffers *strip_buffers_;
+
+  /**
+   * Minimum height of the strips outputs are split into when exceeding the memory limit.
+   */
+  static constexpr int MIN_STRIP_HEIGHT = 32;
+
  public:
   FullFrameExecutionModel(CompositorContext &context,
                           SharedOperationBuffers &shared_buffers,
@@ -49,13 +70,24 @@ class FullFrameExecutionModel : public ExecutionModel {
 
   void execute(ExecutionSystem &exec_system) override;
 
- private:
+ protected:
   void determine_areas_to_render_and_reads();
   /**
    * Render output operations in order of priority.
    */
   void render_operations();
   void render_output_dependencies(NodeOperation *output_op);
+  /**
+   * Renders output operation dependencies strip by strip, to bound the memory used by buffers.
+   * Only output operation inputs are fully allocated. Operations that need their whole canvas
+   * for a strip are rendered once before the strips.
+   */
+  void render_output_dependencies_in_strips(NodeOperation *output_op, int num_strips);
+  /**
+   * Returns all dependencies from inputs to outputs, not including inputs of already rendered
+   * operations. A dependency may be repeated when several operations depend on it.
+   */
+  Vector<NodeOperation *> get_operation_dependencies(NodeOperation *operation);
   /**
    * Returns input buffers with an offset relative to given output coordinates.
    * Returned memory buffers must be deleted.
@@ -63,6 +95,11 @@ class FullFrameExecutionModel : public ExecutionModel {
   Vector<MemoryBuffer *> get_input_buffers(NodeOperation *op, int output_x, int output_y);
   MemoryBuffer *create_operation_buffer(NodeOperation *op, int output_x, int output_y);
   void render_operation(NodeOperation *op);
+  /**
+   * Renders the areas of given operation needed by current strip, into a buffer that only
+   * contains those areas.
+   */
+  void render_strip_operation(NodeOperation *op);
 
   void operation_finished(NodeOperation *operation);
 
@@ -72,14 +109,27 @@ class FullFrameExecutionModel : public ExecutionModel {
    */
   void get_output_render_area(NodeOperation *output_op, rcti &r_area);
   /**
-   * Determines all operations areas needed to render given output area.
+   * Determines all operations areas needed to render given output area. Already rendered
+   * operations are skipped.
    */
-  void determine_areas_to_render(NodeOperation *output_op, const rcti &output_area);
+  void determine_areas_to_render(NodeOperation *output_op,
+                                 const rcti &output_area,
+                                 SharedOperationBuffers &buffers);
   /**
    * Determines reads to receive by operations in output operation tree (i.e: Number of dependent
-   * operations each operation has).
+   * operations each operation has). Already rendered operations are skipped.
+   */
+  void determine_reads(NodeOperation *output_op, SharedOperationBuffers &buffers);
+  /**
+   * Takes given operation result from the result cache when it has been kept from a previous
+   * execution. Returns whether it was found, in which case it doesn't need to be rendered.
+   */
+  bool use_cached_result(NodeOperation *op);
+  /**
+   * Estimates the peak memory of buffers to render given output operation at once, and returns
+   * the number of strips to split it into to stay within the memory limit.
    */
-  void determine_reads(NodeOperation *output_op);
+  int determine_num_strips(NodeOperation *output_op, const rcti &output_area);
 
   void update_progress_bar();
 
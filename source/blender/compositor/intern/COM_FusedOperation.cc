@@ -0,0 +1,163 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later
+ * Copyright 2023 Blender Foundation. */
+
+#include "BLI_array.hh"
+#include "BLI_map.hh"
+
+#include "COM_FusedOperation.h"
+
+namespace blender::compositor {
+
+/**
+ * Number of pixels rendered by every member operation before rendering the next block. Small
+ * enough for the intermediate results to stay in the CPU cache.
+ */
+constexpr int BLOCK_NUM_PIXELS = 8192;
+
+FusedOperation::FusedOperation(Span<NodeOperation *> members)
+{
+  BLI_assert(members.size() > 1);
+
+  Map<NodeOperation *, int> member_indices;
+  Map<NodeOperationOutput *, int> fused_input_indices;
+  for (NodeOperation *member : members) {
+    BLI_assert(member->get_flags().is_pixel_operation);
+    BLI_assert(BLI_rcti_compare(&member->get_canvas(), &members.last()->get_canvas()));
+
+    Vector<MemberInput> inputs;
+    for (int i = 0; i < member->get_number_of_input_sockets(); i++) {
+      NodeOperationInput *socket = member->get_input_socket(i);
+      NodeOperationOutput *link = socket->get_link();
+      BLI_assert(link != nullptr);
+
+      const int member_index = member_indices.lookup_default(&link->get_operation(), -1);
+      if (member_index != -1) {
+        inputs.append({member_index, -1});
+        continue;
+      }
+
+      const int fused_input_index = fused_input_indices.lookup_or_add_cb(link, [&]() {
+        add_input_socket(socket->get_data_type(), socket->get_resize_mode());
+        fused_input_links_.append(link);
+        return int(fused_input_links_.size()) - 1;
+      });
+      inputs.append({-1, fused_input_index});
+    }
+
+    member_indices.add_new(member, members_.size());
+    members_.append(static_cast<MultiThreadedOperation *>(member));
+    member_inputs_.append(std::move(inputs));
+  }
+
+  NodeOperation *last_member = members.last();
+  add_output_socket(last_member->get_output_socket()->get_data_type());
+  set_canvas(last_member->get_canvas());
+  set_name(last_member->get_name());
+  set_result_hash(last_member->get_result_hash());
+}
+
+FusedOperation::~FusedOperation()
+{
+  for (MultiThreadedOperation *member : members_) {
+    delete member;
+  }
+}
+
+void FusedOperation::init_data()
+{
+  for (MultiThreadedOperation *member : members_) {
+    member->init_data();
+  }
+}
+
+void FusedOperation::init_execution()
+{
+  for (MultiThreadedOperation *member : members_) {
+    member->init_execution();
+  }
+}
+
+void FusedOperation::deinit_execution()
+{
+  for (MultiThreadedOperation *member : members_) {
+    member->deinit_execution();
+  }
+}
+
+void FusedOperation::get_area_of_interest(const int input_idx,
+                                          const rcti &output_area,
+                                          rcti &r_input_area)
+{
+  /* Members are pixel operations of the same canvas, all of them render the output area. */
+  bool is_first_reader = true;
+  for (const int i : members_.index_range()) {
+    for (const int socket_idx : member_inputs_[i].index_range()) {
+      const MemberInput &input = member_inputs_[i][socket_idx];
+      if (input.member_index != -1 || input.fused_input_index != input_idx) {
+        continue;
+      }
+
+      rcti member_input_area;
+      members_[i]->get_area_of_interest(socket_idx, output_area, member_input_area);
+      if (is_first_reader) {
+        r_input_area = member_input_area;
+        is_first_reader = false;
+      }
+      else {
+        BLI_rcti_union(&r_input_area, &member_input_area);
+      }
+    }
+  }
+  BLI_assert(!is_first_reader);
+}
+
+void FusedOperation::update_memory_buffer_partial(MemoryBuffer *output,
+                                                  const rcti &area,
+                                                  Span<MemoryBuffer *> inputs)
+{
+  const int width = BLI_rcti_size_x(&area);
+  const int block_num_rows = max_ii(BLOCK_NUM_PIXELS / max_ii(width, 1), 1);
+  const int last_member = members_.size() - 1;
+
+  /* Intermediate buffers of all members but the last one, which writes to output. */
+  Array<int> buffer_offsets(members_.size());
+  buffer_offsets[0] = 0;
+  for (int i = 0; i < last_member; i++) {
+    const DataType data_type = members_[i]->get_output_socket()->get_data_type();
+    buffer_offsets[i + 1] = buffer_offsets[i] +
+                            COM_data_type_num_channels(data_type) * width * block_num_rows;
+  }
+  Array<float> block_buffers(buffer_offsets.last());
+
+  Array<MemoryBuffer *> member_outputs(members_.size());
+  Vector<MemoryBuffer *> member_inputs;
+  for (int ymin = area.ymin; ymin < area.ymax; ymin += block_num_rows) {
+    rcti block;
+    BLI_rcti_init(&block, area.xmin, area.xmax, ymin, min_ii(ymin + block_num_rows, area.ymax));
+
+    for (const int i : members_.index_range()) {
+      member_inputs.clear();
+      for (const MemberInput &input : member_inputs_[i]) {
+        member_inputs.append(input.member_index == -1 ? inputs[input.fused_input_index] :
+                                                        member_outputs[input.member_index]);
+      }
+
+      if (i == last_member) {
+        member_outputs[i] = output;
+      }
+      else {
+        const DataType data_type = members_[i]->get_output_socket()->get_data_type();
+        member_outputs[i] = new MemoryBuffer(&block_buffers[buffer_offsets[i]],
+                                             COM_data_type_num_channels(data_type),
+                                             block);
+      }
+      members_[i]->update_memory_buffer_partial(member_outputs[i], block, member_inputs);
+    }
+
+    for (int i = 0; i < last_member; i++) {
+      delete member_outputs[i];
+    }
+  }
+}
+
+}  // namespace blender::compositor
@@ -0,0 +1,66 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later
+ * Copyright 2023 Blender Foundation. */
+
+#pragma once
+
+#include "COM_MultiThreadedOperation.h"
+
+namespace blender::compositor {
+
+/**
+ * Executes a group of linked pixel operations (see #NodeOperationFlags.is_pixel_operation) as a
+ * single operation. Areas are rendered in blocks of rows, each member operation rendering the
+ * block into a small temporary buffer read by the next ones, so that intermediate results are
+ * never stored at full size. Only used in full frame execution model.
+ */
+class FusedOperation : public MultiThreadedOperation {
+ private:
+  struct MemberInput {
+    /** Index of the member operation writing the input, or -1 when read from a fused input. */
+    int member_index;
+    /** Index of the fused input socket when not written by a member operation. */
+    int fused_input_index;
+  };
+
+  /** Owned member operations in execution order. Last one writes the fused output. */
+  Vector<MultiThreadedOperation *> members_;
+
+  /** Source of each input socket of each member operation. */
+  Vector<Vector<MemberInput>> member_inputs_;
+
+  /** Output socket read by each fused input socket. */
+  Vector<NodeOperationOutput *> fused_input_links_;
+
+ public:
+  /**
+   * \param members: Pixel operations of the same canvas, sorted so that every member is after
+   * the members it reads. Every member but the last one must only be read by other members.
+   * Ownership is taken.
+   */
+  FusedOperation(Span<NodeOperation *> members);
+  ~FusedOperation();
+
+  Span<MultiThreadedOperation *> get_members() const
+  {
+    return members_;
+  }
+
+  /** Output socket that should be linked to the given fused input socket. */
+  NodeOperationOutput *get_fused_input_link(int index) const
+  {
+    return fused_input_links_[index];
+  }
+
+  void init_data() override;
+  void init_execution() override;
+  void deinit_execution() override;
+
+  void get_area_of_interest(int input_idx, const rcti &output_area, rcti &r_input_area) override;
+
+ protected:
+  void update_memory_buffer_partial(MemoryBuffer *output,
+                                    const rcti &area,
+                                    Span<MemoryBuffer *> inputs) override;
+};
+
+}  // namespace blender::compositor
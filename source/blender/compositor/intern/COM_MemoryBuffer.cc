@@ -5,6 +5,10 @@
 
 #include "COM_MemoryProxy.h"
 
+#include "BLI_math_base.h"
+#include "BLI_math_bits.h"
+#include "BLI_task.hh"
+
 #include "IMB_colormanagement.h"
 #include "IMB_imbuf_types.h"
 
@@ -37,6 +41,7 @@ MemoryBuffer::MemoryBuffer(MemoryProxy *memory_proxy, const rcti &rect, MemoryBu
   num_channels_ = COM_data_type_num_channels(memory_proxy->get_data_type());
   buffer_ = (float *)MEM_mallocN_aligned(
       sizeof(float) * buffer_len() * num_channels_, 16, "COM_MemoryBuffer");
+  half_buffer_ = nullptr;
   owns_data_ = true;
   state_ = state;
   datatype_ = memory_proxy->get_data_type();
@@ -52,6 +57,7 @@ MemoryBuffer::MemoryBuffer(DataType data_type, const rcti &rect, bool is_a_singl
   num_channels_ = COM_data_type_num_channels(data_type);
   buffer_ = (float *)MEM_mallocN_aligned(
       sizeof(float) * buffer_len() * num_channels_, 16, "COM_MemoryBuffer");
+  half_buffer_ = nullptr;
   owns_data_ = true;
   state_ = MemoryBufferState::Temporary;
   datatype_ = data_type;
@@ -76,6 +82,7 @@ MemoryBuffer::MemoryBuffer(float *buffer,
   num_channels_ = num_channels;
   datatype_ = COM_num_channels_data_type(num_channels);
   buffer_ = buffer;
+  half_buffer_ = nullptr;
   owns_data_ = false;
   state_ = MemoryBufferState::Temporary;
 
@@ -171,6 +178,69 @@ MemoryBuffer::~MemoryBuffer()
     MEM_freeN(buffer_);
     buffer_ = nullptr;
   }
+  MEM_SAFE_FREE(half_buffer_);
+}
+
+static uint16_t float_to_half(const float value)
+{
+  /* Clamp to the largest finite half float, NaN is stored as zero. */
+  if (!(value == value)) {
+    return 0;
+  }
+  const float clamped = clamp_f(value, -65504.0f, 65504.0f);
+  const uint bits = float_as_uint(clamped);
+  const uint16_t sign = (bits >> 16) & 0x8000;
+  uint abs_bits = bits & 0x7fffffff;
+  if (abs_bits < 0x38800000) {
+    /* Sub-normal half floats, in multiples of 2^-24. */
+    return sign | uint16_t(fabsf(clamped) * 16777216.0f + 0.5f);
+  }
+  /* Rebias exponent and round mantissa to nearest even. */
+  abs_bits += 0x00000fff + ((abs_bits >> 13) & 1);
+  return sign | uint16_t((abs_bits - 0x38000000) >> 13);
+}
+
+static float half_to_float(const uint16_t value)
+{
+  const uint sign = uint(value & 0x8000) << 16;
+  const uint exponent = (value >> 10) & 0x1f;
+  const uint mantissa = value & 0x3ff;
+  if (exponent == 0) {
+    const float abs_value = float(mantissa) * (1.0f / 16777216.0f);
+    return sign ? -abs_value : abs_value;
+  }
+  return uint_as_float(sign | ((exponent + 112) << 23) | (mantissa << 13));
+}
+
+void MemoryBuffer::use_half_storage()
+{
+  BLI_assert(owns_data_ && !is_a_single_elem_);
+  if (half_buffer_ == nullptr) {
+    const int64_t len = int64_t(buffer_len()) * num_channels_;
+    half_buffer_ = (uint16_t *)MEM_mallocN_aligned(
+        sizeof(uint16_t) * len, 16, "COM_MemoryBuffer half");
+    threading::parallel_for(IndexRange(len), 64 * 1024, [&](const IndexRange range) {
+      for (const int64_t i : range) {
+        half_buffer_[i] = float_to_half(buffer_[i]);
+      }
+    });
+  }
+  MEM_SAFE_FREE(buffer_);
+}
+
+void MemoryBuffer::restore_float_storage()
+{
+  BLI_assert(half_buffer_ != nullptr);
+  if (buffer_ != nullptr) {
+    return;
+  }
+  const int64_t len = int64_t(buffer_len()) * num_channels_;
+  buffer_ = (float *)MEM_mallocN_aligned(sizeof(float) * len, 16, "COM_MemoryBuffer");
+  threading::parallel_for(IndexRange(len), 64 * 1024, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      buffer_[i] = half_to_float(half_buffer_[i]);
+    }
+  });
 }
 
 void MemoryBuffer::copy_from(const MemoryBuffer *src, const rcti &area)
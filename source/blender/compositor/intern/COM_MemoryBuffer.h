@@ -86,6 +86,11 @@ class MemoryBuffer {
    */
   float *buffer_;
 
+  /**
+   * Buffer data in half float precision when stored compactly, null otherwise.
+   */
+  uint16_t *half_buffer_;
+
   /**
    * \brief the number of channels of a single value in the buffer.
    * For value buffers this is 1, vector 3 and color 4
@@ -371,6 +376,24 @@ class MemoryBuffer {
     return buffer_;
   }
 
+  /**
+   * Stores buffer data in half float precision and frees the float data, elements can't be
+   * accessed until it's restored with #restore_float_storage. Values are clamped to the half
+   * float range. Only for full size buffers owning their data.
+   */
+  void use_half_storage();
+
+  /**
+   * Restores float data of a buffer stored in half float precision. Half float data is kept, so
+   * float data can be freed again by calling #use_half_storage.
+   */
+  void restore_float_storage();
+
+  bool has_half_storage() const
+  {
+    return half_buffer_ != nullptr;
+  }
+
   /**
    * Converts a single elem buffer to a full size buffer (allocates memory for all
    * elements in resolution).
@@ -50,6 +50,8 @@ class MultiThreadedOperation : public NodeOperation {
   void update_memory_buffer(MemoryBuffer *output,
                             const rcti &area,
                             Span<MemoryBuffer *> inputs) override;
+
+  friend class FusedOperation;
 };
 
 }  // namespace blender::compositor
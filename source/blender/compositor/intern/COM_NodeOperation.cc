@@ -84,6 +84,39 @@ std::optional<NodeOperationHash> NodeOperation::generate_hash()
   return hash;
 }
 
+std::optional<size_t> NodeOperation::generate_result_hash()
+{
+  std::optional<NodeOperationHash> hash = generate_hash();
+  if (!hash) {
+    return std::nullopt;
+  }
+
+  size_t result_hash = get_default_hash_2(hash->type_hash_, hash->params_hash_);
+  combine_hashes(result_hash, hash_external_data());
+  for (NodeOperationInput &socket : inputs_) {
+    if (!socket.is_connected()) {
+      continue;
+    }
+
+    NodeOperation &input = socket.get_link()->get_operation();
+    if (input.get_flags().is_constant_operation) {
+      const float *elem = ((ConstantOperation *)&input)->get_constant_elem();
+      const int num_channels = COM_data_type_num_channels(socket.get_data_type());
+      for (const int i : IndexRange(num_channels)) {
+        combine_hashes(result_hash, get_default_hash(elem[i]));
+      }
+    }
+    else if (input.result_hash_) {
+      combine_hashes(result_hash, *input.result_hash_);
+    }
+    else {
+      return std::nullopt;
+    }
+  }
+
+  return result_hash;
+}
+
 NodeOperationOutput *NodeOperation::get_output_socket(uint index)
 {
   return &outputs_[index];
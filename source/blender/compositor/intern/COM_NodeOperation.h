@@ -239,6 +239,13 @@ struct NodeOperationFlags {
    */
   bool can_be_constant : 1;
 
+  /**
+   * Whether each output pixel only depends on the input pixels at the same coordinates, and the
+   * operation renders in a single pass without state shared between areas. Consecutive pixel
+   * operations may be fused by #FusedOperation to skip their intermediate buffers.
+   */
+  bool is_pixel_operation : 1;
+
   NodeOperationFlags()
   {
     complex = false;
@@ -257,6 +264,7 @@ struct NodeOperationFlags {
     is_fullframe_operation = false;
     is_constant_operation = false;
     can_be_constant = false;
+    is_pixel_operation = false;
   }
 };
 
@@ -335,6 +343,8 @@ class NodeOperation {
    */
   const bNodeTree *btree_;
 
+  std::optional<size_t> result_hash_;
+
  protected:
   /**
    * Compositor execution model.
@@ -392,6 +402,24 @@ class NodeOperation {
    */
   std::optional<NodeOperationHash> generate_hash();
 
+  /**
+   * Generate a hash that identifies the operation result across executions, to reuse results
+   * kept by #ResultCache. Combines the operation parameters and external data with the result
+   * hashes of its inputs, so these must have been generated first. Returns `std::nullopt` when
+   * `hash_output_params` is not implemented or an input has no result hash.
+   */
+  std::optional<size_t> generate_result_hash();
+
+  void set_result_hash(std::optional<size_t> result_hash)
+  {
+    result_hash_ = result_hash;
+  }
+
+  std::optional<size_t> get_result_hash() const
+  {
+    return result_hash_;
+  }
+
   unsigned int get_number_of_input_sockets() const
   {
     return inputs_.size();
@@ -663,6 +691,15 @@ class NodeOperation {
     is_hash_output_params_implemented_ = false;
   }
 
+  /**
+   * Overridden by operations reading external data that may change between executions without
+   * changing their parameters, like render passes. Returns a hash of that data.
+   */
+  virtual size_t hash_external_data()
+  {
+    return 0;
+  }
+
   static void combine_hashes(size_t &combined, size_t other)
   {
     combined = BLI_ghashutil_combine_hash(combined, other);
@@ -3,7 +3,9 @@
 
 #include <set>
 
+#include "BLI_map.hh"
 #include "BLI_multi_value_map.hh"
+#include "BLI_set.hh"
 
 #include "BKE_node_runtime.hh"
 
@@ -11,6 +13,7 @@
 #include "COM_Debug.h"
 
 #include "COM_ExecutionGroup.h"
+#include "COM_FusedOperation.h"
 #include "COM_PreviewOperation.h"
 #include "COM_ReadBufferOperation.h"
 #include "COM_SetColorOperation.h"
@@ -27,7 +30,11 @@ namespace blender::compositor {
 NodeOperationBuilder::NodeOperationBuilder(const CompositorContext *context,
                                            bNodeTree *b_nodetree,
                                            ExecutionSystem *system)
-    : context_(context), exec_system_(system), current_node_(nullptr), active_viewer_(nullptr)
+    : context_(context),
+      exec_system_(system),
+      next_operation_id_(0),
+      current_node_(nullptr),
+      active_viewer_(nullptr)
 {
   graph_.from_bNodeTree(*context, b_nodetree);
 }
@@ -94,6 +101,15 @@ void NodeOperationBuilder::convert_to_operations(ExecutionSystem *system)
   save_graphviz("compositor_prior_merging");
   merge_equal_operations();
 
+  if (context_->get_result_cache()) {
+    generate_result_hashes();
+  }
+
+  if (context_->get_execution_model() == eExecutionModel::FullFrame) {
+    save_graphviz("compositor_prior_fusion");
+    fuse_pixel_operations();
+  }
+
   if (context_->get_execution_model() == eExecutionModel::Tiled) {
     /* surround complex ops with read/write buffer */
     add_complex_operation_buffers();
@@ -119,7 +135,7 @@ void NodeOperationBuilder::convert_to_operations(ExecutionSystem *system)
 
 void NodeOperationBuilder::add_operation(NodeOperation *operation)
 {
-  operation->set_id(operations_.size());
+  operation->set_id(next_operation_id_++);
   operations_.append(operation);
   if (current_node_) {
     operation->set_name(current_node_->get_bnode()->name);
@@ -501,6 +517,102 @@ void NodeOperationBuilder::merge_equal_operations(NodeOperation *from, NodeOpera
   delete from;
 }
 
+static void generate_result_hash_recursive(NodeOperation *op, Set<NodeOperation *> &visited)
+{
+  if (!visited.add(op)) {
+    return;
+  }
+  for (int i = 0; i < op->get_number_of_input_sockets(); i++) {
+    generate_result_hash_recursive(op->get_input_operation(i), visited);
+  }
+  op->set_result_hash(op->generate_result_hash());
+}
+
+void NodeOperationBuilder::generate_result_hashes()
+{
+  Set<NodeOperation *> visited;
+  for (NodeOperation *op : operations_) {
+    generate_result_hash_recursive(op, visited);
+  }
+}
+
+static bool can_fuse_operations(NodeOperation *producer, NodeOperation *consumer)
+{
+  return producer->get_flags().is_pixel_operation && consumer->get_flags().is_pixel_operation &&
+         producer->get_number_of_output_sockets() == 1 &&
+         BLI_rcti_compare(&producer->get_canvas(), &consumer->get_canvas());
+}
+
+/** Add operations fused into given one in execution order, followed by the operation itself. */
+static void add_fused_operations_recursive(NodeOperation *op,
+                                           const Map<NodeOperation *, NodeOperation *> &fused_into,
+                                           Vector<NodeOperation *> &r_members)
+{
+  for (int i = 0; i < op->get_number_of_input_sockets(); i++) {
+    NodeOperation *input_op = op->get_input_operation(i);
+    if (fused_into.lookup_default(input_op, nullptr) == op) {
+      add_fused_operations_recursive(input_op, fused_into, r_members);
+    }
+  }
+  r_members.append(op);
+}
+
+void NodeOperationBuilder::fuse_pixel_operations()
+{
+  Map<NodeOperation *, int> num_readers;
+  for (const Link &link : links_) {
+    num_readers.lookup_or_add(&link.from()->get_operation(), 0)++;
+  }
+
+  /* An operation is fused into its reader when it's the only one. Otherwise its result is needed
+   * in a buffer anyway. */
+  Map<NodeOperation *, NodeOperation *> fused_into;
+  for (const Link &link : links_) {
+    NodeOperation *from = &link.from()->get_operation();
+    NodeOperation *to = &link.to()->get_operation();
+    if (num_readers.lookup(from) == 1 && can_fuse_operations(from, to)) {
+      fused_into.add_new(from, to);
+    }
+  }
+
+  /* Operations that are not fused into another one write the result of their group. */
+  Set<NodeOperation *> fused_readers;
+  for (NodeOperation *op : fused_into.values()) {
+    fused_readers.add(op);
+  }
+  Vector<NodeOperation *> group_outputs;
+  for (NodeOperation *op : operations_) {
+    if (fused_readers.contains(op) && !fused_into.contains(op)) {
+      group_outputs.append(op);
+    }
+  }
+
+  for (NodeOperation *group_output : group_outputs) {
+    Vector<NodeOperation *> members;
+    add_fused_operations_recursive(group_output, fused_into, members);
+    FusedOperation *fused_op = new FusedOperation(members);
+
+    /* Links to member inputs are kept in their sockets only, members are not in the graph. */
+    const Set<NodeOperation *> members_set(members);
+    links_.remove_if(
+        [&](const Link &link) { return members_set.contains(&link.to()->get_operation()); });
+    for (Link &link : links_) {
+      if (&link.from()->get_operation() == group_output) {
+        link.to()->set_link(fused_op->get_output_socket());
+        link = Link(fused_op->get_output_socket(), link.to());
+      }
+    }
+    for (NodeOperation *member : members) {
+      operations_.remove_first_occurrence_and_reorder(member);
+    }
+
+    add_operation(fused_op);
+    for (int i = 0; i < fused_op->get_number_of_input_sockets(); i++) {
+      add_link(fused_op->get_fused_input_link(i), fused_op->get_input_socket(i));
+    }
+  }
+}
+
 Vector<NodeOperationInput *> NodeOperationBuilder::cache_output_links(
     NodeOperationOutput *output) const
 {
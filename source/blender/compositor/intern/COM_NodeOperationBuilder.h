@@ -55,6 +55,8 @@ class NodeOperationBuilder {
   ExecutionSystem *exec_system_;
 
   Vector<NodeOperation *> operations_;
+  /** Identifier of the next added operation, identifiers of removed operations aren't reused. */
+  int next_operation_id_;
   Vector<Link> links_;
   Vector<ExecutionGroup *> groups_;
 
@@ -151,12 +153,23 @@ class NodeOperationBuilder {
   void group_operations();
   ExecutionGroup *make_group(NodeOperation *op);
 
+  /**
+   * Replace groups of linked pixel operations of the same canvas by a #FusedOperation, so that
+   * their intermediate results are not rendered into full size buffers.
+   */
+  void fuse_pixel_operations();
+
  private:
   PreviewOperation *make_preview_operation() const;
   void unlink_inputs_and_relink_outputs(NodeOperation *unlinked_op, NodeOperation *linked_op);
   /** Merge operations with same type, inputs and parameters that produce the same result. */
   void merge_equal_operations();
   void merge_equal_operations(NodeOperation *from, NodeOperation *into);
+  /**
+   * Generate the hashes identifying operation results across executions, to reuse results kept
+   * in the result cache.
+   */
+  void generate_result_hashes();
   void save_graphviz(StringRefNull name = "");
 #ifdef WITH_CXX_GUARDEDALLOC
   MEM_CXX_CLASS_ALLOC_FUNCS("COM:NodeCompilerImpl")
@@ -0,0 +1,83 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later
+ * Copyright 2023 Blender Foundation. */
+
+#include "COM_ResultCache.h"
+#include "COM_MemoryBuffer.h"
+
+namespace blender::compositor {
+
+static size_t get_buffer_size(MemoryBuffer &buffer)
+{
+  const size_t num_elems = size_t(buffer.get_width()) * buffer.get_height() *
+                           buffer.get_num_channels();
+  size_t size = 0;
+  if (buffer.get_buffer() != nullptr) {
+    size += num_elems * sizeof(float);
+  }
+  if (buffer.has_half_storage()) {
+    size += num_elems * sizeof(uint16_t);
+  }
+  return size;
+}
+
+ResultCache::ResultCache() : max_size_(0), size_(0), use_count_(0)
+{
+}
+
+ResultCache::~ResultCache() = default;
+
+void ResultCache::set_max_size(const size_t max_size)
+{
+  max_size_ = max_size;
+  free_results(max_size_);
+}
+
+std::unique_ptr<MemoryBuffer> ResultCache::take(const size_t result_hash)
+{
+  std::optional<Result> result = results_.pop_try(result_hash);
+  if (!result) {
+    return nullptr;
+  }
+  size_ -= result->size;
+  return std::move(result->buffer);
+}
+
+void ResultCache::add(const size_t result_hash, std::unique_ptr<MemoryBuffer> buffer)
+{
+  BLI_assert(buffer && !buffer->is_a_single_elem());
+  /* Free a previous result of same hash. */
+  take(result_hash);
+
+  const size_t buffer_size = get_buffer_size(*buffer);
+  if (buffer_size > max_size_) {
+    return;
+  }
+  free_results(max_size_ - buffer_size);
+
+  use_count_++;
+  results_.add_new(result_hash, {std::move(buffer), buffer_size, use_count_});
+  size_ += buffer_size;
+}
+
+void ResultCache::clear()
+{
+  results_.clear();
+  size_ = 0;
+}
+
+void ResultCache::free_results(const size_t max_size)
+{
+  while (size_ > max_size) {
+    size_t least_used_hash = 0;
+    uint64_t least_use = UINT64_MAX;
+    for (auto item : results_.items()) {
+      if (item.value.last_use < least_use) {
+        least_used_hash = item.key;
+        least_use = item.value.last_use;
+      }
+    }
+    take(least_used_hash);
+  }
+}
+
+}  // namespace blender::compositor
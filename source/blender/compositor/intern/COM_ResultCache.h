@@ -0,0 +1,87 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later
+ * Copyright 2023 Blender Foundation. */
+
+#pragma once
+
+#include <memory>
+
+#include "BLI_map.hh"
+
+#ifdef WITH_CXX_GUARDEDALLOC
+#  include "MEM_guardedalloc.h"
+#endif
+
+namespace blender::compositor {
+
+class MemoryBuffer;
+
+/**
+ * Keeps operation results between compositor executions, identified by the operation result
+ * hash (see #NodeOperation::generate_result_hash). Results of operations whose parameters and
+ * inputs didn't change are reused instead of rendered again. When exceeding the memory budget,
+ * least recently used results are freed.
+ */
+class ResultCache {
+ private:
+  struct Result {
+    std::unique_ptr<MemoryBuffer> buffer;
+    size_t size;
+    /** Value of #use_count_ when the result was last added, to free least recently used ones. */
+    uint64_t last_use;
+  };
+
+  Map<size_t, Result> results_;
+
+  /** Memory budget in bytes. */
+  size_t max_size_;
+
+  /** Sum of the sizes of all results. */
+  size_t size_;
+
+  uint64_t use_count_;
+
+ public:
+  ResultCache();
+  ~ResultCache();
+
+  /**
+   * Sets the memory budget in bytes, freeing results exceeding it.
+   */
+  void set_max_size(size_t max_size);
+
+  /**
+   * Removes the result of given hash from the cache and returns it, null if not found. Result
+   * should be given back with #add once it's not needed anymore, to keep it for next executions.
+   */
+  std::unique_ptr<MemoryBuffer> take(size_t result_hash);
+
+  /**
+   * Adds a result, freeing least recently used ones if exceeding the memory budget. Results
+   * larger than the budget are freed.
+   */
+  void add(size_t result_hash, std::unique_ptr<MemoryBuffer> buffer);
+
+  bool contains(size_t result_hash) const
+  {
+    return results_.contains(result_hash);
+  }
+
+  /**
+   * Sum of the sizes of all results in bytes.
+   */
+  size_t get_size() const
+  {
+    return size_;
+  }
+
+  void clear();
+
+ private:
+  void free_results(size_t max_size);
+
+#ifdef WITH_CXX_GUARDEDALLOC
+  MEM_CXX_CLASS_ALLOC_FUNCS("COM:ResultCache")
+#endif
+};
+
+}  // namespace blender::compositor
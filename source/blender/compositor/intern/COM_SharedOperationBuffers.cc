@@ -2,15 +2,38 @@
  * Copyright 2021 Blender Foundation. */
 
 #include "COM_SharedOperationBuffers.h"
+#include "COM_MemoryBuffer.h"
 #include "COM_NodeOperation.h"
+#include "COM_ResultCache.h"
 
 namespace blender::compositor {
 
 SharedOperationBuffers::BufferData::BufferData()
-    : buffer(nullptr), registered_reads(0), received_reads(0), is_rendered(false)
+    : buffer(nullptr),
+      registered_reads(0),
+      received_reads(0),
+      is_rendered(false),
+      is_cached_result(false)
 {
 }
 
+bool SharedOperationBuffers::is_whole_canvas_rendered(NodeOperation *op)
+{
+  BufferData &buf_data = get_buffer_data(op);
+  if (buf_data.buffer == nullptr || buf_data.buffer->is_a_single_elem()) {
+    return false;
+  }
+  if (buf_data.is_cached_result) {
+    return true;
+  }
+  for (const rcti &area : buf_data.render_areas) {
+    if (BLI_rcti_inside_rcti(&area, &op->get_canvas())) {
+      return true;
+    }
+  }
+  return false;
+}
+
 SharedOperationBuffers::BufferData &SharedOperationBuffers::get_buffer_data(NodeOperation *op)
 {
   return buffers_.lookup_or_add_cb(op, []() { return BufferData(); });
@@ -71,12 +94,33 @@ void SharedOperationBuffers::set_rendered_buffer(NodeOperation *op,
   BLI_assert(buf_data.buffer == nullptr);
   buf_data.buffer = std::move(buffer);
   buf_data.is_rendered = true;
+
+  MemoryBuffer *buf = buf_data.buffer.get();
+  if (use_half_storage_ && buf && buf_data.registered_reads > 0 && !buf->is_a_single_elem() &&
+      buf->get_num_channels() == COM_DATA_TYPE_COLOR_CHANNELS) {
+    buf->use_half_storage();
+  }
+}
+
+void SharedOperationBuffers::set_cached_buffer(NodeOperation *op,
+                                               std::unique_ptr<MemoryBuffer> buffer)
+{
+  BufferData &buf_data = get_buffer_data(op);
+  BLI_assert(!buf_data.is_rendered);
+  buf_data.buffer = std::move(buffer);
+  buf_data.is_rendered = true;
+  buf_data.is_cached_result = true;
 }
 
 MemoryBuffer *SharedOperationBuffers::get_rendered_buffer(NodeOperation *op)
 {
   BLI_assert(is_operation_rendered(op));
-  return get_buffer_data(op).buffer.get();
+  MemoryBuffer *buf = get_buffer_data(op).buffer.get();
+  if (buf && buf->has_half_storage()) {
+    /* Float data is freed again once the reading operation has finished. */
+    buf->restore_float_storage();
+  }
+  return buf;
 }
 
 void SharedOperationBuffers::read_finished(NodeOperation *read_op)
@@ -86,8 +130,14 @@ void SharedOperationBuffers::read_finished(NodeOperation *read_op)
   BLI_assert(buf_data.received_reads > 0 && buf_data.received_reads <= buf_data.registered_reads);
   if (buf_data.received_reads == buf_data.registered_reads) {
     /* Dispose buffer. */
+    if (result_cache_ && read_op->get_result_hash() && is_whole_canvas_rendered(read_op)) {
+      result_cache_->add(*read_op->get_result_hash(), std::move(buf_data.buffer));
+    }
     buf_data.buffer = nullptr;
   }
+  else if (buf_data.buffer && buf_data.buffer->has_half_storage()) {
+    buf_data.buffer->use_half_storage();
+  }
 }
 
 }  // namespace blender::compositor
@@ -16,6 +16,7 @@ namespace blender::compositor {
 
 class MemoryBuffer;
 class NodeOperation;
+class ResultCache;
 
 /**
  * Stores and shares operations rendered buffers including render data. Buffers are
@@ -31,10 +32,40 @@ class SharedOperationBuffers {
     int registered_reads;
     int received_reads;
     bool is_rendered;
+    /** Whether the buffer was taken from the result cache, containing the whole canvas. */
+    bool is_cached_result;
   } BufferData;
   blender::Map<NodeOperation *, BufferData> buffers_;
 
+  /**
+   * Whether color buffers waiting for reads are stored in half float precision.
+   */
+  bool use_half_storage_ = false;
+
+  /**
+   * Cache where disposed buffers of operations with a result hash are kept, null when disabled.
+   */
+  ResultCache *result_cache_ = nullptr;
+
  public:
+  /**
+   * Store color buffers in half float precision while no operation is reading them. Reduces
+   * memory of buffers kept for several operations at the cost of precision and conversions.
+   */
+  void set_use_half_storage(bool use_half_storage)
+  {
+    use_half_storage_ = use_half_storage;
+  }
+
+  /**
+   * Keep buffers of operations with a result hash in given cache once disposed, when their whole
+   * canvas was rendered.
+   */
+  void set_result_cache(ResultCache *result_cache)
+  {
+    result_cache_ = result_cache;
+  }
+
   /**
    * Whether given operation area to render is already registered.
    */
@@ -66,6 +97,10 @@ class SharedOperationBuffers {
    * Stores given operation rendered buffer.
    */
   void set_rendered_buffer(NodeOperation *op, std::unique_ptr<MemoryBuffer> buffer);
+  /**
+   * Stores given operation buffer taken from the result cache, so that it's not rendered.
+   */
+  void set_cached_buffer(NodeOperation *op, std::unique_ptr<MemoryBuffer> buffer);
   /**
    * Get given operation rendered buffer.
    */
@@ -79,6 +114,7 @@ class SharedOperationBuffers {
 
  private:
   BufferData &get_buffer_data(NodeOperation *op);
+  bool is_whole_canvas_rendered(NodeOperation *op);
 
 #ifdef WITH_CXX_GUARDEDALLOC
   MEM_CXX_CLASS_ALLOC_FUNCS("COM:SharedOperationBuffers")
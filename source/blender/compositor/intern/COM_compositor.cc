@@ -10,12 +10,15 @@
 #include "BKE_scene.h"
 
 #include "COM_ExecutionSystem.h"
+#include "COM_ResultCache.h"
 #include "COM_WorkScheduler.h"
 #include "COM_compositor.h"
 
 static struct {
   bool is_initialized = false;
   ThreadMutex mutex;
+  /* Results kept between executions. */
+  blender::compositor::ResultCache *result_cache = nullptr;
 } g_compositor;
 
 /* Make sure node tree has previews.
@@ -89,8 +92,11 @@ void COM_execute(RenderData *render_data,
     }
   }
 
+  if (g_compositor.result_cache == nullptr) {
+    g_compositor.result_cache = new blender::compositor::ResultCache();
+  }
   blender::compositor::ExecutionSystem system(
-      render_data, scene, node_tree, rendering, false, view_name);
+      render_data, scene, node_tree, rendering, false, view_name, g_compositor.result_cache);
   system.execute();
 
   BLI_mutex_unlock(&g_compositor.mutex);
@@ -101,8 +107,21 @@ void COM_deinitialize()
   if (g_compositor.is_initialized) {
     BLI_mutex_lock(&g_compositor.mutex);
     blender::compositor::WorkScheduler::deinitialize();
+    delete g_compositor.result_cache;
+    g_compositor.result_cache = nullptr;
     g_compositor.is_initialized = false;
     BLI_mutex_unlock(&g_compositor.mutex);
     BLI_mutex_end(&g_compositor.mutex);
   }
 }
+
+void COM_clear_caches()
+{
+  if (g_compositor.is_initialized) {
+    BLI_mutex_lock(&g_compositor.mutex);
+    if (g_compositor.result_cache) {
+      g_compositor.result_cache->clear();
+    }
+    BLI_mutex_unlock(&g_compositor.mutex);
+  }
+}
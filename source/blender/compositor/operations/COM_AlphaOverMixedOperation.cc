@@ -11,6 +11,12 @@ AlphaOverMixedOperation::AlphaOverMixedOperation()
   flags_.can_be_constant = true;
 }
 
+void AlphaOverMixedOperation::hash_output_params()
+{
+  MixBaseOperation::hash_output_params();
+  hash_param(x_);
+}
+
 void AlphaOverMixedOperation::execute_pixel_sampled(float output[4],
                                                     float x,
                                                     float y,
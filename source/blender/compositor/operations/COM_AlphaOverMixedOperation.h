@@ -32,6 +32,9 @@ class AlphaOverMixedOperation : public MixBaseOperation {
   }
 
   void update_memory_buffer_row(PixelCursor &p) override;
+
+ protected:
+  void hash_output_params() override;
 };
 
 }  // namespace blender::compositor
@@ -3,6 +3,7 @@
 
 #include "COM_BokehBlurOperation.h"
 #include "COM_ConstantOperation.h"
+#include "COM_FFTConvolution.h"
 
 #include "COM_OpenCLDevice.h"
 
@@ -31,6 +32,7 @@ BokehBlurOperation::BokehBlurOperation()
   input_bounding_box_reader_ = nullptr;
 
   extend_bounds_ = false;
+  convolved_image_ = nullptr;
 }
 
 void BokehBlurOperation::init_data()
@@ -306,6 +308,38 @@ void BokehBlurOperation::get_area_of_interest(const int input_idx,
   }
 }
 
+void BokehBlurOperation::update_memory_buffer_started(MemoryBuffer * /*output*/,
+                                                      const rcti &area,
+                                                      Span<MemoryBuffer *> inputs)
+{
+  const float max_dim = MAX2(this->get_width(), this->get_height());
+  const int pixel_size = size_ * max_dim / 100.0f;
+  if (pixel_size < FFT_CONVOLUTION_MIN_RADIUS) {
+    return;
+  }
+
+  /* Sampled bokeh for each offset of the pixels in range, flipped for the convolution. The
+   * direct convolution always samples at full quality in this case. */
+  const float m = bokehDimension_ / pixel_size;
+  const int kernel_size = 2 * pixel_size;
+  const int kernel_center = pixel_size - 1;
+  rcti kernel_rect;
+  BLI_rcti_init(&kernel_rect, 0, kernel_size, 0, kernel_size);
+  MemoryBuffer kernel(DataType::Color, kernel_rect);
+  const MemoryBuffer *bokeh_input = inputs[BOKEH_INPUT_INDEX];
+  for (int y = 0; y < kernel_size; y++) {
+    const float v = bokeh_mid_y_ - (kernel_center - y) * m;
+    for (int x = 0; x < kernel_size; x++) {
+      const float u = bokeh_mid_x_ - (kernel_center - x) * m;
+      bokeh_input->read_elem_checked(u, v, kernel.get_elem(x, y));
+    }
+  }
+
+  convolved_image_ = new MemoryBuffer(DataType::Color, area);
+  convolve_fft_normalized(
+      *inputs[IMAGE_INPUT_INDEX], kernel, kernel_center, kernel_center, *convolved_image_);
+}
+
 void BokehBlurOperation::update_memory_buffer_partial(MemoryBuffer *output,
                                                       const rcti &area,
                                                       Span<MemoryBuffer *> inputs)
@@ -328,6 +362,11 @@ void BokehBlurOperation::update_memory_buffer_partial(MemoryBuffer *output,
       continue;
     }
 
+    if (convolved_image_) {
+      convolved_image_->read_elem(x, y, it.out);
+      continue;
+    }
+
     float color_accum[4] = {0};
     float multiplier_accum[4] = {0};
     if (pixel_size < 2) {
@@ -363,4 +402,12 @@ void BokehBlurOperation::update_memory_buffer_partial(MemoryBuffer *output,
   }
 }
 
+void BokehBlurOperation::update_memory_buffer_finished(MemoryBuffer * /*output*/,
+                                                       const rcti & /*area*/,
+                                                       Span<MemoryBuffer *> /*inputs*/)
+{
+  delete convolved_image_;
+  convolved_image_ = nullptr;
+}
+
 }  // namespace blender::compositor
@@ -22,6 +22,12 @@ class BokehBlurOperation : public MultiThreadedOperation, public QualityStepHelp
   float bokehDimension_;
   bool extend_bounds_;
 
+  /**
+   * Image convolved with the bokeh in the frequency domain for large sizes, null when convolving
+   * directly.
+   */
+  MemoryBuffer *convolved_image_;
+
  public:
   BokehBlurOperation();
 
@@ -68,9 +74,15 @@ class BokehBlurOperation : public MultiThreadedOperation, public QualityStepHelp
   void determine_canvas(const rcti &preferred_area, rcti &r_area) override;
 
   void get_area_of_interest(int input_idx, const rcti &output_area, rcti &r_input_area) override;
+  void update_memory_buffer_started(MemoryBuffer *output,
+                                    const rcti &area,
+                                    Span<MemoryBuffer *> inputs) override;
   void update_memory_buffer_partial(MemoryBuffer *output,
                                     const rcti &area,
                                     Span<MemoryBuffer *> inputs) override;
+  void update_memory_buffer_finished(MemoryBuffer *output,
+                                     const rcti &area,
+                                     Span<MemoryBuffer *> inputs) override;
 };
 
 }  // namespace blender::compositor
@@ -94,6 +94,12 @@ void BokehImageOperation::execute_pixel_sampled(float output[4],
   output[3] = (inside_bokeh_max + inside_bokeh_med + inside_bokeh_min) / 3.0f;
 }
 
+void BokehImageOperation::hash_output_params()
+{
+  hash_params(data_->flaps, data_->angle, data_->rounding);
+  hash_params(data_->catadioptric, data_->lensshift);
+}
+
 void BokehImageOperation::update_memory_buffer_partial(MemoryBuffer *output,
                                                        const rcti &area,
                                                        Span<MemoryBuffer *> /*inputs*/)
@@ -14,6 +14,7 @@ ChangeHSVOperation::ChangeHSVOperation()
   this->add_output_socket(DataType::Color);
   input_operation_ = nullptr;
   flags_.can_be_constant = true;
+  flags_.is_pixel_operation = true;
 }
 
 void ChangeHSVOperation::init_execution()
@@ -13,6 +13,7 @@ ConvertBaseOperation::ConvertBaseOperation()
 {
   input_operation_ = nullptr;
   flags_.can_be_constant = true;
+  flags_.is_pixel_operation = true;
 }
 
 void ConvertBaseOperation::init_execution()
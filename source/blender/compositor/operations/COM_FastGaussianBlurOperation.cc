@@ -3,6 +3,8 @@
 
 #include <climits>
 
+#include "BLI_array.hh"
+
 #include "COM_FastGaussianBlurOperation.h"
 
 namespace blender::compositor {
@@ -75,25 +77,18 @@ void *FastGaussianBlurOperation::initialize_tile_data(rcti *rect)
     MemoryBuffer *copy = new MemoryBuffer(*new_buf);
     update_size();
 
-    int c;
     sx_ = data_.sizex * size_ / 2.0f;
     sy_ = data_.sizey * size_ / 2.0f;
 
     if ((sx_ == sy_) && (sx_ > 0.0f)) {
-      for (c = 0; c < COM_DATA_TYPE_COLOR_CHANNELS; c++) {
-        IIR_gauss(copy, sx_, c, 3);
-      }
+      IIR_gauss(copy, sx_, 3);
     }
     else {
       if (sx_ > 0.0f) {
-        for (c = 0; c < COM_DATA_TYPE_COLOR_CHANNELS; c++) {
-          IIR_gauss(copy, sx_, c, 1);
-        }
+        IIR_gauss(copy, sx_, 1);
       }
       if (sy_ > 0.0f) {
-        for (c = 0; c < COM_DATA_TYPE_COLOR_CHANNELS; c++) {
-          IIR_gauss(copy, sy_, c, 2);
-        }
+        IIR_gauss(copy, sy_, 2);
       }
     }
     iirgaus_ = copy;
@@ -102,37 +97,45 @@ void *FastGaussianBlurOperation::initialize_tile_data(rcti *rect)
   return iirgaus_;
 }
 
-void FastGaussianBlurOperation::IIR_gauss(MemoryBuffer *src, float sigma, uint chan, uint xy)
+/* Young/Van Vliet recursive filter coefficients and Triggs/Sdika border corrections. */
+struct IIRGaussCoefficients {
+  double cf[4];
+  double tsM[9];
+};
+
+/**
+ * Computes the filter coefficients for given sigma and removes from \a xy the directions that
+ * can't be blurred. Returns false when there is nothing to blur.
+ */
+static bool IIR_gauss_init(const MemoryBuffer *src,
+                           const float sigma,
+                           uint &xy,
+                           IIRGaussCoefficients &r_coefs)
 {
   BLI_assert(!src->is_a_single_elem());
-  double q, q2, sc, cf[4], tsM[9], tsu[3], tsv[3];
-  double *X, *Y, *W;
-  const uint src_width = src->get_width();
-  const uint src_height = src->get_height();
-  uint x, y, src_dim_max;
-  uint i;
-  float *buffer = src->get_buffer();
-  const uint8_t num_channels = src->get_num_channels();
+  double q, q2, sc;
+  double *cf = r_coefs.cf;
+  double *tsM = r_coefs.tsM;
 
   /* <0.5 not valid, though can have a possibly useful sort of sharpening effect. */
   if (sigma < 0.5f) {
-    return;
+    return false;
   }
 
   if ((xy < 1) || (xy > 3)) {
     xy = 3;
   }
 
-  /* XXX The YVV macro defined below explicitly expects sources of at least 3x3 pixels,
+  /* XXX #IIR_gauss_line explicitly expects sources of at least 3x3 pixels,
    *     so just skipping blur along faulty direction if src's def is below that limit! */
-  if (src_width < 3) {
+  if (src->get_width() < 3) {
     xy &= ~1;
   }
-  if (src_height < 3) {
+  if (src->get_height() < 3) {
     xy &= ~2;
   }
   if (xy < 1) {
-    return;
+    return false;
   }
 
   /* See "Recursive Gabor Filtering" by Young/VanVliet
@@ -173,76 +176,168 @@ void FastGaussianBlurOperation::IIR_gauss(MemoryBuffer *src, float sigma, uint c
   tsM[7] = sc * (cf[1] * cf[2] + cf[3] * cf[2] * cf[2] - cf[1] * cf[3] * cf[3] -
                  cf[3] * cf[3] * cf[3] - cf[3] * cf[2] + cf[3]);
   tsM[8] = sc * (cf[3] * (cf[1] + cf[3] * cf[2]));
+  return true;
+}
 
-#define YVV(L) \
-  { \
-    W[0] = cf[0] * X[0] + cf[1] * X[0] + cf[2] * X[0] + cf[3] * X[0]; \
-    W[1] = cf[0] * X[1] + cf[1] * W[0] + cf[2] * X[0] + cf[3] * X[0]; \
-    W[2] = cf[0] * X[2] + cf[1] * W[1] + cf[2] * W[0] + cf[3] * X[0]; \
-    for (i = 3; i < L; i++) { \
-      W[i] = cf[0] * X[i] + cf[1] * W[i - 1] + cf[2] * W[i - 2] + cf[3] * W[i - 3]; \
-    } \
-    tsu[0] = W[L - 1] - X[L - 1]; \
-    tsu[1] = W[L - 2] - X[L - 1]; \
-    tsu[2] = W[L - 3] - X[L - 1]; \
-    tsv[0] = tsM[0] * tsu[0] + tsM[1] * tsu[1] + tsM[2] * tsu[2] + X[L - 1]; \
-    tsv[1] = tsM[3] * tsu[0] + tsM[4] * tsu[1] + tsM[5] * tsu[2] + X[L - 1]; \
-    tsv[2] = tsM[6] * tsu[0] + tsM[7] * tsu[1] + tsM[8] * tsu[2] + X[L - 1]; \
-    Y[L - 1] = cf[0] * W[L - 1] + cf[1] * tsv[0] + cf[2] * tsv[1] + cf[3] * tsv[2]; \
-    Y[L - 2] = cf[0] * W[L - 2] + cf[1] * Y[L - 1] + cf[2] * tsv[0] + cf[3] * tsv[1]; \
-    Y[L - 3] = cf[0] * W[L - 3] + cf[1] * Y[L - 2] + cf[2] * Y[L - 1] + cf[3] * tsv[0]; \
-    /* `i != UINT_MAX` is really `i >= 0`, but necessary for `uint` wrapping. */ \
-    for (i = L - 4; i != UINT_MAX; i--) { \
-      Y[i] = cf[0] * W[i] + cf[1] * Y[i + 1] + cf[2] * Y[i + 2] + cf[3] * Y[i + 3]; \
-    } \
-  } \
-  (void)0
+/**
+ * Filters a line of \a L elements from \a X into \a Y, forward then backward. \a T is either a
+ * single channel or all channels of a pixel.
+ */
+template<typename T>
+static void IIR_gauss_line(const IIRGaussCoefficients &coefs, const T *X, T *W, T *Y, const uint L)
+{
+  const double *cf = coefs.cf;
+  const double *tsM = coefs.tsM;
+  T tsu[3], tsv[3];
+  uint i;
+
+  W[0] = cf[0] * X[0] + cf[1] * X[0] + cf[2] * X[0] + cf[3] * X[0];
+  W[1] = cf[0] * X[1] + cf[1] * W[0] + cf[2] * X[0] + cf[3] * X[0];
+  W[2] = cf[0] * X[2] + cf[1] * W[1] + cf[2] * W[0] + cf[3] * X[0];
+  for (i = 3; i < L; i++) {
+    W[i] = cf[0] * X[i] + cf[1] * W[i - 1] + cf[2] * W[i - 2] + cf[3] * W[i - 3];
+  }
+  tsu[0] = W[L - 1] - X[L - 1];
+  tsu[1] = W[L - 2] - X[L - 1];
+  tsu[2] = W[L - 3] - X[L - 1];
+  tsv[0] = tsM[0] * tsu[0] + tsM[1] * tsu[1] + tsM[2] * tsu[2] + X[L - 1];
+  tsv[1] = tsM[3] * tsu[0] + tsM[4] * tsu[1] + tsM[5] * tsu[2] + X[L - 1];
+  tsv[2] = tsM[6] * tsu[0] + tsM[7] * tsu[1] + tsM[8] * tsu[2] + X[L - 1];
+  Y[L - 1] = cf[0] * W[L - 1] + cf[1] * tsv[0] + cf[2] * tsv[1] + cf[3] * tsv[2];
+  Y[L - 2] = cf[0] * W[L - 2] + cf[1] * Y[L - 1] + cf[2] * tsv[0] + cf[3] * tsv[1];
+  Y[L - 3] = cf[0] * W[L - 3] + cf[1] * Y[L - 2] + cf[2] * Y[L - 1] + cf[3] * tsv[0];
+  /* `i != UINT_MAX` is really `i >= 0`, but necessary for `uint` wrapping. */
+  for (i = L - 4; i != UINT_MAX; i--) {
+    Y[i] = cf[0] * W[i] + cf[1] * Y[i + 1] + cf[2] * Y[i + 2] + cf[3] * Y[i + 3];
+  }
+}
+
+/**
+ * Filters all lines of \a src in the directions of \a xy. \a accessor reads the filtered
+ * elements of a pixel into an \a Accessor::value_type and writes them back.
+ */
+template<typename Accessor>
+static void IIR_gauss_lines(MemoryBuffer *src,
+                            const IIRGaussCoefficients &coefs,
+                            const uint xy,
+                            const Accessor &accessor)
+{
+  using T = typename Accessor::value_type;
+  const uint src_width = src->get_width();
+  const uint src_height = src->get_height();
+  float *buffer = src->get_buffer();
+  const int elem_stride = src->elem_stride;
+  const int row_stride = src->row_stride;
 
   /* Intermediate buffers. */
-  src_dim_max = MAX2(src_width, src_height);
-  X = (double *)MEM_callocN(src_dim_max * sizeof(double), "IIR_gauss X buf");
-  Y = (double *)MEM_callocN(src_dim_max * sizeof(double), "IIR_gauss Y buf");
-  W = (double *)MEM_callocN(src_dim_max * sizeof(double), "IIR_gauss W buf");
+  const uint src_dim_max = MAX2(src_width, src_height);
+  Array<T> X(src_dim_max);
+  Array<T> Y(src_dim_max);
+  Array<T> W(src_dim_max);
   if (xy & 1) { /* H. */
-    int offset;
-    for (y = 0; y < src_height; y++) {
-      const int yx = y * src_width;
-      offset = yx * num_channels + chan;
-      for (x = 0; x < src_width; x++) {
-        X[x] = buffer[offset];
-        offset += num_channels;
+    for (uint y = 0; y < src_height; y++) {
+      float *row = buffer + intptr_t(y) * row_stride;
+      for (uint x = 0; x < src_width; x++) {
+        X[x] = accessor.load(row + intptr_t(x) * elem_stride);
       }
-      YVV(src_width);
-      offset = yx * num_channels + chan;
-      for (x = 0; x < src_width; x++) {
-        buffer[offset] = Y[x];
-        offset += num_channels;
+      IIR_gauss_line(coefs, X.data(), W.data(), Y.data(), src_width);
+      for (uint x = 0; x < src_width; x++) {
+        accessor.store(row + intptr_t(x) * elem_stride, Y[x]);
       }
     }
   }
   if (xy & 2) { /* V. */
-    int offset;
-    const int add = src_width * num_channels;
-
-    for (x = 0; x < src_width; x++) {
-      offset = x * num_channels + chan;
-      for (y = 0; y < src_height; y++) {
-        X[y] = buffer[offset];
-        offset += add;
+    for (uint x = 0; x < src_width; x++) {
+      float *column = buffer + intptr_t(x) * elem_stride;
+      for (uint y = 0; y < src_height; y++) {
+        X[y] = accessor.load(column + intptr_t(y) * row_stride);
       }
-      YVV(src_height);
-      offset = x * num_channels + chan;
-      for (y = 0; y < src_height; y++) {
-        buffer[offset] = Y[y];
-        offset += add;
+      IIR_gauss_line(coefs, X.data(), W.data(), Y.data(), src_height);
+      for (uint y = 0; y < src_height; y++) {
+        accessor.store(column + intptr_t(y) * row_stride, Y[y]);
       }
     }
   }
+}
+
+/* Filters a single channel of the pixels. */
+struct IIRGaussChannelAccessor {
+  using value_type = double;
+  uint chan;
+
+  double load(const float *elem) const
+  {
+    return elem[chan];
+  }
+
+  void store(float *elem, const double value) const
+  {
+    elem[chan] = value;
+  }
+};
+
+#ifdef BLI_HAVE_SSE2
+/* All channels of a color pixel in double precision, filtered at once. */
+struct IIRGaussColor {
+  __m128d rg;
+  __m128d ba;
+
+  friend IIRGaussColor operator+(const IIRGaussColor &a, const IIRGaussColor &b)
+  {
+    return {_mm_add_pd(a.rg, b.rg), _mm_add_pd(a.ba, b.ba)};
+  }
+
+  friend IIRGaussColor operator-(const IIRGaussColor &a, const IIRGaussColor &b)
+  {
+    return {_mm_sub_pd(a.rg, b.rg), _mm_sub_pd(a.ba, b.ba)};
+  }
+
+  friend IIRGaussColor operator*(const double a, const IIRGaussColor &b)
+  {
+    const __m128d factor = _mm_set1_pd(a);
+    return {_mm_mul_pd(factor, b.rg), _mm_mul_pd(factor, b.ba)};
+  }
+};
+
+/* Filters all channels of color pixels. */
+struct IIRGaussColorAccessor {
+  using value_type = IIRGaussColor;
+
+  IIRGaussColor load(const float *elem) const
+  {
+    const __m128 color = _mm_loadu_ps(elem);
+    return {_mm_cvtps_pd(color), _mm_cvtps_pd(_mm_movehl_ps(color, color))};
+  }
+
+  void store(float *elem, const IIRGaussColor &value) const
+  {
+    _mm_storeu_ps(elem, _mm_movelh_ps(_mm_cvtpd_ps(value.rg), _mm_cvtpd_ps(value.ba)));
+  }
+};
+#endif
 
-  MEM_freeN(X);
-  MEM_freeN(W);
-  MEM_freeN(Y);
-#undef YVV
+void FastGaussianBlurOperation::IIR_gauss(MemoryBuffer *src, float sigma, uint chan, uint xy)
+{
+  IIRGaussCoefficients coefs;
+  if (IIR_gauss_init(src, sigma, xy, coefs)) {
+    IIR_gauss_lines(src, coefs, xy, IIRGaussChannelAccessor{chan});
+  }
+}
+
+void FastGaussianBlurOperation::IIR_gauss(MemoryBuffer *src, float sigma, uint xy)
+{
+#ifdef BLI_HAVE_SSE2
+  if (src->get_num_channels() == COM_DATA_TYPE_COLOR_CHANNELS) {
+    IIRGaussCoefficients coefs;
+    if (IIR_gauss_init(src, sigma, xy, coefs)) {
+      IIR_gauss_lines(src, coefs, xy, IIRGaussColorAccessor());
+    }
+    return;
+  }
+#endif
+  for (const int c : IndexRange(src->get_num_channels())) {
+    IIR_gauss(src, sigma, c, xy);
+  }
 }
 
 void FastGaussianBlurOperation::get_area_of_interest(const int input_idx,
@@ -277,20 +372,14 @@ void FastGaussianBlurOperation::update_memory_buffer_started(MemoryBuffer *outpu
   image->copy_from(input, area);
 
   if ((sx_ == sy_) && (sx_ > 0.0f)) {
-    for (const int c : IndexRange(COM_DATA_TYPE_COLOR_CHANNELS)) {
-      IIR_gauss(image, sx_, c, 3);
-    }
+    IIR_gauss(image, sx_, 3);
   }
   else {
     if (sx_ > 0.0f) {
-      for (const int c : IndexRange(COM_DATA_TYPE_COLOR_CHANNELS)) {
-        IIR_gauss(image, sx_, c, 1);
-      }
+      IIR_gauss(image, sx_, 1);
     }
     if (sy_ > 0.0f) {
-      for (const int c : IndexRange(COM_DATA_TYPE_COLOR_CHANNELS)) {
-        IIR_gauss(image, sy_, c, 2);
-      }
+      IIR_gauss(image, sy_, 2);
     }
   }
 
@@ -21,7 +21,16 @@ class FastGaussianBlurOperation : public BlurBaseOperation {
                                             rcti *output) override;
   void execute_pixel(float output[4], int x, int y, void *data) override;
 
+  /**
+   * Blurs a channel of \a src in place with a recursive gaussian filter. \a xy is a bit-mask of
+   * the directions to blur, 1 for X and 2 for Y.
+   */
   static void IIR_gauss(MemoryBuffer *src, float sigma, unsigned int channel, unsigned int xy);
+  /**
+   * Blurs all channels of \a src as #IIR_gauss for a single channel, filtering the channels of
+   * color pixels at once using SIMD when available.
+   */
+  static void IIR_gauss(MemoryBuffer *src, float sigma, unsigned int xy);
   void *initialize_tile_data(rcti *rect) override;
   void init_data() override;
   void deinit_execution() override;
@@ -43,6 +43,10 @@ void GammaCorrectOperation::execute_pixel_sampled(float output[4],
   }
 }
 
+void GammaCorrectOperation::hash_output_params()
+{
+}
+
 void GammaCorrectOperation::update_memory_buffer_partial(MemoryBuffer *output,
                                                          const rcti &area,
                                                          Span<MemoryBuffer *> inputs)
@@ -114,6 +118,10 @@ void GammaUncorrectOperation::execute_pixel_sampled(float output[4],
   }
 }
 
+void GammaUncorrectOperation::hash_output_params()
+{
+}
+
 void GammaUncorrectOperation::update_memory_buffer_partial(MemoryBuffer *output,
                                                            const rcti &area,
                                                            Span<MemoryBuffer *> inputs)
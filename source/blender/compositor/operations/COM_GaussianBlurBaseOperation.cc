@@ -76,63 +76,149 @@ void GaussianBlurBaseOperation::get_area_of_interest(const int input_idx,
   }
 }
 
+void GaussianBlurBaseOperation::blur_pixel(const float *in,
+                                           const int tap_stride,
+                                           const int gauss_start,
+                                           const int gauss_end,
+                                           float *out) const
+{
+  float ATTR_ALIGN(16) color_accum[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+  float multiplier_accum = 0.0f;
+
+  const int step = QualityStepHelper::get_step();
+  const int in_stride = tap_stride * step;
+  int gauss_idx = gauss_start;
+#ifdef BLI_HAVE_SSE2
+  __m128 accum_r = _mm_load_ps(color_accum);
+  for (; gauss_idx < gauss_end; in += in_stride, gauss_idx += step) {
+    __m128 reg_a = _mm_load_ps(in);
+    reg_a = _mm_mul_ps(reg_a, gausstab_sse_[gauss_idx]);
+    accum_r = _mm_add_ps(accum_r, reg_a);
+    multiplier_accum += gausstab_[gauss_idx];
+  }
+  _mm_store_ps(color_accum, accum_r);
+#else
+  for (; gauss_idx < gauss_end; in += in_stride, gauss_idx += step) {
+    const float multiplier = gausstab_[gauss_idx];
+    madd_v4_v4fl(color_accum, in, multiplier);
+    multiplier_accum += multiplier;
+  }
+#endif
+  mul_v4_v4fl(out, color_accum, 1.0f / multiplier_accum);
+}
+
+void GaussianBlurBaseOperation::blur_pixels_block(const float *in,
+                                                  const int pixel_stride,
+                                                  const int tap_stride,
+                                                  const int gauss_start,
+                                                  const int gauss_end,
+                                                  float *out,
+                                                  const int out_stride) const
+{
+  BLI_STATIC_ASSERT(BLUR_BLOCK_NUM_PIXELS == 4, "Block is unrolled for 4 pixels");
+  float multiplier_accum = 0.0f;
+
+  const int step = QualityStepHelper::get_step();
+  const int in_stride = tap_stride * step;
+  int gauss_idx = gauss_start;
+#ifdef BLI_HAVE_SSE2
+  /* An accumulator per pixel, so that additions don't wait for each other. Kept unrolled so
+   * that accumulators stay in registers. */
+  __m128 accum_0 = _mm_setzero_ps();
+  __m128 accum_1 = _mm_setzero_ps();
+  __m128 accum_2 = _mm_setzero_ps();
+  __m128 accum_3 = _mm_setzero_ps();
+  for (; gauss_idx < gauss_end; in += in_stride, gauss_idx += step) {
+    const __m128 multiplier = gausstab_sse_[gauss_idx];
+    accum_0 = _mm_add_ps(accum_0, _mm_mul_ps(_mm_load_ps(in), multiplier));
+    accum_1 = _mm_add_ps(accum_1, _mm_mul_ps(_mm_load_ps(in + pixel_stride), multiplier));
+    accum_2 = _mm_add_ps(accum_2, _mm_mul_ps(_mm_load_ps(in + 2 * pixel_stride), multiplier));
+    accum_3 = _mm_add_ps(accum_3, _mm_mul_ps(_mm_load_ps(in + 3 * pixel_stride), multiplier));
+    multiplier_accum += gausstab_[gauss_idx];
+  }
+  const __m128 normalize = _mm_set1_ps(1.0f / multiplier_accum);
+  _mm_storeu_ps(out, _mm_mul_ps(accum_0, normalize));
+  _mm_storeu_ps(out + out_stride, _mm_mul_ps(accum_1, normalize));
+  _mm_storeu_ps(out + 2 * out_stride, _mm_mul_ps(accum_2, normalize));
+  _mm_storeu_ps(out + 3 * out_stride, _mm_mul_ps(accum_3, normalize));
+#else
+  float color_accum[BLUR_BLOCK_NUM_PIXELS][4] = {{0.0f}};
+  for (; gauss_idx < gauss_end; in += in_stride, gauss_idx += step) {
+    const float multiplier = gausstab_[gauss_idx];
+    for (int i = 0; i < BLUR_BLOCK_NUM_PIXELS; i++) {
+      madd_v4_v4fl(color_accum[i], in + i * pixel_stride, multiplier);
+    }
+    multiplier_accum += multiplier;
+  }
+  for (int i = 0; i < BLUR_BLOCK_NUM_PIXELS; i++) {
+    mul_v4_v4fl(out + i * out_stride, color_accum[i], 1.0f / multiplier_accum);
+  }
+#endif
+}
+
 void GaussianBlurBaseOperation::update_memory_buffer_partial(MemoryBuffer *output,
                                                              const rcti &area,
                                                              Span<MemoryBuffer *> inputs)
 {
   MemoryBuffer *input = inputs[IMAGE_INPUT_INDEX];
   const rcti &input_rect = input->get_rect();
-  BuffersIterator<float> it = output->iterate_with({input}, area);
+  const float *input_buffer = input->get_buffer();
 
   int min_input_coord = -1;
   int max_input_coord = -1;
-  int elem_stride = -1;
-  std::function<int()> get_current_coord;
+  int tap_stride = -1;
   switch (dimension_) {
     case eDimension::X:
       min_input_coord = input_rect.xmin;
       max_input_coord = input_rect.xmax;
-      elem_stride = input->elem_stride;
-      get_current_coord = [&] { return it.x; };
+      tap_stride = input->elem_stride;
       break;
     case eDimension::Y:
       min_input_coord = input_rect.ymin;
       max_input_coord = input_rect.ymax;
-      elem_stride = input->row_stride;
-      get_current_coord = [&] { return it.y; };
+      tap_stride = input->row_stride;
       break;
   }
 
-  for (; !it.is_end(); ++it) {
-    const int coord = get_current_coord();
-    const int coord_min = max_ii(coord - filtersize_, min_input_coord);
-    const int coord_max = min_ii(coord + filtersize_ + 1, max_input_coord);
-
-    float ATTR_ALIGN(16) color_accum[4] = {0.0f, 0.0f, 0.0f, 0.0f};
-    float multiplier_accum = 0.0f;
+  /* Area is rendered in strips of columns, so that the input rows read when blurring in Y are
+   * still cached when rendering the next row. */
+  for (int strip_xmin = area.xmin; strip_xmin < area.xmax; strip_xmin += BLUR_STRIP_WIDTH) {
+    const int strip_xmax = min_ii(strip_xmin + BLUR_STRIP_WIDTH, area.xmax);
+    for (int y = area.ymin; y < area.ymax; y++) {
+      float *out = output->get_elem(strip_xmin, y);
+      for (int x = strip_xmin; x < strip_xmax;) {
+        const int coord = dimension_ == eDimension::X ? x : y;
+        const int coord_min = max_ii(coord - filtersize_, min_input_coord);
+        const int coord_max = min_ii(coord + filtersize_ + 1, max_input_coord);
+        const int gauss_start = (coord_min - coord) + filtersize_;
+        const int gauss_end = gauss_start + (coord_max - coord_min);
+        const float *in = input_buffer + input->get_coords_offset(x, y) +
+                          (intptr_t(coord_min) - coord) * tap_stride;
 
-    const int step = QualityStepHelper::get_step();
-    const float *in = it.in(0) + (intptr_t(coord_min) - coord) * elem_stride;
-    const int in_stride = elem_stride * step;
-    int gauss_idx = (coord_min - coord) + filtersize_;
-    const int gauss_end = gauss_idx + (coord_max - coord_min);
-#ifdef BLI_HAVE_SSE2
-    __m128 accum_r = _mm_load_ps(color_accum);
-    for (; gauss_idx < gauss_end; in += in_stride, gauss_idx += step) {
-      __m128 reg_a = _mm_load_ps(in);
-      reg_a = _mm_mul_ps(reg_a, gausstab_sse_[gauss_idx]);
-      accum_r = _mm_add_ps(accum_r, reg_a);
-      multiplier_accum += gausstab_[gauss_idx];
+        /* Pixels of a row read the same kernel weights unless their kernels are clipped by the
+         * input borders, which only happens near the borders when blurring in X. */
+        const bool is_block_clipped = dimension_ == eDimension::X &&
+                                      (coord - filtersize_ < min_input_coord ||
+                                       coord + BLUR_BLOCK_NUM_PIXELS + filtersize_ >
+                                           max_input_coord);
+        if (x + BLUR_BLOCK_NUM_PIXELS <= strip_xmax && !is_block_clipped) {
+          blur_pixels_block(in,
+                            input->elem_stride,
+                            tap_stride,
+                            gauss_start,
+                            gauss_end,
+                            out,
+                            output->elem_stride);
+          x += BLUR_BLOCK_NUM_PIXELS;
+          out += BLUR_BLOCK_NUM_PIXELS * output->elem_stride;
+        }
+        else {
+          blur_pixel(in, tap_stride, gauss_start, gauss_end, out);
+          x++;
+          out += output->elem_stride;
+        }
+      }
     }
-    _mm_store_ps(color_accum, accum_r);
-#else
-    for (; gauss_idx < gauss_end; in += in_stride, gauss_idx += step) {
-      const float multiplier = gausstab_[gauss_idx];
-      madd_v4_v4fl(color_accum, in, multiplier);
-      multiplier_accum += multiplier;
-    }
-#endif
-    mul_v4_v4fl(it.out, color_accum, 1.0f / multiplier_accum);
   }
 }
 
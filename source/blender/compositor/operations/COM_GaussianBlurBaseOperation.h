@@ -8,6 +8,16 @@
 namespace blender::compositor {
 
 class GaussianBlurBaseOperation : public BlurBaseOperation {
+ private:
+  /**
+   * Number of adjacent pixels of a row blurred together when they read the same kernel weights.
+   * Every weight is loaded once for all of them and their sums are independent.
+   */
+  static constexpr int BLUR_BLOCK_NUM_PIXELS = 4;
+
+  /** Width in pixels of the strips of columns areas are rendered in. */
+  static constexpr int BLUR_STRIP_WIDTH = 256;
+
  protected:
   float *gausstab_;
 #ifdef BLI_HAVE_SSE2
@@ -28,6 +38,29 @@ class GaussianBlurBaseOperation : public BlurBaseOperation {
   virtual void update_memory_buffer_partial(MemoryBuffer *output,
                                             const rcti &area,
                                             Span<MemoryBuffer *> inputs) override;
+
+ private:
+  /**
+   * Blurs a pixel with the kernel weights from \a gauss_start to \a gauss_end, \a in being the
+   * first input element read.
+   */
+  void blur_pixel(const float *in,
+                  int tap_stride,
+                  int gauss_start,
+                  int gauss_end,
+                  float *out) const;
+
+  /**
+   * Blurs #BLUR_BLOCK_NUM_PIXELS adjacent pixels of a row reading the same kernel weights, as
+   * #blur_pixel for each of them.
+   */
+  void blur_pixels_block(const float *in,
+                         int pixel_stride,
+                         int tap_stride,
+                         int gauss_start,
+                         int gauss_end,
+                         float *out,
+                         int out_stride) const;
 };
 
 }  // namespace blender::compositor
@@ -2,6 +2,7 @@
  * Copyright 2011 Blender Foundation. */
 
 #include "COM_GaussianBokehBlurOperation.h"
+#include "COM_FFTConvolution.h"
 
 #include "RE_pipeline.h"
 
@@ -10,6 +11,7 @@ namespace blender::compositor {
 GaussianBokehBlurOperation::GaussianBokehBlurOperation() : BlurBaseOperation(DataType::Color)
 {
   gausstab_ = nullptr;
+  convolved_image_ = nullptr;
 }
 
 void *GaussianBokehBlurOperation::initialize_tile_data(rcti * /*rect*/)
@@ -212,10 +214,40 @@ void GaussianBokehBlurOperation::get_area_of_interest(const int input_idx,
   r_input_area.ymin = output_area.ymin - rady_;
 }
 
+void GaussianBokehBlurOperation::update_memory_buffer_started(MemoryBuffer * /*output*/,
+                                                              const rcti &area,
+                                                              Span<MemoryBuffer *> inputs)
+{
+  if (max_ii(radx_, rady_) < FFT_CONVOLUTION_MIN_RADIUS) {
+    return;
+  }
+
+  /* Filter flipped for the convolution, at full quality. */
+  const int kernel_width = 2 * radx_ + 1;
+  const int kernel_height = 2 * rady_ + 1;
+  rcti kernel_rect;
+  BLI_rcti_init(&kernel_rect, 0, kernel_width, 0, kernel_height);
+  MemoryBuffer kernel(DataType::Value, kernel_rect);
+  for (int y = 0; y < kernel_height; y++) {
+    for (int x = 0; x < kernel_width; x++) {
+      *kernel.get_elem(x, y) = gausstab_[(kernel_height - 1 - y) * kernel_width +
+                                         (kernel_width - 1 - x)];
+    }
+  }
+
+  convolved_image_ = new MemoryBuffer(DataType::Color, area);
+  convolve_fft_normalized(*inputs[IMAGE_INPUT_INDEX], kernel, radx_, rady_, *convolved_image_);
+}
+
 void GaussianBokehBlurOperation::update_memory_buffer_partial(MemoryBuffer *output,
                                                               const rcti &area,
                                                               Span<MemoryBuffer *> inputs)
 {
+  if (convolved_image_) {
+    output->copy_from(convolved_image_, area);
+    return;
+  }
+
   const MemoryBuffer *input = inputs[IMAGE_INPUT_INDEX];
   BuffersIterator<float> it = output->iterate_with({}, area);
   const rcti &input_rect = input->get_rect();
@@ -249,6 +281,14 @@ void GaussianBokehBlurOperation::update_memory_buffer_partial(MemoryBuffer *outp
   }
 }
 
+void GaussianBokehBlurOperation::update_memory_buffer_finished(MemoryBuffer * /*output*/,
+                                                               const rcti & /*area*/,
+                                                               Span<MemoryBuffer *> /*inputs*/)
+{
+  delete convolved_image_;
+  convolved_image_ = nullptr;
+}
+
 // reference image
 GaussianBlurReferenceOperation::GaussianBlurReferenceOperation()
     : BlurBaseOperation(DataType::Color)
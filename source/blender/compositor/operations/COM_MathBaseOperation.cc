@@ -18,6 +18,7 @@ MathBaseOperation::MathBaseOperation()
   input_value3_operation_ = nullptr;
   use_clamp_ = false;
   flags_.can_be_constant = true;
+  flags_.is_pixel_operation = true;
 }
 
 void MathBaseOperation::init_execution()
@@ -56,6 +57,11 @@ void MathBaseOperation::clamp_if_needed(float *color)
   }
 }
 
+void MathBaseOperation::hash_output_params()
+{
+  hash_param(use_clamp_);
+}
+
 void MathBaseOperation::update_memory_buffer_partial(MemoryBuffer *output,
                                                      const rcti &area,
                                                      Span<MemoryBuffer *> inputs)
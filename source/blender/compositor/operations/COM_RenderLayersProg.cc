@@ -3,6 +3,10 @@
 
 #include "COM_RenderLayersProg.h"
 
+#include "BLI_array.hh"
+#include "BLI_hash_mm2a.h"
+#include "BLI_task.hh"
+
 #include "BKE_image.h"
 
 namespace blender::compositor {
@@ -196,6 +200,62 @@ void RenderLayersProg::determine_canvas(const rcti & /*preferred_area*/, rcti &r
   }
 }
 
+void RenderLayersProg::hash_output_params()
+{
+  hash_params(scene_, layer_id_, pass_name_);
+  hash_param(StringRef(view_name_ ? view_name_ : ""));
+}
+
+static size_t hash_pass_data(const float *data, const int64_t len)
+{
+  constexpr int64_t chunk_len = 64 * 1024;
+  const int64_t num_chunks = (len + chunk_len - 1) / chunk_len;
+  Array<uint32_t> chunk_hashes(num_chunks);
+  threading::parallel_for(IndexRange(num_chunks), 16, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      const int64_t start = i * chunk_len;
+      const int64_t size = std::min(chunk_len, len - start) * sizeof(float);
+      chunk_hashes[i] = BLI_hash_mm2((const unsigned char *)(data + start), size, 0);
+    }
+  });
+
+  size_t hash = get_default_hash(len);
+  for (const uint32_t chunk_hash : chunk_hashes) {
+    hash = BLI_ghashutil_combine_hash(hash, chunk_hash);
+  }
+  return hash;
+}
+
+size_t RenderLayersProg::hash_external_data()
+{
+  Scene *scene = this->get_scene();
+  Render *re = (scene) ? RE_GetSceneRender(scene) : nullptr;
+  RenderResult *rr = nullptr;
+  size_t hash = 0;
+
+  if (re) {
+    rr = RE_AcquireResultRead(re);
+  }
+
+  if (rr) {
+    ViewLayer *view_layer = (ViewLayer *)BLI_findlink(&scene->view_layers, get_layer_id());
+    if (view_layer) {
+      RenderLayer *rl = RE_GetRenderLayer(rr, view_layer->name);
+      if (rl) {
+        const float *pass_buffer = RE_RenderLayerGetPass(rl, pass_name_.c_str(), view_name_);
+        if (pass_buffer) {
+          hash = hash_pass_data(pass_buffer, int64_t(rl->rectx) * rl->recty * elementsize_);
+        }
+      }
+    }
+  }
+
+  if (re) {
+    RE_ReleaseResult(re);
+  }
+  return hash;
+}
+
 std::unique_ptr<MetaData> RenderLayersProg::get_meta_data()
 {
   Scene *scene = this->get_scene();
@@ -70,6 +70,13 @@ class RenderLayersProg : public MultiThreadedOperation {
 
   void do_interpolation(float output[4], float x, float y, PixelSampler sampler);
 
+  void hash_output_params() override;
+  /**
+   * Hashes the render pass contents, so that results depending on it are not reused from
+   * previous executions when it's rendered again.
+   */
+  size_t hash_external_data() override;
+
  public:
   /**
    * Constructor
@@ -370,6 +370,12 @@ static void blur_pixel(int x, int y, PixelData &p)
   }
 }
 
+void VariableSizeBokehBlurOperation::hash_output_params()
+{
+  hash_params(max_blur_, threshold_, do_size_scale_);
+  hash_param(get_quality());
+}
+
 void VariableSizeBokehBlurOperation::update_memory_buffer_partial(MemoryBuffer *output,
                                                                   const rcti &area,
                                                                   Span<MemoryBuffer *> inputs)
@@ -81,6 +81,9 @@ class VariableSizeBokehBlurOperation : public MultiThreadedOperation, public Qua
   void update_memory_buffer_partial(MemoryBuffer *output,
                                     const rcti &area,
                                     Span<MemoryBuffer *> inputs) override;
+
+ protected:
+  void hash_output_params() override;
 };
 
 /* Currently unused. If ever used, it needs full-frame implementation. */
@@ -0,0 +1,62 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later
+ * Copyright 2023 Blender Foundation. */
+
+#include "testing/testing.h"
+
+#include "BLI_array.hh"
+
+#include "COM_ChunkOrder.h"
+
+namespace blender::compositor::tests {
+
+static constexpr int CHUNK_SIZE = 256;
+
+static Array<ChunkOrder> sort_along_curve(const int x_chunks_len,
+                                          const int y_chunks_len,
+                                          const uint curve_size)
+{
+  Array<ChunkOrder> chunk_orders(x_chunks_len * y_chunks_len);
+  for (int y = 0; y < y_chunks_len; y++) {
+    for (int x = 0; x < x_chunks_len; x++) {
+      ChunkOrder &chunk_order = chunk_orders[y * x_chunks_len + x];
+      chunk_order.index = y * x_chunks_len + x;
+      chunk_order.x = x * CHUNK_SIZE;
+      chunk_order.y = y * CHUNK_SIZE;
+      chunk_order.update_curve_distance(CHUNK_SIZE, curve_size);
+    }
+  }
+  std::sort(chunk_orders.begin(), chunk_orders.end());
+  return chunk_orders;
+}
+
+TEST(ChunkOrder, CurveVisitsNeighbours)
+{
+  Array<ChunkOrder> chunk_orders = sort_along_curve(8, 8, 8);
+  for (const int i : chunk_orders.index_range()) {
+    EXPECT_EQ(chunk_orders[i].distance, double(i));
+    if (i > 0) {
+      const ChunkOrder &prev = chunk_orders[i - 1];
+      EXPECT_EQ(abs(chunk_orders[i].x - prev.x) + abs(chunk_orders[i].y - prev.y), CHUNK_SIZE);
+    }
+  }
+}
+
+TEST(ChunkOrder, CurveCoversNonSquareGrid)
+{
+  Array<ChunkOrder> chunk_orders = sort_along_curve(5, 3, 8);
+  Array<bool> visited(chunk_orders.size(), false);
+  for (const int i : chunk_orders.index_range()) {
+    EXPECT_FALSE(visited[chunk_orders[i].index]);
+    visited[chunk_orders[i].index] = true;
+    if (i > 0) {
+      EXPECT_LT(chunk_orders[i - 1].distance, chunk_orders[i].distance);
+    }
+  }
+  /* Chunks are first ordered in the bottom left quadrant of the curve. */
+  for (const int i : IndexRange(4)) {
+    EXPECT_LT(chunk_orders[i].x, CHUNK_SIZE * 2);
+    EXPECT_LT(chunk_orders[i].y, CHUNK_SIZE * 2);
+  }
+}
+
+}  // namespace blender::compositor::tests
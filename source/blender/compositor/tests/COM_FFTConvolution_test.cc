@@ -0,0 +1,104 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later
+ * Copyright 2023 Blender Foundation. */
+
+#include "testing/testing.h"
+
+#include "BLI_math_base.h"
+
+#include "COM_FFTConvolution.h"
+#include "COM_MemoryBuffer.h"
+
+namespace blender::compositor::tests {
+
+static void fill_buffer(MemoryBuffer &buf, const int seed)
+{
+  const rcti &rect = buf.get_rect();
+  for (int y = rect.ymin; y < rect.ymax; y++) {
+    for (int x = rect.xmin; x < rect.xmax; x++) {
+      float *elem = buf.get_elem(x, y);
+      for (int ch = 0; ch < buf.get_num_channels(); ch++) {
+        elem[ch] = float((x * 7 + y * 13 + ch * 5 + seed) % 17) / 16.0f;
+      }
+    }
+  }
+}
+
+/* Convolve directly, optionally dividing by the kernel weights overlapping the image. */
+static float convolve_pixel(const MemoryBuffer &image,
+                            const MemoryBuffer &kernel,
+                            const int center_x,
+                            const int center_y,
+                            const int x,
+                            const int y,
+                            const int ch,
+                            const bool normalize)
+{
+  float sum = 0.0f;
+  float weight = 0.0f;
+  for (int j = 0; j < kernel.get_height(); j++) {
+    for (int i = 0; i < kernel.get_width(); i++) {
+      const int image_x = x + center_x - i;
+      const int image_y = y + center_y - j;
+      if (!image.has_coords(image_x, image_y)) {
+        continue;
+      }
+      const float k = kernel.get_elem(i, j)[kernel.get_num_channels() == 1 ? 0 : ch];
+      sum += k * image.get_elem(image_x, image_y)[ch];
+      weight += k;
+    }
+  }
+  return normalize ? (weight > 0.0f ? sum / weight : 0.0f) : sum;
+}
+
+static void test_convolution(const MemoryBuffer &kernel, const bool normalize)
+{
+  rcti image_rect;
+  BLI_rcti_init(&image_rect, 3, 160, -5, 86);
+  MemoryBuffer image(DataType::Color, image_rect);
+  fill_buffer(image, 0);
+
+  /* Output larger than the image to test areas with no overlapping pixels. */
+  rcti output_rect;
+  BLI_rcti_init(&output_rect, -10, 170, -20, 100);
+  MemoryBuffer output(DataType::Color, output_rect);
+  const int center_x = kernel.get_width() / 2;
+  const int center_y = kernel.get_height() / 3;
+  if (normalize) {
+    convolve_fft_normalized(image, kernel, center_x, center_y, output);
+  }
+  else {
+    convolve_fft(image, kernel, center_x, center_y, output);
+  }
+
+  for (int y = output_rect.ymin; y < output_rect.ymax; y += 3) {
+    for (int x = output_rect.xmin; x < output_rect.xmax; x += 3) {
+      for (int ch = 0; ch < 4; ch++) {
+        const float expected = convolve_pixel(
+            image, kernel, center_x, center_y, x, y, ch, normalize);
+        EXPECT_NEAR(output.get_elem(x, y)[ch], expected, 1e-4f * max_ff(1.0f, fabsf(expected)));
+      }
+    }
+  }
+}
+
+TEST(FFTConvolution, ColorKernel)
+{
+  rcti kernel_rect;
+  BLI_rcti_init(&kernel_rect, 0, 37, 0, 29);
+  MemoryBuffer kernel(DataType::Color, kernel_rect);
+  fill_buffer(kernel, 3);
+  test_convolution(kernel, false);
+  test_convolution(kernel, true);
+}
+
+TEST(FFTConvolution, ValueKernel)
+{
+  rcti kernel_rect;
+  BLI_rcti_init(&kernel_rect, 0, 33, 0, 33);
+  MemoryBuffer kernel(DataType::Value, kernel_rect);
+  fill_buffer(kernel, 1);
+  test_convolution(kernel, false);
+  test_convolution(kernel, true);
+}
+
+}  // namespace blender::compositor::tests
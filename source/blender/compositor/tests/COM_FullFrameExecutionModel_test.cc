@@ -0,0 +1,262 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later
+ * Copyright 2023 Blender Foundation. */
+
+#include "testing/testing.h"
+
+#include "BKE_node_runtime.hh"
+
+/* Types owned by #bNodeTreeRuntime, needed to create one for a tree that isn't in #Main. */
+#include "NOD_geometry_nodes_lazy_function.hh"
+#include "NOD_node_declaration.hh"
+
+#include "DNA_node_types.h"
+
+#include "COM_CompositorContext.h"
+#include "COM_FullFrameExecutionModel.h"
+#include "COM_MemoryBuffer.h"
+#include "COM_NodeOperation.h"
+#include "COM_SharedOperationBuffers.h"
+#include "COM_WorkScheduler.h"
+
+namespace blender::compositor::tests {
+
+/** Canvas size of all operations, their value buffers take 1 MB. */
+static constexpr int CANVAS_SIZE = 512;
+
+/** Value operation rendering its areas pixel by pixel, without an execution system. */
+class PixelOperation : public NodeOperation {
+ public:
+  int num_rendered_areas = 0;
+
+  PixelOperation(const int num_inputs)
+  {
+    for (int i = 0; i < num_inputs; i++) {
+      add_input_socket(DataType::Value);
+    }
+    add_output_socket(DataType::Value);
+    rcti canvas;
+    BLI_rcti_init(&canvas, 0, CANVAS_SIZE, 0, CANVAS_SIZE);
+    set_canvas(canvas);
+    flags_.is_fullframe_operation = true;
+  }
+
+  void get_area_of_interest(const int /*input_idx*/,
+                            const rcti &output_area,
+                            rcti &r_input_area) override
+  {
+    r_input_area = output_area;
+  }
+
+  void update_memory_buffer(MemoryBuffer *output,
+                            const rcti &area,
+                            Span<MemoryBuffer *> inputs) override
+  {
+    num_rendered_areas++;
+    for (BuffersIterator<float> it = output->iterate_with({}, area); !it.is_end(); ++it) {
+      *it.out = evaluate(it.x, it.y, inputs);
+    }
+  }
+
+ protected:
+  virtual float evaluate(int x, int y, Span<MemoryBuffer *> inputs) = 0;
+};
+
+class SourceOperation : public PixelOperation {
+ public:
+  SourceOperation() : PixelOperation(0) {}
+
+ protected:
+  float evaluate(const int x, const int y, Span<MemoryBuffer *> /*inputs*/) override
+  {
+    return 1.0f + float((x * 3 + y * 5) % 17) / 16.0f;
+  }
+};
+
+/** Flips its input vertically, needing the whole input canvas for any area. */
+class FlipOperation : public PixelOperation {
+ public:
+  FlipOperation() : PixelOperation(1) {}
+
+  void get_area_of_interest(const int /*input_idx*/,
+                            const rcti & /*output_area*/,
+                            rcti &r_input_area) override
+  {
+    r_input_area = get_input_operation(0)->get_canvas();
+  }
+
+ protected:
+  float evaluate(const int x, const int y, Span<MemoryBuffer *> inputs) override
+  {
+    return inputs[0]->get_value(x, CANVAS_SIZE - 1 - y, 0);
+  }
+};
+
+/** Sums its input vertically, needing a margin around the rendered area. */
+class VerticalSumOperation : public PixelOperation {
+ private:
+  static constexpr int RADIUS = 4;
+
+ public:
+  VerticalSumOperation() : PixelOperation(1) {}
+
+  void get_area_of_interest(const int /*input_idx*/,
+                            const rcti &output_area,
+                            rcti &r_input_area) override
+  {
+    r_input_area = output_area;
+    r_input_area.ymin -= RADIUS;
+    r_input_area.ymax += RADIUS;
+  }
+
+ protected:
+  float evaluate(const int x, const int y, Span<MemoryBuffer *> inputs) override
+  {
+    float sum = 0.0f;
+    for (int input_y = max_ii(y - RADIUS, 0); input_y <= min_ii(y + RADIUS, CANVAS_SIZE - 1);
+         input_y++) {
+      sum += inputs[0]->get_value(x, input_y, 0);
+    }
+    return sum;
+  }
+};
+
+class AddOperation : public PixelOperation {
+ public:
+  AddOperation() : PixelOperation(2) {}
+
+ protected:
+  float evaluate(const int x, const int y, Span<MemoryBuffer *> inputs) override
+  {
+    return inputs[0]->get_value(x, y, 0) + inputs[1]->get_value(x, y, 0);
+  }
+};
+
+/** Output operation copying its input into #result. */
+class ResultOperation : public NodeOperation {
+ public:
+  MemoryBuffer result;
+
+  ResultOperation() : result(DataType::Value, canvas())
+  {
+    add_input_socket(DataType::Value);
+    set_canvas(canvas());
+    flags_.is_fullframe_operation = true;
+  }
+
+  bool is_output_operation(bool /*rendering*/) const override
+  {
+    return true;
+  }
+
+  void update_memory_buffer(MemoryBuffer * /*output*/,
+                            const rcti &area,
+                            Span<MemoryBuffer *> inputs) override
+  {
+    result.copy_from(inputs[0], area);
+  }
+
+ private:
+  static rcti canvas()
+  {
+    rcti canvas;
+    BLI_rcti_init(&canvas, 0, CANVAS_SIZE, 0, CANVAS_SIZE);
+    return canvas;
+  }
+};
+
+/**
+ * Source flipped and summed vertically, added to the source again. The flip needs the whole
+ * source, which is rendered in full before the strips. The other operations are rendered in
+ * strips, reading the source buffer.
+ */
+struct StripGraph {
+  SourceOperation source;
+  FlipOperation flip;
+  VerticalSumOperation sum;
+  AddOperation add;
+  ResultOperation output;
+
+  StripGraph()
+  {
+    flip.get_input_socket(0)->set_link(source.get_output_socket());
+    sum.get_input_socket(0)->set_link(flip.get_output_socket());
+    add.get_input_socket(0)->set_link(sum.get_output_socket());
+    add.get_input_socket(1)->set_link(source.get_output_socket());
+    output.get_input_socket(0)->set_link(add.get_output_socket());
+  }
+
+  Vector<NodeOperation *> operations()
+  {
+    return {&source, &flip, &sum, &add, &output};
+  }
+};
+
+class TestFullFrameExecutionModel : public FullFrameExecutionModel {
+ public:
+  using FullFrameExecutionModel::FullFrameExecutionModel;
+
+  void render()
+  {
+    determine_areas_to_render_and_reads();
+    render_operations();
+  }
+};
+
+class FullFrameExecutionModelTest : public testing::Test {
+ protected:
+  bke::bNodeTreeRuntime tree_runtime_;
+  bNodeTree tree_ = {{nullptr}};
+  CompositorContext context_;
+
+  void SetUp() override
+  {
+    tree_runtime_.progress = [](void * /*prh*/, float /*progress*/) {};
+    tree_runtime_.stats_draw = [](void * /*sdh*/, const char * /*str*/) {};
+    tree_.runtime = &tree_runtime_;
+    context_.set_bnodetree(&tree_);
+    WorkScheduler::initialize(false, 1);
+  }
+
+  void TearDown() override
+  {
+    WorkScheduler::deinitialize();
+  }
+
+  void render(StripGraph &graph, SharedOperationBuffers &buffers)
+  {
+    Vector<NodeOperation *> operations = graph.operations();
+    TestFullFrameExecutionModel execution_model(context_, buffers, operations);
+    execution_model.render();
+  }
+};
+
+TEST_F(FullFrameExecutionModelTest, strips_match_single_pass)
+{
+  StripGraph single_pass;
+  SharedOperationBuffers single_pass_buffers;
+  tree_.max_memory = 0;
+  render(single_pass, single_pass_buffers);
+  EXPECT_EQ(single_pass.sum.num_rendered_areas, 1);
+
+  /* Less than the source and flip buffers together. */
+  StripGraph strips;
+  SharedOperationBuffers strips_buffers;
+  tree_.max_memory = 1;
+  render(strips, strips_buffers);
+  EXPECT_EQ(strips.source.num_rendered_areas, 1);
+  EXPECT_GT(strips.flip.num_rendered_areas, 1);
+  EXPECT_GT(strips.sum.num_rendered_areas, 1);
+
+  for (BuffersIterator<float> it = strips.output.result.iterate_with(
+           {&single_pass.output.result});
+       !it.is_end();
+       ++it) {
+    ASSERT_EQ(*it.out, *it.in(0));
+  }
+
+  /* Buffers rendered in full are disposed once the strips and the output have read them. */
+  EXPECT_EQ(strips_buffers.get_rendered_buffer(&strips.source), nullptr);
+  EXPECT_EQ(strips_buffers.get_rendered_buffer(&strips.add), nullptr);
+}
+
+}  // namespace blender::compositor::tests
@@ -0,0 +1,172 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later
+ * Copyright 2023 Blender Foundation. */
+
+#include "testing/testing.h"
+
+#include "BLI_timeit.hh"
+
+#include "DNA_scene_types.h"
+
+#include "COM_FastGaussianBlurOperation.h"
+#include "COM_GaussianXBlurOperation.h"
+#include "COM_GaussianYBlurOperation.h"
+
+namespace blender::compositor::tests {
+
+static void fill_pseudo_random(MemoryBuffer &buffer)
+{
+  float *elem = buffer.get_buffer();
+  const int64_t buffer_len = int64_t(buffer.get_width()) * buffer.get_height() *
+                             buffer.get_num_channels();
+  for (int64_t i = 0; i < buffer_len; i++) {
+    elem[i] = float((i * 7919) % 1000) / 1000.0f;
+  }
+}
+
+template<typename BlurOperation>
+static void blur(MemoryBuffer &input, const int size, MemoryBuffer &output)
+{
+  NodeBlurData data = {0};
+  data.sizex = size;
+  data.sizey = size;
+  data.filtertype = R_FILTER_GAUSS;
+
+  BlurOperation operation;
+  operation.set_execution_model(eExecutionModel::FullFrame);
+  operation.set_data(&data);
+  operation.set_size(1.0f);
+  operation.set_canvas(input.get_rect());
+  operation.init_data();
+  operation.init_execution();
+  operation.update_memory_buffer_partial(&output, output.get_rect(), {&input});
+  operation.deinit_execution();
+}
+
+TEST(GaussianBlur, ConstantStaysConstant)
+{
+  rcti rect;
+  BLI_rcti_init(&rect, 0, 37, 0, 23);
+  MemoryBuffer input(DataType::Color, rect);
+  const float color[4] = {0.2f, 0.4f, 0.6f, 1.0f};
+  input.fill(rect, color);
+
+  MemoryBuffer output(DataType::Color, rect);
+  blur<GaussianXBlurOperation>(input, 5, output);
+  for (BuffersIterator<float> it = output.iterate_with({}); !it.is_end(); ++it) {
+    EXPECT_V4_NEAR(it.out, color, 1e-5f);
+  }
+  blur<GaussianYBlurOperation>(input, 5, output);
+  for (BuffersIterator<float> it = output.iterate_with({}); !it.is_end(); ++it) {
+    EXPECT_V4_NEAR(it.out, color, 1e-5f);
+  }
+}
+
+TEST(GaussianBlur, ImpulseIsSymmetric)
+{
+  rcti rect;
+  BLI_rcti_init(&rect, 0, 41, 0, 3);
+  MemoryBuffer input(DataType::Color, rect);
+  const float zero[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+  const float one[4] = {1.0f, 1.0f, 1.0f, 1.0f};
+  input.fill(rect, zero);
+  for (int y = 0; y < 3; y++) {
+    copy_v4_v4(input.get_elem(20, y), one);
+  }
+
+  MemoryBuffer output(DataType::Color, rect);
+  blur<GaussianXBlurOperation>(input, 5, output);
+  for (int y = 0; y < 3; y++) {
+    EXPECT_GT(output.get_elem(20, y)[0], output.get_elem(21, y)[0]);
+    for (int offset = 1; offset <= 20; offset++) {
+      EXPECT_V4_NEAR(output.get_elem(20 - offset, y), output.get_elem(20 + offset, y), 1e-6f);
+    }
+    EXPECT_V4_NEAR(output.get_elem(0, y), zero, 1e-6f);
+  }
+}
+
+TEST(GaussianBlur, XBlurEqualsTransposedYBlur)
+{
+  rcti rect;
+  BLI_rcti_init(&rect, 0, 37, 0, 23);
+  rcti transposed_rect;
+  BLI_rcti_init(&transposed_rect, 0, 23, 0, 37);
+  MemoryBuffer input(DataType::Color, rect);
+  fill_pseudo_random(input);
+  MemoryBuffer transposed_input(DataType::Color, transposed_rect);
+  for (int y = 0; y < 23; y++) {
+    for (int x = 0; x < 37; x++) {
+      copy_v4_v4(transposed_input.get_elem(y, x), input.get_elem(x, y));
+    }
+  }
+
+  MemoryBuffer output(DataType::Color, rect);
+  blur<GaussianXBlurOperation>(input, 6, output);
+  MemoryBuffer transposed_output(DataType::Color, transposed_rect);
+  blur<GaussianYBlurOperation>(transposed_input, 6, transposed_output);
+  for (int y = 0; y < 23; y++) {
+    for (int x = 0; x < 37; x++) {
+      EXPECT_V4_NEAR(output.get_elem(x, y), transposed_output.get_elem(y, x), 1e-5f);
+    }
+  }
+}
+
+TEST(FastGaussianBlur, AllChannelsEqualsEachChannel)
+{
+  rcti rect;
+  BLI_rcti_init(&rect, 0, 37, 0, 23);
+  MemoryBuffer all_channels(DataType::Color, rect);
+  fill_pseudo_random(all_channels);
+  MemoryBuffer each_channel(all_channels);
+
+  FastGaussianBlurOperation::IIR_gauss(&all_channels, 4.0f, 3);
+  for (const int c : IndexRange(COM_DATA_TYPE_COLOR_CHANNELS)) {
+    FastGaussianBlurOperation::IIR_gauss(&each_channel, 4.0f, c, 3);
+  }
+  for (int y = 0; y < 23; y++) {
+    for (int x = 0; x < 37; x++) {
+      EXPECT_V4_NEAR(all_channels.get_elem(x, y), each_channel.get_elem(x, y), 1e-6f);
+    }
+  }
+}
+
+/**
+ * Set this to 1 to activate the benchmark. It is disabled by default, because it prints a lot.
+ */
+#if 0
+TEST(GaussianBlur, Benchmark)
+{
+  rcti rect;
+  BLI_rcti_init(&rect, 0, 3840, 0, 2160);
+  MemoryBuffer input(DataType::Color, rect);
+  fill_pseudo_random(input);
+  MemoryBuffer output(DataType::Color, rect);
+
+  for (const int size : {5, 30}) {
+    const std::string suffix = " size " + std::to_string(size);
+    for (int i = 0; i < 3; i++) {
+      {
+        SCOPED_TIMER("Gaussian X" + suffix);
+        blur<GaussianXBlurOperation>(input, size, output);
+      }
+      {
+        SCOPED_TIMER("Gaussian Y" + suffix);
+        blur<GaussianYBlurOperation>(input, size, output);
+      }
+      output.copy_from(&input, rect);
+      {
+        SCOPED_TIMER("Fast Gaussian each channel" + suffix);
+        for (const int c : IndexRange(COM_DATA_TYPE_COLOR_CHANNELS)) {
+          FastGaussianBlurOperation::IIR_gauss(&output, size / 2.0f, c, 3);
+        }
+      }
+      output.copy_from(&input, rect);
+      {
+        SCOPED_TIMER("Fast Gaussian all channels" + suffix);
+        FastGaussianBlurOperation::IIR_gauss(&output, size / 2.0f, 3);
+      }
+    }
+  }
+}
+#endif
+
+}  // namespace blender::compositor::tests
@@ -0,0 +1,51 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later
+ * Copyright 2023 Blender Foundation. */
+
+#include "testing/testing.h"
+
+#include "BLI_utildefines.h"
+
+#include "COM_MemoryBuffer.h"
+
+namespace blender::compositor::tests {
+
+TEST(MemoryBuffer, HalfStorage)
+{
+  rcti rect;
+  BLI_rcti_init(&rect, 0, 4, 0, 2);
+  MemoryBuffer buf(DataType::Color, rect);
+
+  const float values[] = {0.0f, 1.0f, -2.5f, 0.1f, 1e-6f, 3.14159f, 1000.3f, 1e10f};
+  const int num_values = ARRAY_SIZE(values);
+  const int buf_len = BLI_rcti_size_x(&rect) * BLI_rcti_size_y(&rect) * buf.get_num_channels();
+  for (int i = 0; i < buf_len; i++) {
+    buf.get_buffer()[i] = values[i % num_values];
+  }
+
+  buf.use_half_storage();
+  EXPECT_TRUE(buf.has_half_storage());
+  EXPECT_EQ(buf.get_buffer(), nullptr);
+
+  buf.restore_float_storage();
+  ASSERT_NE(buf.get_buffer(), nullptr);
+  const float *result = buf.get_buffer();
+  EXPECT_EQ(result[0], 0.0f);
+  EXPECT_EQ(result[1], 1.0f);
+  EXPECT_EQ(result[2], -2.5f);
+  EXPECT_NEAR(result[3], 0.1f, 1e-4f);
+  EXPECT_NEAR(result[4], 1e-6f, 1e-7f);
+  EXPECT_NEAR(result[5], 3.14159f, 2e-3f);
+  EXPECT_NEAR(result[6], 1000.3f, 0.5f);
+  /* Out of range values are clamped. */
+  EXPECT_EQ(result[7], 65504.0f);
+  for (int i = num_values; i < buf_len; i++) {
+    EXPECT_EQ(result[i], result[i % num_values]);
+  }
+
+  /* Float data can be freed again without losing the half float data. */
+  buf.use_half_storage();
+  buf.restore_float_storage();
+  EXPECT_EQ(buf.get_buffer()[2], -2.5f);
+}
+
+}  // namespace blender::compositor::tests
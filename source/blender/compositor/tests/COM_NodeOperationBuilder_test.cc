@@ -0,0 +1,439 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later
+ * Copyright 2023 Blender Foundation. */
+
+#include "testing/testing.h"
+
+#include "BLI_map.hh"
+#include "BLI_set.hh"
+
+#include "DNA_node_types.h"
+#include "DNA_userdef_types.h"
+
+#include "COM_CompositorContext.h"
+#include "COM_ConvertOperation.h"
+#include "COM_Converter.h"
+#include "COM_FusedOperation.h"
+#include "COM_GammaOperation.h"
+#include "COM_MathBaseOperation.h"
+#include "COM_MixOperation.h"
+#include "COM_NodeOperationBuilder.h"
+#include "COM_SetAlphaReplaceOperation.h"
+#include "COM_SetValueOperation.h"
+
+namespace blender::compositor::tests {
+
+/** Writes a value that is different for every pixel and never zero. */
+class PatternOperation : public MultiThreadedOperation {
+ public:
+  PatternOperation(const rcti &canvas)
+  {
+    add_output_socket(DataType::Value);
+    set_canvas(canvas);
+  }
+
+  void update_memory_buffer_partial(MemoryBuffer *output,
+                                    const rcti &area,
+                                    Span<MemoryBuffer *> /*inputs*/) override
+  {
+    for (BuffersIterator<float> it = output->iterate_with({}, area); !it.is_end(); ++it) {
+      *it.out = 1.0f + float(it.x + it.y * 7) / 16.0f;
+    }
+  }
+};
+
+/** Operation reading a color of its canvas, only used to link inputs to. */
+class ReaderOperation : public NodeOperation {
+ public:
+  ReaderOperation(const rcti &canvas)
+  {
+    add_input_socket(DataType::Color);
+    add_output_socket(DataType::Color);
+    set_canvas(canvas);
+  }
+};
+
+/** Same conversion as #ConvertValueToColorOperation, which canvas conversion doesn't look into. */
+class ValueToColorOperation : public MultiThreadedOperation {
+ public:
+  ValueToColorOperation(const rcti &canvas)
+  {
+    add_input_socket(DataType::Value);
+    add_output_socket(DataType::Color);
+    set_canvas(canvas);
+  }
+
+  void update_memory_buffer_partial(MemoryBuffer *output,
+                                    const rcti &area,
+                                    Span<MemoryBuffer *> inputs) override
+  {
+    for (BuffersIterator<float> it = output->iterate_with(inputs, area); !it.is_end(); ++it) {
+      it.out[0] = it.out[1] = it.out[2] = *it.in(0);
+      it.out[3] = 1.0f;
+    }
+  }
+};
+
+/** Gives access to the rendering of multi-threaded operations without an execution system. */
+class MultiThreadedOperationAccess : public MultiThreadedOperation {
+ public:
+  static void render(MultiThreadedOperation &operation,
+                     MemoryBuffer *output,
+                     const rcti &area,
+                     Span<MemoryBuffer *> inputs)
+  {
+    (operation.*&MultiThreadedOperationAccess::update_memory_buffer_partial)(
+        output, area, inputs);
+  }
+};
+
+/**
+ * Renders operations and their inputs into full size buffers, translating input buffers
+ * like #FullFrameExecutionModel does.
+ */
+class OperationEvaluator {
+ private:
+  Map<NodeOperation *, MemoryBuffer *> buffers_;
+
+ public:
+  ~OperationEvaluator()
+  {
+    for (MemoryBuffer *buffer : buffers_.values()) {
+      delete buffer;
+    }
+  }
+
+  MemoryBuffer &evaluate(NodeOperation &operation)
+  {
+    if (MemoryBuffer **buffer = buffers_.lookup_ptr(&operation)) {
+      return **buffer;
+    }
+
+    rcti area;
+    BLI_rcti_init(&area, 0, operation.get_width(), 0, operation.get_height());
+    Vector<MemoryBuffer *> inputs;
+    for (int i = 0; i < int(operation.get_number_of_input_sockets()); i++) {
+      NodeOperation &input_operation = *operation.get_input_operation(i);
+      MemoryBuffer &input = evaluate(input_operation);
+      rcti rect = input.get_rect();
+      BLI_rcti_translate(&rect,
+                         input_operation.get_canvas().xmin - operation.get_canvas().xmin,
+                         input_operation.get_canvas().ymin - operation.get_canvas().ymin);
+      inputs.append(new MemoryBuffer(
+          input.get_buffer(), input.get_num_channels(), rect, input.is_a_single_elem()));
+
+      /* Some operations initialize their parameters when the areas to render are determined. */
+      rcti input_area;
+      operation.get_area_of_interest(i, area, input_area);
+    }
+
+    const bool is_constant = operation.get_flags().is_constant_operation;
+    MemoryBuffer *output = new MemoryBuffer(
+        operation.get_output_socket()->get_data_type(), area, is_constant);
+    operation.init_data();
+    operation.init_execution();
+    if (is_constant) {
+      operation.update_memory_buffer(output, area, inputs);
+    }
+    else {
+      MultiThreadedOperationAccess::render(
+          static_cast<MultiThreadedOperation &>(operation), output, area, inputs);
+    }
+    operation.deinit_execution();
+
+    for (MemoryBuffer *input : inputs) {
+      delete input;
+    }
+    buffers_.add_new(&operation, output);
+    return *output;
+  }
+};
+
+class TestNodeOperationBuilder : public NodeOperationBuilder {
+ public:
+  using NodeOperationBuilder::fuse_pixel_operations;
+  using NodeOperationBuilder::NodeOperationBuilder;
+};
+
+/** Builds operation graphs in full frame execution model, without a node tree to convert. */
+class NodeOperationBuilderTest : public testing::Test {
+ protected:
+  bNodeTree tree_ = {{nullptr}};
+  CompositorContext context_;
+  std::unique_ptr<TestNodeOperationBuilder> builder_;
+  char use_full_frame_compositor_;
+
+  void SetUp() override
+  {
+    use_full_frame_compositor_ = U.experimental.use_full_frame_compositor;
+    U.experimental.use_full_frame_compositor = 1;
+    tree_.execution_mode = NTREE_EXECUTION_MODE_FULL_FRAME;
+    context_.set_bnodetree(&tree_);
+    builder_ = std::make_unique<TestNodeOperationBuilder>(&context_, &tree_, nullptr);
+  }
+
+  void TearDown() override
+  {
+    for (NodeOperation *operation : builder_->get_operations()) {
+      delete operation;
+    }
+    builder_.reset();
+    U.experimental.use_full_frame_compositor = use_full_frame_compositor_;
+  }
+};
+
+template<typename T> static T *add_operation(NodeOperationBuilder &builder, const rcti &canvas)
+{
+  T *operation = new T();
+  operation->set_canvas(canvas);
+  builder.add_operation(operation);
+  return operation;
+}
+
+static void add_links(NodeOperationBuilder &builder,
+                      NodeOperation &operation,
+                      Span<NodeOperation *> inputs)
+{
+  for (const int i : inputs.index_range()) {
+    builder.add_link(inputs[i]->get_output_socket(), operation.get_input_socket(i));
+  }
+}
+
+static void expect_buffers_near(MemoryBuffer &a, MemoryBuffer &b)
+{
+  ASSERT_TRUE(BLI_rcti_compare(&a.get_rect(), &b.get_rect()));
+  ASSERT_EQ(a.get_num_channels(), b.get_num_channels());
+  for (BuffersIterator<float> it = a.iterate_with({&b}); !it.is_end(); ++it) {
+    for (int i = 0; i < a.get_num_channels(); i++) {
+      EXPECT_NEAR(it.out[i], it.in(0)[i], 1e-6f);
+    }
+  }
+}
+
+TEST_F(NodeOperationBuilderTest, convert_canvas_keeps_outside_transparent)
+{
+  rcti input_canvas;
+  BLI_rcti_init(&input_canvas, 0, 4, 0, 4);
+  rcti reader_canvas;
+  BLI_rcti_init(&reader_canvas, 0, 8, 0, 8);
+
+  PatternOperation *pattern = new PatternOperation(input_canvas);
+  NodeOperation *converter = new ConvertValueToColorOperation();
+  converter->set_canvas(input_canvas);
+  ReaderOperation *reader = new ReaderOperation(reader_canvas);
+  builder_->add_operation(pattern);
+  builder_->add_operation(converter);
+  builder_->add_operation(reader);
+  builder_->add_link(pattern->get_output_socket(), converter->get_input_socket(0));
+  builder_->add_link(converter->get_output_socket(), reader->get_input_socket(0));
+
+  COM_convert_canvas(*builder_, converter->get_output_socket(), reader->get_input_socket(0));
+
+  OperationEvaluator evaluator;
+  NodeOperation &resized = reader->get_input_socket(0)->get_link()->get_operation();
+  ASSERT_TRUE(BLI_rcti_compare(&resized.get_canvas(), &reader_canvas));
+  MemoryBuffer &result = evaluator.evaluate(resized);
+
+  /* Input is centered, the area around it must stay transparent black. */
+  const float transparent[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+  EXPECT_V4_NEAR(result.get_elem(0, 0), transparent, 1e-6f);
+  EXPECT_V4_NEAR(result.get_elem(7, 7), transparent, 1e-6f);
+
+  const float value = evaluator.evaluate(*pattern).get_value(0, 0, 0);
+  const float inside[4] = {value, value, value, 1.0f};
+  EXPECT_V4_NEAR(result.get_elem(2, 2), inside, 1e-6f);
+}
+
+/* Resizing a value before converting it to color must give the same result as resizing the
+ * converted color. */
+TEST_F(NodeOperationBuilderTest, convert_canvas_before_value_to_color)
+{
+  rcti input_canvas;
+  BLI_rcti_init(&input_canvas, 0, 5, 0, 3);
+  rcti reader_canvas;
+  BLI_rcti_init(&reader_canvas, 0, 12, 0, 8);
+  PatternOperation *pattern = new PatternOperation(input_canvas);
+  builder_->add_operation(pattern);
+
+  for (const ResizeMode mode :
+       {ResizeMode::Align, ResizeMode::Center, ResizeMode::FitAny, ResizeMode::Stretch}) {
+    NodeOperation *converter = add_operation<ConvertValueToColorOperation>(*builder_,
+                                                                           input_canvas);
+    NodeOperation *reference_converter = new ValueToColorOperation(input_canvas);
+    builder_->add_operation(reference_converter);
+    ReaderOperation *reader = new ReaderOperation(reader_canvas);
+    ReaderOperation *reference_reader = new ReaderOperation(reader_canvas);
+    builder_->add_operation(reader);
+    builder_->add_operation(reference_reader);
+    add_links(*builder_, *converter, {pattern});
+    add_links(*builder_, *reference_converter, {pattern});
+    add_links(*builder_, *reader, {converter});
+    add_links(*builder_, *reference_reader, {reference_converter});
+    reader->get_input_socket(0)->set_resize_mode(mode);
+    reference_reader->get_input_socket(0)->set_resize_mode(mode);
+
+    COM_convert_canvas(*builder_, converter->get_output_socket(), reader->get_input_socket(0));
+    COM_convert_canvas(*builder_,
+                       reference_converter->get_output_socket(),
+                       reference_reader->get_input_socket(0));
+
+    NodeOperation &resized = reader->get_input_socket(0)->get_link()->get_operation();
+    NodeOperation &reference_resized =
+        reference_reader->get_input_socket(0)->get_link()->get_operation();
+    EXPECT_NE(dynamic_cast<SetAlphaReplaceOperation *>(&resized), nullptr);
+    ASSERT_TRUE(BLI_rcti_compare(&resized.get_canvas(), &reference_resized.get_canvas()));
+
+    OperationEvaluator evaluator;
+    expect_buffers_near(evaluator.evaluate(resized), evaluator.evaluate(reference_resized));
+  }
+}
+
+TEST_F(NodeOperationBuilderTest, fused_operation_member_with_several_readers)
+{
+  rcti canvas;
+  BLI_rcti_init(&canvas, 0, 13, 0, 5);
+  PatternOperation *pattern = new PatternOperation(canvas);
+  builder_->add_operation(pattern);
+  SetValueOperation *factor = add_operation<SetValueOperation>(*builder_, canvas);
+  factor->set_value(0.25f);
+
+  /* Members are owned by the fused operation, they aren't added to the builder. */
+  NodeOperation *color = new ConvertValueToColorOperation();
+  NodeOperation *mix = new MixAddOperation();
+  for (NodeOperation *member : {color, mix}) {
+    member->set_canvas(canvas);
+    member->set_execution_model(eExecutionModel::FullFrame);
+  }
+  color->get_input_socket(0)->set_link(pattern->get_output_socket());
+  mix->get_input_socket(0)->set_link(factor->get_output_socket());
+  mix->get_input_socket(1)->set_link(color->get_output_socket());
+  mix->get_input_socket(2)->set_link(color->get_output_socket());
+
+  OperationEvaluator unfused_evaluator;
+  MemoryBuffer &unfused = unfused_evaluator.evaluate(*mix);
+
+  FusedOperation *fused = new FusedOperation({color, mix});
+  builder_->add_operation(fused);
+  ASSERT_EQ(fused->get_number_of_input_sockets(), 2);
+  for (int i = 0; i < 2; i++) {
+    builder_->add_link(fused->get_fused_input_link(i), fused->get_input_socket(i));
+  }
+
+  OperationEvaluator fused_evaluator;
+  expect_buffers_near(fused_evaluator.evaluate(*fused), unfused);
+}
+
+/**
+ * Mix, math and gamma operations sharing inputs. Pixel operations form three groups feeding each
+ * other, each one having an output read several times:
+ * - Colors of the same pattern are mixed, the mix is read by the two other groups.
+ * - The mix converted to a value is multiplied by the pattern, then converted back to color for a
+ *   gamma, read twice by the last group.
+ * - Another gamma of the mix is mixed with the first gamma, using its value as factor.
+ */
+struct FusionGraph {
+  PatternOperation *pattern;
+  SetValueOperation *constant;
+  NodeOperation *color1, *color2, *mix;
+  NodeOperation *mix_value, *math, *math_color, *gamma1;
+  NodeOperation *gamma1_value, *gamma2, *mix2;
+
+  FusionGraph(NodeOperationBuilder &builder, const rcti &canvas)
+  {
+    pattern = new PatternOperation(canvas);
+    builder.add_operation(pattern);
+    constant = add_operation<SetValueOperation>(builder, canvas);
+    constant->set_value(0.5f);
+
+    color1 = add_operation<ConvertValueToColorOperation>(builder, canvas);
+    color2 = add_operation<ConvertValueToColorOperation>(builder, canvas);
+    mix = add_operation<MixAddOperation>(builder, canvas);
+    add_links(builder, *color1, {pattern});
+    add_links(builder, *color2, {pattern});
+    add_links(builder, *mix, {constant, color1, color2});
+
+    mix_value = add_operation<ConvertColorToValueOperation>(builder, canvas);
+    math = add_operation<MathMultiplyOperation>(builder, canvas);
+    math_color = add_operation<ConvertValueToColorOperation>(builder, canvas);
+    gamma1 = add_operation<GammaOperation>(builder, canvas);
+    add_links(builder, *mix_value, {mix});
+    add_links(builder, *math, {mix_value, pattern, constant});
+    add_links(builder, *math_color, {math});
+    add_links(builder, *gamma1, {math_color, constant});
+
+    gamma1_value = add_operation<ConvertColorToValueOperation>(builder, canvas);
+    gamma2 = add_operation<GammaOperation>(builder, canvas);
+    mix2 = add_operation<MixAddOperation>(builder, canvas);
+    add_links(builder, *gamma1_value, {gamma1});
+    add_links(builder, *gamma2, {mix, constant});
+    add_links(builder, *mix2, {gamma1_value, gamma1, gamma2});
+  }
+};
+
+static FusedOperation *find_fused_operation(const NodeOperationBuilder &builder,
+                                            const NodeOperation *last_member)
+{
+  for (NodeOperation *operation : builder.get_operations()) {
+    FusedOperation *fused = dynamic_cast<FusedOperation *>(operation);
+    if (fused && fused->get_members().last() == last_member) {
+      return fused;
+    }
+  }
+  return nullptr;
+}
+
+TEST_F(NodeOperationBuilderTest, fuse_pixel_operations_groups)
+{
+  rcti canvas;
+  BLI_rcti_init(&canvas, 0, 9, 0, 6);
+  FusionGraph graph(*builder_, canvas);
+  builder_->fuse_pixel_operations();
+
+  FusedOperation *fused_mix = find_fused_operation(*builder_, graph.mix);
+  FusedOperation *fused_gamma1 = find_fused_operation(*builder_, graph.gamma1);
+  FusedOperation *fused_mix2 = find_fused_operation(*builder_, graph.mix2);
+  ASSERT_NE(fused_mix, nullptr);
+  ASSERT_NE(fused_gamma1, nullptr);
+  ASSERT_NE(fused_mix2, nullptr);
+  EXPECT_EQ(fused_mix->get_members().size(), 3);
+  EXPECT_EQ(fused_gamma1->get_members().size(), 4);
+  EXPECT_EQ(fused_mix2->get_members().size(), 3);
+
+  /* The pattern read by two members of the mix group is a single input. */
+  EXPECT_EQ(fused_mix->get_number_of_input_sockets(), 2);
+  /* Groups read each other results. */
+  EXPECT_EQ(fused_gamma1->get_input_operation(0), fused_mix);
+  EXPECT_EQ(fused_mix2->get_input_operation(0), fused_gamma1);
+  EXPECT_EQ(fused_mix2->get_input_operation(1), fused_mix);
+
+  /* Only the pattern, the constant and the fused operations are left. Ids are still unique
+   * among all operations, members included. */
+  const Vector<NodeOperation *> &operations = builder_->get_operations();
+  EXPECT_EQ(operations.size(), 5);
+  Set<int> ids;
+  for (NodeOperation *operation : operations) {
+    EXPECT_TRUE(ids.add(operation->get_id()));
+    if (FusedOperation *fused = dynamic_cast<FusedOperation *>(operation)) {
+      for (const NodeOperation *member : fused->get_members()) {
+        EXPECT_TRUE(ids.add(member->get_id()));
+      }
+    }
+  }
+}
+
+TEST_F(NodeOperationBuilderTest, fuse_pixel_operations_keeps_result)
+{
+  rcti canvas;
+  BLI_rcti_init(&canvas, 0, 37, 0, 11);
+  FusionGraph graph(*builder_, canvas);
+
+  OperationEvaluator unfused_evaluator;
+  MemoryBuffer &unfused = unfused_evaluator.evaluate(*graph.mix2);
+
+  builder_->fuse_pixel_operations();
+  FusedOperation *fused_mix2 = find_fused_operation(*builder_, graph.mix2);
+  ASSERT_NE(fused_mix2, nullptr);
+  OperationEvaluator fused_evaluator;
+  expect_buffers_near(fused_evaluator.evaluate(*fused_mix2), unfused);
+}
+
+}  // namespace blender::compositor::tests
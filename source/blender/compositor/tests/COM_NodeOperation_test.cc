@@ -3,6 +3,7 @@
 
 #include "testing/testing.h"
 
+#include "COM_AlphaOverMixedOperation.h"
 #include "COM_ConstantOperation.h"
 
 namespace blender::compositor::tests {
@@ -151,4 +152,22 @@ TEST(NodeOperation, generate_hash)
   }
 }
 
+TEST(NodeOperation, generate_hash_of_subclass_params)
+{
+  /* Parameters added by subclasses of hashed operations must be part of the hash too. */
+  NonHashedOperation input_op(1);
+  AlphaOverMixedOperation op1;
+  AlphaOverMixedOperation op2;
+  for (AlphaOverMixedOperation *op : {&op1, &op2}) {
+    op->set_canvas(input_op.get_canvas());
+    for (int i = 0; i < int(op->get_number_of_input_sockets()); i++) {
+      op->get_input_socket(i)->set_link(input_op.get_output_socket());
+    }
+  }
+  EXPECT_EQ(*op1.generate_hash(), *op2.generate_hash());
+
+  op2.setX(0.5f);
+  EXPECT_NE(*op1.generate_hash(), *op2.generate_hash());
+}
+
 }  // namespace blender::compositor::tests
@@ -0,0 +1,80 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later
+ * Copyright 2023 Blender Foundation. */
+
+#include "testing/testing.h"
+
+#include "COM_MemoryBuffer.h"
+#include "COM_ResultCache.h"
+
+namespace blender::compositor::tests {
+
+/** Color buffer of 4x4 pixels, 256 bytes. */
+static constexpr size_t BUFFER_SIZE = 4 * 4 * 4 * sizeof(float);
+
+static std::unique_ptr<MemoryBuffer> create_buffer(const float value)
+{
+  rcti rect;
+  BLI_rcti_init(&rect, 0, 4, 0, 4);
+  std::unique_ptr<MemoryBuffer> buffer = std::make_unique<MemoryBuffer>(DataType::Color, rect);
+  buffer->fill(rect, &value);
+  return buffer;
+}
+
+TEST(ResultCache, TakeAdded)
+{
+  ResultCache cache;
+  cache.set_max_size(BUFFER_SIZE * 2);
+
+  cache.add(1, create_buffer(1.0f));
+  EXPECT_TRUE(cache.contains(1));
+  EXPECT_EQ(cache.get_size(), BUFFER_SIZE);
+  EXPECT_EQ(cache.take(2), nullptr);
+
+  std::unique_ptr<MemoryBuffer> buffer = cache.take(1);
+  ASSERT_NE(buffer, nullptr);
+  EXPECT_EQ(*buffer->get_elem(3, 3), 1.0f);
+  EXPECT_FALSE(cache.contains(1));
+  EXPECT_EQ(cache.get_size(), size_t(0));
+
+  /* Adding a result of same hash replaces the previous one. */
+  cache.add(1, std::move(buffer));
+  cache.add(1, create_buffer(2.0f));
+  EXPECT_EQ(cache.get_size(), BUFFER_SIZE);
+  EXPECT_EQ(*cache.take(1)->get_elem(0, 0), 2.0f);
+}
+
+TEST(ResultCache, FreeLeastRecentlyUsed)
+{
+  ResultCache cache;
+  cache.set_max_size(BUFFER_SIZE * 2);
+
+  cache.add(1, create_buffer(1.0f));
+  cache.add(2, create_buffer(2.0f));
+  /* Taking and adding back a result makes it the most recently used one. */
+  cache.add(1, cache.take(1));
+
+  cache.add(3, create_buffer(3.0f));
+  EXPECT_TRUE(cache.contains(1));
+  EXPECT_FALSE(cache.contains(2));
+  EXPECT_TRUE(cache.contains(3));
+  EXPECT_EQ(cache.get_size(), BUFFER_SIZE * 2);
+
+  cache.set_max_size(BUFFER_SIZE);
+  EXPECT_FALSE(cache.contains(1));
+  EXPECT_TRUE(cache.contains(3));
+  EXPECT_EQ(cache.get_size(), BUFFER_SIZE);
+
+  /* Results larger than the budget are not kept. */
+  cache.set_max_size(BUFFER_SIZE - 1);
+  cache.add(4, create_buffer(4.0f));
+  EXPECT_FALSE(cache.contains(4));
+  EXPECT_EQ(cache.get_size(), size_t(0));
+
+  cache.set_max_size(BUFFER_SIZE * 2);
+  cache.add(5, create_buffer(5.0f));
+  cache.clear();
+  EXPECT_FALSE(cache.contains(5));
+  EXPECT_EQ(cache.get_size(), size_t(0));
+}
+
+}  // namespace blender::compositor::tests
@@ -163,7 +163,18 @@ struct CombOperationExecutor {
 
     this->restore_segment_lengths(changed_curves);
 
-    curves_orig_->tag_positions_changed();
+    /* Usually only a small part of all curves is combed at once, so only re-evaluate those. */
+    Vector<int64_t> changed_curve_indices;
+    for (const Vector<int> &local_changed_curves : changed_curves) {
+      for (const int curve_i : local_changed_curves) {
+        changed_curve_indices.append(curve_i);
+      }
+    }
+    std::sort(changed_curve_indices.begin(), changed_curve_indices.end());
+    changed_curve_indices.resize(
+        std::unique(changed_curve_indices.begin(), changed_curve_indices.end()) -
+        changed_curve_indices.begin());
+    curves_orig_->tag_positions_changed(IndexMask(changed_curve_indices));
     DEG_id_tag_update(&curves_id_orig_->id, ID_RECALC_GEOMETRY);
     WM_main_add_notifier(NC_GEOM | ND_DATA, &curves_id_orig_->id);
     ED_region_tag_redraw(ctx_.region);
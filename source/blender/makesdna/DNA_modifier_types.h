@@ -159,6 +159,7 @@ typedef enum {
   eSubsurfModifierFlag_UseCrease = (1 << 4),
   eSubsurfModifierFlag_UseCustomNormals = (1 << 5),
   eSubsurfModifierFlag_UseRecursiveSubdivision = (1 << 6),
+  eSubsurfModifierFlag_UseAdaptiveRenderLevels = (1 << 7),
 } SubsurfModifierFlag;
 
 typedef enum {
@@ -188,6 +189,9 @@ typedef struct SubsurfModifierData {
   short quality;
   short boundary_smooth;
   char _pad[2];
+  /** Target length of subdivided edges in pixels, for adaptive render levels. */
+  float adaptive_pixel_size;
+  char _pad1[4];
 
   /* TODO(sergey): Get rid of those with the old CCG subdivision code. */
   void *emCache, *mCache;
@@ -577,6 +577,10 @@ typedef struct bNodeTree {
    */
   bNodeInstanceKey active_viewer_key;
 
+  /** Memory limit in megabytes of the full frame compositor, 0 for no limit. */
+  int max_memory;
+  /** Memory budget in megabytes of results kept between compositor executions, 0 to disable. */
+  int cache_memory;
   char _pad[4];
 
   /** Image representing what the node group does. */
@@ -667,6 +671,7 @@ typedef struct bNodeTree {
 
 /* tree is localized copy, free when deleting node groups */
 /* #define NTREE_IS_LOCALIZED           (1 << 5) */
+#define NTREE_COM_HALF_BUFFERS (1 << 6) /* Keep full frame buffers in half float. */
 
 /* tree->execution_mode */
 typedef enum eNodeTreeExecutionMode {
@@ -1756,6 +1756,25 @@ static void rna_def_modifier_subsurf(BlenderRNA *brna)
   RNA_def_property_ui_text(
       prop, "Render Levels", "Number of subdivisions to perform when rendering");
 
+  prop = RNA_def_property(srna, "use_adaptive_render_levels", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "flags", eSubsurfModifierFlag_UseAdaptiveRenderLevels);
+  RNA_def_property_ui_text(prop,
+                           "Adaptive Render Levels",
+                           "Lower the number of subdivisions when rendering based on the size of "
+                           "the object as seen from the scene camera, using the render levels as "
+                           "maximum");
+  RNA_def_property_update(prop, 0, "rna_Modifier_update");
+
+  prop = RNA_def_property(srna, "adaptive_pixel_size", PROP_FLOAT, PROP_PIXEL);
+  RNA_def_property_float_sdna(prop, NULL, "adaptive_pixel_size");
+  RNA_def_property_range(prop, 0.1f, 1000.0f);
+  RNA_def_property_ui_range(prop, 0.5f, 100.0f, 10, 2);
+  RNA_def_property_ui_text(
+      prop,
+      "Pixel Size",
+      "Target size of subdivided edges in pixels, when using adaptive render levels");
+  RNA_def_property_update(prop, 0, "rna_Modifier_update");
+
   prop = RNA_def_property(srna, "show_only_control_edges", PROP_BOOLEAN, PROP_NONE);
   RNA_def_property_boolean_sdna(prop, NULL, "flags", eSubsurfModifierFlag_ControlEdges);
   RNA_def_property_ui_text(prop, "Optimal Display", "Skip displaying interior subdivided edges");
@@ -12815,6 +12815,35 @@ static void rna_def_composite_nodetree(BlenderRNA *brna)
                            "Max size of a tile (smaller values gives better distribution "
                            "of multiple threads, but more overhead)");
 
+  prop = RNA_def_property(srna, "max_memory", PROP_INT, PROP_NONE);
+  RNA_def_property_int_sdna(prop, NULL, "max_memory");
+  RNA_def_property_range(prop, 0, INT_MAX);
+  RNA_def_property_ui_range(prop, 0, 1024 * 1024, 1024, -1);
+  RNA_def_property_ui_text(prop,
+                           "Memory Limit",
+                           "Maximum memory in megabytes used by buffers of an output in full "
+                           "frame mode, larger outputs are composited in parts (0 for no limit)");
+  RNA_def_property_update(prop, NC_NODE | ND_DISPLAY, "rna_NodeTree_update");
+
+  prop = RNA_def_property(srna, "cache_memory", PROP_INT, PROP_NONE);
+  RNA_def_property_int_sdna(prop, NULL, "cache_memory");
+  RNA_def_property_range(prop, 0, INT_MAX);
+  RNA_def_property_ui_range(prop, 0, 1024 * 1024, 1024, -1);
+  RNA_def_property_ui_text(prop,
+                           "Cache Memory",
+                           "Memory in megabytes used to keep node results between compositor "
+                           "executions in full frame mode, so that only nodes affected by a "
+                           "change are recomputed (0 to disable)");
+  RNA_def_property_update(prop, NC_NODE | ND_DISPLAY, "rna_NodeTree_update");
+
+  prop = RNA_def_property(srna, "use_half_buffers", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "flag", NTREE_COM_HALF_BUFFERS);
+  RNA_def_property_ui_text(prop,
+                           "Half Float Buffers",
+                           "Keep color results waiting for other nodes in half float precision in "
+                           "full frame mode, using less memory at the cost of precision");
+  RNA_def_property_update(prop, NC_NODE | ND_DISPLAY, "rna_NodeTree_update");
+
   prop = RNA_def_property(srna, "use_opencl", PROP_BOOLEAN, PROP_NONE);
   RNA_def_property_boolean_sdna(prop, NULL, "flag", NTREE_COM_OPENCL);
   RNA_def_property_ui_text(prop, "OpenCL", "Enable GPU calculations");
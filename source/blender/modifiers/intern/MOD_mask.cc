@@ -367,8 +367,14 @@ static void add_interp_verts_copy_edges_to_new_mesh(const Mesh &src_mesh,
   const Span<MEdge> src_edges = src_mesh.edges();
   MutableSpan<MEdge> dst_edges = dst_mesh.edges_for_write();
 
-  uint vert_index = dst_mesh.totvert - verts_add_num;
+  const uint vert_start = dst_mesh.totvert - verts_add_num;
+  uint vert_index = vert_start;
   uint edge_index = edges_masked_num - verts_add_num;
+
+  /* Interpolate the new vertices in a single batch once all cuts are known. */
+  Array<int> interp_indices(verts_add_num * 2);
+  Array<float> interp_weights(verts_add_num * 2);
+
   for (int i_src : IndexRange(src_mesh.totedge)) {
     if (r_edge_map[i_src] != -1) {
       int i_dst = r_edge_map[i_src];
@@ -401,14 +407,24 @@ static void add_interp_verts_copy_edges_to_new_mesh(const Mesh &src_mesh,
       float fac = get_interp_factor_from_vgroup(
           dvert, defgrp_index, threshold, e_src.v1, e_src.v2);
 
-      float weights[2] = {1.0f - fac, fac};
-      CustomData_interp(
-          &src_mesh.vdata, &dst_mesh.vdata, (int *)&e_src.v1, weights, nullptr, 2, vert_index);
+      const int interp_index = int(vert_index - vert_start) * 2;
+      interp_indices[interp_index] = int(e_src.v1);
+      interp_indices[interp_index + 1] = int(e_src.v2);
+      interp_weights[interp_index] = 1.0f - fac;
+      interp_weights[interp_index + 1] = fac;
       vert_index++;
     }
   }
   BLI_assert(vert_index == dst_mesh.totvert);
   BLI_assert(edge_index == edges_masked_num);
+
+  CustomData_interp_batch(&src_mesh.vdata,
+                          &dst_mesh.vdata,
+                          interp_indices.data(),
+                          interp_weights.data(),
+                          2,
+                          int(vert_start),
+                          int(verts_add_num));
 }
 
 static void copy_masked_edges_to_new_mesh(const Mesh &src_mesh,
@@ -43,6 +43,7 @@
 #include "RNA_prototypes.h"
 
 #include "DEG_depsgraph.h"
+#include "DEG_depsgraph_build.h"
 #include "DEG_depsgraph_query.h"
 
 #include "MOD_modifiertypes.h"
@@ -133,11 +134,16 @@ static bool isDisabled(const Scene *scene, ModifierData *md, bool useRenderParam
 }
 
 static int subdiv_levels_for_modifier_get(const SubsurfModifierData *smd,
-                                          const ModifierEvalContext *ctx)
+                                          const ModifierEvalContext *ctx,
+                                          const Mesh *mesh)
 {
   Scene *scene = DEG_get_evaluated_scene(ctx->depsgraph);
   const bool use_render_params = (ctx->flag & MOD_APPLY_RENDER);
-  const int requested_levels = (use_render_params) ? smd->renderLevels : smd->levels;
+  int requested_levels = (use_render_params) ? smd->renderLevels : smd->levels;
+  if (use_render_params && (smd->flags & eSubsurfModifierFlag_UseAdaptiveRenderLevels) &&
+      !(ctx->flag & MOD_APPLY_TO_BASE_MESH)) {
+    requested_levels = BKE_subsurf_modifier_adaptive_render_levels(smd, scene, ctx->object, mesh);
+  }
   return get_render_subsurf_level(&scene->r, requested_levels, use_render_params);
 }
 
@@ -145,9 +151,10 @@ static int subdiv_levels_for_modifier_get(const SubsurfModifierData *smd,
 
 static void subdiv_mesh_settings_init(SubdivToMeshSettings *settings,
                                       const SubsurfModifierData *smd,
-                                      const ModifierEvalContext *ctx)
+                                      const ModifierEvalContext *ctx,
+                                      const Mesh *mesh)
 {
-  const int level = subdiv_levels_for_modifier_get(smd, ctx);
+  const int level = subdiv_levels_for_modifier_get(smd, ctx, mesh);
   settings->resolution = (1 << level) + 1;
   settings->use_optimal_display = (smd->flags & eSubsurfModifierFlag_ControlEdges) &&
                                   !(ctx->flag & MOD_APPLY_TO_BASE_MESH);
@@ -160,7 +167,7 @@ static Mesh *subdiv_as_mesh(SubsurfModifierData *smd,
 {
   Mesh *result = mesh;
   SubdivToMeshSettings mesh_settings;
-  subdiv_mesh_settings_init(&mesh_settings, smd, ctx);
+  subdiv_mesh_settings_init(&mesh_settings, smd, ctx, mesh);
   if (mesh_settings.resolution < 3) {
     return result;
   }
@@ -172,9 +179,10 @@ static Mesh *subdiv_as_mesh(SubsurfModifierData *smd,
 
 static void subdiv_ccg_settings_init(SubdivToCCGSettings *settings,
                                      const SubsurfModifierData *smd,
-                                     const ModifierEvalContext *ctx)
+                                     const ModifierEvalContext *ctx,
+                                     const Mesh *mesh)
 {
-  const int level = subdiv_levels_for_modifier_get(smd, ctx);
+  const int level = subdiv_levels_for_modifier_get(smd, ctx, mesh);
   settings->resolution = (1 << level) + 1;
   settings->need_normal = true;
   settings->need_mask = false;
@@ -187,7 +195,7 @@ static Mesh *subdiv_as_ccg(SubsurfModifierData *smd,
 {
   Mesh *result = mesh;
   SubdivToCCGSettings ccg_settings;
-  subdiv_ccg_settings_init(&ccg_settings, smd, ctx);
+  subdiv_ccg_settings_init(&ccg_settings, smd, ctx, mesh);
   if (ccg_settings.resolution < 3) {
     return result;
   }
@@ -203,7 +211,7 @@ static void subdiv_cache_mesh_wrapper_settings(const ModifierEvalContext *ctx,
                                                SubsurfRuntimeData *runtime_data)
 {
   SubdivToMeshSettings mesh_settings;
-  subdiv_mesh_settings_init(&mesh_settings, smd, ctx);
+  subdiv_mesh_settings_init(&mesh_settings, smd, ctx, mesh);
 
   runtime_data->has_gpu_subdiv = true;
   runtime_data->resolution = mesh_settings.resolution;
@@ -291,6 +299,20 @@ static Mesh *modifyMesh(ModifierData *md, const ModifierEvalContext *ctx, Mesh *
   return result;
 }
 
+static void updateDepsgraph(ModifierData *md, const ModifierUpdateDepsgraphContext *ctx)
+{
+  SubsurfModifierData *smd = (SubsurfModifierData *)md;
+  if (smd->flags & eSubsurfModifierFlag_UseAdaptiveRenderLevels) {
+    if (ctx->scene->camera != nullptr) {
+      DEG_add_object_relation(
+          ctx->node, ctx->scene->camera, DEG_OB_COMP_TRANSFORM, "Subsurf Adaptive Camera");
+      DEG_add_object_relation(
+          ctx->node, ctx->scene->camera, DEG_OB_COMP_PARAMETERS, "Subsurf Adaptive Camera");
+    }
+    DEG_add_depends_on_transform_relation(ctx->node, "Subsurf Adaptive Levels");
+  }
+}
+
 static void deformMatrices(ModifierData *md,
                            const ModifierEvalContext *ctx,
                            Mesh *mesh,
@@ -417,6 +439,12 @@ static void panel_draw(const bContext *C, Panel *panel)
     uiLayout *col = uiLayoutColumn(layout, true);
     uiItemR(col, ptr, "levels", 0, IFACE_("Levels Viewport"), ICON_NONE);
     uiItemR(col, ptr, "render_levels", 0, IFACE_("Render"), ICON_NONE);
+
+    col = uiLayoutColumn(layout, true);
+    uiItemR(col, ptr, "use_adaptive_render_levels", 0, IFACE_("Adaptive Render"), ICON_NONE);
+    uiLayout *sub = uiLayoutColumn(col, true);
+    uiLayoutSetActive(sub, RNA_boolean_get(ptr, "use_adaptive_render_levels"));
+    uiItemR(sub, ptr, "adaptive_pixel_size", 0, nullptr, ICON_NONE);
   }
 
   uiItemR(layout, ptr, "show_only_control_edges", 0, nullptr, ICON_NONE);
@@ -523,7 +551,7 @@ ModifierTypeInfo modifierType_Subsurf = {
     /*requiredDataMask*/ requiredDataMask,
     /*freeData*/ freeData,
     /*isDisabled*/ isDisabled,
-    /*updateDepsgraph*/ nullptr,
+    /*updateDepsgraph*/ updateDepsgraph,
     /*dependsOnTime*/ nullptr,
     /*dependsOnNormals*/ dependsOnNormals,
     /*foreachIDLink*/ nullptr,
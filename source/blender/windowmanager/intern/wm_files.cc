@@ -83,6 +83,8 @@
 #include "BLO_undofile.h" /* to save from an undo memfile */
 #include "BLO_writefile.h"
 
+#include "COM_compositor.h"
+
 #include "RNA_access.h"
 #include "RNA_define.h"
 
@@ -637,6 +639,8 @@ static void wm_file_read_pre(bContext *C, bool use_data, bool /*use_userdef*/)
   if (use_data) {
     BKE_callback_exec_null(CTX_data_main(C), BKE_CB_EVT_LOAD_PRE);
     BLI_timer_on_file_load();
+    /* Results of the previous file are not reused. */
+    COM_clear_caches();
   }
 
   /* Always do this as both startup and preferences may have loaded in many font's
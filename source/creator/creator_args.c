@@ -580,6 +580,7 @@ static int arg_handle_print_help(int UNUSED(argc), const char **UNUSED(argv), vo
   BLI_args_print_arg_doc(ba, "--debug-depsgraph-uuid");
   BLI_args_print_arg_doc(ba, "--debug-ghost");
   BLI_args_print_arg_doc(ba, "--debug-wintab");
+  BLI_args_print_arg_doc(ba, "--debug-compositor");
   BLI_args_print_arg_doc(ba, "--debug-gpu");
   BLI_args_print_arg_doc(ba, "--debug-gpu-force-workarounds");
   BLI_args_print_arg_doc(ba, "--debug-gpu-disable-ssbo");
@@ -965,6 +966,9 @@ static const char arg_handle_debug_mode_generic_set_doc_ghost[] =
 static const char arg_handle_debug_mode_generic_set_doc_wintab[] =
     "\n\t"
     "Enable debug messages for Wintab.";
+static const char arg_handle_debug_mode_generic_set_doc_compositor[] =
+    "\n\t"
+    "Enable timing statistics of compositor executions, printed as JSON after every execution.";
 #  ifdef WITH_XR_OPENXR
 static const char arg_handle_debug_mode_generic_set_doc_xr[] =
     "\n\t"
@@ -2225,6 +2229,11 @@ void main_args_setup(bContext *C, bArgs *ba)
                "--debug-wintab",
                CB_EX(arg_handle_debug_mode_generic_set, wintab),
                (void *)G_DEBUG_WINTAB);
+  BLI_args_add(ba,
+               NULL,
+               "--debug-compositor",
+               CB_EX(arg_handle_debug_mode_generic_set, compositor),
+               (void *)G_DEBUG_COMPOSITOR);
   BLI_args_add(ba, NULL, "--debug-all", CB(arg_handle_debug_mode_all), NULL);
 
   BLI_args_add(ba, NULL, "--debug-io", CB(arg_handle_debug_mode_io), NULL);
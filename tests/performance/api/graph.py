@@ -46,8 +46,10 @@ class TestGraph:
 
                 outputs = set()
                 for entry in entries:
-                    for output in entry.output.keys():
-                        outputs.add(output)
+                    for output, value in entry.output.items():
+                        # Only numbers are charted, other outputs are detailed results.
+                        if isinstance(value, (int, float)):
+                            outputs.add(output)
 
                 chart_type = 'line' if entries[0].benchmark_type == 'time_series' else 'comparison'
 
@@ -0,0 +1,188 @@
+# SPDX-License-Identifier: Apache-2.0
+
+import api
+import json
+
+
+def _run(args):
+    import bpy
+    import time
+
+    bpy.context.preferences.experimental.use_full_frame_compositor = True
+
+    scene = bpy.context.scene
+    scene.render.engine = 'BLENDER_WORKBENCH'
+    scene.display.render_aa = 'OFF'
+    scene.render.resolution_x = args['resolution_x']
+    scene.render.resolution_y = args['resolution_y']
+    scene.render.resolution_percentage = 100
+
+    # Render layer feeding a number of branches of operations with bounded areas of interest.
+    scene.use_nodes = True
+    tree = scene.node_tree
+    tree.execution_mode = 'FULL_FRAME'
+    tree.max_memory = args['max_memory']
+    tree.nodes.clear()
+
+    render_layers = tree.nodes.new('CompositorNodeRLayers')
+    composite = tree.nodes.new('CompositorNodeComposite')
+
+    result = None
+    for i in range(args['num_branches']):
+        blur = tree.nodes.new('CompositorNodeBlur')
+        blur.filter_type = 'FLAT'
+        blur.size_x = 4 + i
+        blur.size_y = 4 + i
+        tree.links.new(render_layers.outputs['Image'], blur.inputs['Image'])
+
+        hue_sat = tree.nodes.new('CompositorNodeHueSat')
+        hue_sat.inputs['Hue'].default_value = 0.1 * i
+        tree.links.new(blur.outputs['Image'], hue_sat.inputs['Image'])
+
+        gamma = tree.nodes.new('CompositorNodeGamma')
+        tree.links.new(hue_sat.outputs['Image'], gamma.inputs['Image'])
+
+        if result is None:
+            result = gamma.outputs['Image']
+            continue
+
+        mix = tree.nodes.new('CompositorNodeMixRGB')
+        mix.blend_type = 'ADD'
+        tree.links.new(result, mix.inputs[1])
+        tree.links.new(gamma.outputs['Image'], mix.inputs[2])
+        result = mix.outputs['Image']
+
+    tree.links.new(result, composite.inputs['Image'])
+
+    # Render once without compositing to subtract the render time.
+    scene.render.use_compositing = False
+    start_time = time.time()
+    bpy.ops.render.render()
+    render_time = time.time() - start_time
+
+    scene.render.use_compositing = True
+    start_time = time.time()
+    bpy.ops.render.render()
+    total_time = time.time() - start_time
+
+    result = {'time': max(total_time - render_time, 0.0)}
+    return result
+
+
+def _run_file(args):
+    import bpy
+    import time
+
+    bpy.context.preferences.experimental.use_full_frame_compositor = True
+
+    # Render layers are rendered with workbench, the compositor is what is measured.
+    scene = bpy.context.scene
+    scene.render.engine = 'BLENDER_WORKBENCH'
+    scene.display.render_aa = 'OFF'
+    scene.render.use_compositing = True
+    tree = scene.node_tree
+    tree.execution_mode = args['execution_mode']
+    # Execute all operations every time instead of reusing results of the previous execution.
+    tree.cache_memory = 0
+
+    test_time_start = time.time()
+    num_measurements = 0
+
+    min_measurements = 3
+    max_measurements = 100
+    timeout = 10
+
+    while True:
+        bpy.ops.render.render()
+        num_measurements += 1
+
+        if num_measurements >= min_measurements and test_time_start + timeout < time.time():
+            break
+        if num_measurements >= max_measurements:
+            break
+
+    return {}
+
+
+def _parse_statistics(lines):
+    # Parse statistics printed by `--debug-compositor` after every execution.
+    prefix = "Compositor statistics: "
+    executions = []
+    for line in lines:
+        if line.startswith(prefix):
+            executions.append(json.loads(line[len(prefix):]))
+    if not executions:
+        return {}
+
+    # Render times of operations of same name are summed, averaged over all executions.
+    operations = {}
+    for execution in executions:
+        for operation in execution['operations']:
+            name = operation['name']
+            operations[name] = operations.get(name, 0.0) + operation['time'] / len(executions)
+
+    return {
+        'time': sum(execution['time'] for execution in executions) / len(executions),
+        'peak_memory': max(execution['peak_memory'] - execution['start_memory']
+                           for execution in executions),
+        'operations': operations,
+    }
+
+
+class CompositorFileTest(api.Test):
+    def __init__(self, filepath, execution_mode):
+        self.filepath = filepath
+        self.execution_mode = execution_mode
+
+    def name(self):
+        return f"{self.filepath.stem}_{self.execution_mode.lower()}"
+
+    def category(self):
+        return "compositor"
+
+    def run(self, env, device_id):
+        args = {'execution_mode': self.execution_mode}
+
+        _, lines = env.run_in_blender(_run_file, args, ['--debug-compositor', self.filepath])
+
+        return _parse_statistics(lines)
+
+
+class CompositorTest(api.Test):
+    def __init__(self, name, max_memory):
+        self.name_ = name
+        self.max_memory = max_memory
+
+    def name(self):
+        return self.name_
+
+    def category(self):
+        return "compositor"
+
+    def run(self, env, device_id):
+        args = {
+            'resolution_x': 7680,
+            'resolution_y': 4320,
+            'num_branches': 8,
+            'max_memory': self.max_memory,
+        }
+
+        result, _ = env.run_in_blender(_run, args)
+
+        return result
+
+
+def generate(env):
+    tests = [
+        CompositorTest('render_layer_branches_8k', 0),
+        CompositorTest('render_layer_branches_8k_memory_limit', 2048),
+    ]
+
+    filepaths = env.find_blend_files('compositor/*')
+    for filepath in filepaths:
+        tests += [
+            CompositorFileTest(filepath, 'FULL_FRAME'),
+            CompositorFileTest(filepath, 'TILED'),
+        ]
+
+    return tests
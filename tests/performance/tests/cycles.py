@@ -4,19 +4,85 @@ import api
 import os
 
 
+def _build_shader_scene(num_nodes):
+    # Plane filling the camera view, with a material made of a long chain of math and mix nodes
+    # and no lights, so that render time is dominated by shader evaluation.
+    import bpy
+
+    scene = bpy.context.scene
+    for ob in list(scene.objects):
+        if ob.type != 'CAMERA':
+            bpy.data.objects.remove(ob)
+
+    scene.camera.location = (0.0, 0.0, 10.0)
+    scene.camera.rotation_euler = (0.0, 0.0, 0.0)
+    bpy.ops.mesh.primitive_plane_add(size=20.0)
+    plane = bpy.context.active_object
+
+    material = bpy.data.materials.new("ShaderMathMix")
+    material.use_nodes = True
+    nodes = material.node_tree.nodes
+    links = material.node_tree.links
+    nodes.clear()
+
+    coords = nodes.new('ShaderNodeTexCoord')
+    separate = nodes.new('ShaderNodeSeparateXYZ')
+    links.new(coords.outputs['Generated'], separate.inputs[0])
+    value = separate.outputs['X']
+    color = coords.outputs['Generated']
+
+    # Operations with a specialized SVM node, with both linked and constant operands.
+    # Values stay in the 0..1 range along the chain.
+    for i in range(num_nodes):
+        math = nodes.new('ShaderNodeMath')
+        math.operation = ('ADD', 'MULTIPLY', 'MULTIPLY_ADD')[i % 3]
+        links.new(value, math.inputs[0])
+        if math.operation == 'ADD':
+            links.new(separate.outputs['Y'], math.inputs[1])
+        else:
+            math.inputs[1].default_value = 0.5
+        math.inputs[2].default_value = 0.25
+        value = math.outputs[0]
+
+        # Mix node inputs are Factor, A and B for each data type, color ones come last.
+        mix = nodes.new('ShaderNodeMix')
+        mix.data_type = 'RGBA'
+        mix.blend_type = 'MIX'
+        links.new(value, mix.inputs[0])
+        links.new(color, mix.inputs[6])
+        mix.inputs[7].default_value = (0.2, 0.4, 0.8, 1.0)
+        color = mix.outputs[2]
+
+    emission = nodes.new('ShaderNodeEmission')
+    output = nodes.new('ShaderNodeOutputMaterial')
+    links.new(color, emission.inputs['Color'])
+    links.new(emission.outputs[0], output.inputs['Surface'])
+    plane.data.materials.append(material)
+
+    scene.cycles.use_adaptive_sampling = False
+
+
 def _run(args):
     import bpy
+    import os
     import time
 
     device_type = args['device_type']
     device_index = args['device_index']
 
+    if args['num_shader_nodes']:
+        _build_shader_scene(args['num_shader_nodes'])
+
     scene = bpy.context.scene
     scene.render.engine = 'CYCLES'
     scene.render.filepath = args['render_filepath']
     scene.render.image_settings.file_format = 'PNG'
     scene.cycles.device = 'CPU' if device_type == 'CPU' else 'GPU'
 
+    if args['use_cpu_wavefront']:
+        # Debug flags are reset from the environment before rendering.
+        os.environ['CYCLES_CPU_WAVEFRONT'] = '1'
+
     if scene.cycles.use_adaptive_sampling:
         # Render samples specified in file, no other way to measure
         # adaptive sampling performance reliably.
@@ -52,10 +118,14 @@ def _run(args):
 
 
 class CyclesTest(api.Test):
-    def __init__(self, filepath):
+    def __init__(self, filepath, use_cpu_wavefront=False):
         self.filepath = filepath
+        self.use_cpu_wavefront = use_cpu_wavefront
+        self.num_shader_nodes = 0
 
     def name(self):
+        if self.use_cpu_wavefront:
+            return self.filepath.stem + "_cpu_wavefront"
         return self.filepath.stem
 
     def category(self):
@@ -64,15 +134,24 @@ class CyclesTest(api.Test):
     def use_device(self):
         return True
 
+    def use_device_type(self, device_type):
+        # The wavefront mode only exists for CPU rendering.
+        return not self.use_cpu_wavefront or device_type == 'CPU'
+
     def run(self, env, device_id):
         tokens = device_id.split('_')
         device_type = tokens[0]
         device_index = int(tokens[1]) if len(tokens) > 1 else 0
         args = {'device_type': device_type,
                 'device_index': device_index,
+                'use_cpu_wavefront': self.use_cpu_wavefront,
+                'num_shader_nodes': self.num_shader_nodes,
                 'render_filepath': str(env.log_file.parent / (env.log_file.stem + '.png'))}
 
-        _, lines = env.run_in_blender(_run, args, ['--debug-cycles', '--verbose', '2', self.filepath])
+        blender_args = ['--debug-cycles', '--verbose', '2']
+        if self.filepath:
+            blender_args.append(self.filepath)
+        _, lines = env.run_in_blender(_run, args, blender_args)
 
         # Parse render time from output
         prefix_time = "Render time (without synchronization): "
@@ -107,6 +186,23 @@ class CyclesTest(api.Test):
         return {'time': time, 'peak_memory': memory}
 
 
+class CyclesShaderTest(CyclesTest):
+    # Generated scene measuring CPU shading throughput of math and mix nodes, independent of the
+    # benchmark files.
+    def __init__(self, num_shader_nodes):
+        super().__init__(None)
+        self.num_shader_nodes = num_shader_nodes
+
+    def name(self):
+        return f"shader_math_mix_{self.num_shader_nodes}"
+
+    def use_device_type(self, device_type):
+        return device_type == 'CPU'
+
+
 def generate(env):
     filepaths = env.find_blend_files('cycles/*')
-    return [CyclesTest(filepath) for filepath in filepaths]
+    tests = [CyclesTest(filepath) for filepath in filepaths]
+    tests += [CyclesTest(filepath, use_cpu_wavefront=True) for filepath in filepaths]
+    tests += [CyclesShaderTest(64)]
+    return tests